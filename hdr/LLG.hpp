@@ -24,6 +24,12 @@
 //
 #ifndef LLG_H_
 #define LLG_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "vutil.hpp"
+
 /// Header file for LLG namespace
 namespace LLG_arrays{
 	
@@ -31,23 +37,35 @@ namespace LLG_arrays{
 // Namespace to store persistant LLG integration arrays
 //==========================================================
 
-	extern std::vector <double> x_euler_array;	
-	extern std::vector <double> y_euler_array;	
-	extern std::vector <double> z_euler_array;
+	// arrays are first touched by the integrating threads (see sim::LLGinit)
+	typedef std::vector <double, vutil::first_touch_allocator<double> > llg_array_t;
 
-	extern std::vector <double> x_heun_array;	
-	extern std::vector <double> y_heun_array;	
-	extern std::vector <double> z_heun_array;
+	extern llg_array_t x_euler_array;
+	extern llg_array_t y_euler_array;
+	extern llg_array_t z_euler_array;
 
-	extern std::vector <double> x_spin_storage_array;	
-	extern std::vector <double> y_spin_storage_array;	
-	extern std::vector <double> z_spin_storage_array;
+	extern llg_array_t x_heun_array;
+	extern llg_array_t y_heun_array;
+	extern llg_array_t z_heun_array;
 
-	extern std::vector <double> x_initial_spin_array;	
-	extern std::vector <double> y_initial_spin_array;	
-	extern std::vector <double> z_initial_spin_array;
+	extern llg_array_t x_spin_storage_array;
+	extern llg_array_t y_spin_storage_array;
+	extern llg_array_t z_spin_storage_array;
+
+	extern llg_array_t x_initial_spin_array;
+	extern llg_array_t y_initial_spin_array;
+	extern llg_array_t z_initial_spin_array;
 
 	extern bool LLG_set;
 
+	// Memory traffic per atom of one Heun step. The predictor and corrector
+	// each read the spin, both fields and the material type and write the
+	// spin and one partial step vector.
+	const uint64_t heun_bytes_per_atom = 2*(15*sizeof(double) + sizeof(int));
+
+	// Reference traffic of the unfused scheme, which also stored the initial
+	// spins, both gradients and a copy of the predicted spins (51 doubles)
+	const uint64_t unfused_heun_bytes_per_atom = 51*sizeof(double) + 2*sizeof(int);
+
 }
 #endif /*LLG_H_*/
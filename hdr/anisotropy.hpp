@@ -52,6 +52,12 @@ namespace anisotropy
    //-----------------------------------------------------------------------------
    double single_spin_energy(const int atom, const int imaterial, const double sx, const double sy, const double sz, const double temperature);
 
+   //-----------------------------------------------------------------------------
+   // function to calculate change in anisotropy energy for a single spin moved
+   // from old to new direction
+   //-----------------------------------------------------------------------------
+   double single_spin_energy_difference(const int atom, const int imaterial, const double old_spin[3], const double new_spin[3], const double temperature);
+
    //-----------------------------------------------------------------------------
    // functions to get anisotropy constants
    //-----------------------------------------------------------------------------
@@ -66,7 +72,7 @@ namespace anisotropy
    //-----------------------------------------------------------------------------
    // function to identify surface atoms
    //-----------------------------------------------------------------------------
-   void identify_surface_atoms(std::vector<cs::catom_t> & catom_array, std::vector<std::vector <neighbours::neighbour_t> > & cneighbourlist);
+   void identify_surface_atoms(std::vector<cs::catom_t> & catom_array, neighbours::list_t& cneighbourlist);
 
    //---------------------------------------------------------------------------
    // Function to process input file parameters for anisotropy module
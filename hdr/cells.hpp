@@ -26,6 +26,9 @@ namespace cells{
 
    extern int num_atoms_in_unit_cell;
    extern int num_cells; /// number of macro-cells
+   extern int num_cells_x; /// number of macro-cells in x,y,z
+   extern int num_cells_y;
+   extern int num_cells_z;
    extern int num_local_cells; /// number of macro-cells
    extern double macro_cell_size; /// lateral size of local macro-cells (A)
 
@@ -59,6 +62,25 @@ namespace cells{
    //---------------------------------------------------------------------------
    extern int mag();
 
+   //---------------------------------------------------------------------------
+   // Functions to calculate magnetisation in cells with a non-blocking
+   // reduction. begin_mag() posts the reduction of the current moments,
+   // end_mag() completes it and returns false if none was outstanding.
+   // test_mag() progresses an outstanding reduction.
+   //---------------------------------------------------------------------------
+   void begin_mag();
+   bool end_mag();
+   void test_mag();
+
+   //---------------------------------------------------------------------------
+   // Functions for incremental calculation of magnetisation in cells. While
+   // tracking, every change of a spin must be passed to add_spin_change() and
+   // mag() uses the tracked moments instead of summing over all atoms.
+   //---------------------------------------------------------------------------
+   void start_tracking_spin_changes();
+   void stop_tracking_spin_changes();
+   void add_spin_change(const int atom, const double Sold[3], const double Snew[3]);
+
    //-----------------------------------------------------------------------------
    // Function to initialise cells module
    //-----------------------------------------------------------------------------
@@ -28,6 +28,11 @@ namespace config{
    //-----------------------------------------------------------------------------
    void output();
 
+   //-----------------------------------------------------------------------------
+   // Function to complete outstanding output at end of simulation
+   //-----------------------------------------------------------------------------
+   void finalize();
+
    //---------------------------------------------------------------------------
    // Function to process input file parameters for config module
    //---------------------------------------------------------------------------
@@ -27,6 +27,7 @@ namespace dipole{
    // Externally visible variables
    //------------------------------------------------------------------------------
    extern bool activated;
+   extern bool per_move_update; /// flag to update cell fields after every accepted Monte Carlo move
 
    extern int update_rate; /// timesteps between updates
    extern int update_time; /// last update time
@@ -57,6 +58,16 @@ namespace dipole{
                         std::vector<double>& y_spin_array,
                         std::vector<double>& z_spin_array);
 
+   //------------------------------------------------------------------------------
+   // Function to update cell fields for a single accepted Monte Carlo move
+   //------------------------------------------------------------------------------
+   void update_field_for_spin_change(const int atom, const double Sold[3], const double Snew[3]);
+
+   //------------------------------------------------------------------------------
+   // Function to complete outstanding communication at end of simulation
+   //------------------------------------------------------------------------------
+   void finalize();
+
    //------------------------------------------------------------------------------
    // Function to calculate energy of spin in dipole (magnetostatic) field
    //------------------------------------------------------------------------------
@@ -76,8 +76,8 @@ namespace exchange{
    //-----------------------------------------------------------------------------
    // Function to initialise exchange module
    //-----------------------------------------------------------------------------
-   void initialize(std::vector<std::vector <neighbours::neighbour_t> >& bilinear,
-                   std::vector<std::vector <neighbours::neighbour_t> >& biquadratic);
+   void initialize(neighbours::list_t& bilinear,
+                   neighbours::list_t& biquadratic);
 
    //-----------------------------------------------------------------------------
    // Functions to set exchange type isotropic, vectorial or tensorial
@@ -90,12 +90,24 @@ namespace exchange{
    //-----------------------------------------------------------------------------
    unsigned int get_exchange_type();
 
+   //-----------------------------------------------------------------------------
+   // Function to get list of atoms interacting with atom by exchange
+   //-----------------------------------------------------------------------------
+   void get_neighbours(const int atom, std::vector<int>& neighbours);
+
    //---------------------------------------------------------------------------
    // Calculate  exchange energy for single spin selecting the correct type
    //---------------------------------------------------------------------------
    double single_spin_energy(const int atom, const double sx, const double sy, const double sz);
    double single_spin_biquadratic_energy(const int atom, const double sx, const double sy, const double sz);
 
+   //---------------------------------------------------------------------------
+   // Calculate change in exchange energy for single spin moved from old to new
+   // direction, for Monte Carlo
+   //---------------------------------------------------------------------------
+   double single_spin_energy_difference(const int atom, const double old_spin[3], const double new_spin[3]);
+   double single_spin_biquadratic_energy_difference(const int atom, const double old_spin[3], const double new_spin[3]);
+
    //-----------------------------------------------------------------------------
    // Function to calculate exchange fields for spins between start and end index
    //-----------------------------------------------------------------------------
@@ -49,6 +49,12 @@ namespace montecarlo{
    int cmc_mc_step();
    void mc_step_parallel(std::vector<double> &x_spin_array, std::vector<double> &y_spin_array, std::vector<double> &z_spin_array, std::vector<int> &type_array);
 
+   //---------------------------------------------------------------------------
+   // Function to perform one monte carlo step with atoms of each colour of the
+   // exchange graph updated in parallel
+   //---------------------------------------------------------------------------
+   void mc_step_coloured();
+
    //---------------------------------------------------------------------------
    // Provide access to CMCinit and CMCMCinit for cmc_anisotropy and
    // hybrid_cmc programs respectively
@@ -64,6 +64,8 @@ public:
   void set_state(std::vector<uint32_t>& iostate, int32_t& iop);
 // overload operator() to make this a generator (functor)
   uint32_t operator()() { return rand_int32(); }
+// fill array with the next size 32 bit random ints
+  void fill(uint32_t* array, int size);
 // 2007-02-11: made the destructor virtual; thanks "double more" for pointing this out
   virtual ~MTRand_int32() {} // destructor
 protected: // used by derived classes, otherwise not accessible; use the ()-operator
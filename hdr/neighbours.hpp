@@ -14,7 +14,9 @@
 #define NEIGHBOURS_H_
 
 // C++ standard library headers
+#include <stdint.h>
 #include <string>
+#include <vector>
 
 // Vampire headers
 #include "create_atoms_class.hpp"
@@ -27,29 +29,47 @@
 //--------------------------------------------------------------------------------
 namespace neighbours{
 
-   //-----------------------------------------------------------------------------
-   // Simple class of neighbour type to store information about the neighbour
-   //-----------------------------------------------------------------------------
-   class neighbour_t {
-	public:
-
-		int nn; // atom id of neighbour
-		int i; // interaction type of neighbour
-
-      double vx; // real coordinate vector between atoms i->j
-      double vy;
-      double vz;
-
-	};
-
    //-----------------------------------------------------------------------------
    // Simple class of neighbour list definining a set of interactions
+   //
+   // Interactions are stored in compressed sparse row format, where the
+   // interactions of atom i are stored in the range
+   //
+   //    start_index[i] <= n < start_index[i+1]
+   //
+   // of the neighbour arrays. Separation vectors between atoms are not stored but
+   // calculated from the atomic positions and the periodic image of the neighbour.
    //-----------------------------------------------------------------------------
    class list_t{
    public:
 
-      // list of neighbours in terms of atom IDs
-      std::vector<std::vector <neighbours::neighbour_t> > list;
+      std::vector<uint64_t> start_index; // index of first interaction for each atom (num_atoms + 1 entries)
+      std::vector<int> nn; // atom id of neighbour
+      std::vector<int> i; // interaction type of neighbour
+      std::vector<uint8_t> image; // periodic image of neighbour encoded as (ix+1) + 3(iy+1) + 9(iz+1)
+      double image_size[3]; // size of periodic image in each direction (Angstroms)
+
+      // number of atoms in neighbour list
+      inline uint64_t num_atoms() const{
+         return start_index.empty() ? 0 : start_index.size() - 1;
+      }
+
+      // number of interactions for atom
+      inline uint64_t num_neighbours(const uint64_t atom) const{
+         return start_index[atom+1] - start_index[atom];
+      }
+
+      // calculate real coordinate vector i->j for interaction n of atom i
+      inline void vector(const uint64_t n, const int atom,
+                         const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z,
+                         double& vx, double& vy, double& vz) const{
+         const int ix = image[n] % 3 - 1;
+         const int iy = (image[n] / 3) % 3 - 1;
+         const int iz = image[n] / 9 - 1;
+         vx = double(ix) * image_size[0] + (x[nn[n]] - x[atom]);
+         vy = double(iy) * image_size[1] + (y[nn[n]] - y[atom]);
+         vz = double(iz) * image_size[2] + (z[nn[n]] - z[atom]);
+      }
 
       // generate neighbour list from interaction template and list of atoms
       void generate(std::vector<cs::catom_t>& atoms,
@@ -57,6 +77,11 @@ namespace neighbours{
                     const int num_atoms_in_unit_cell,
                     double ucdx, double ucdy, double ucdz);
 
+      // reorder atoms in neighbour list, keeping interactions of the first num_atoms_with_interactions atoms
+      void reorder(const std::vector<int>& old_atom_number,
+                   const std::vector<int>& new_atom_number,
+                   const uint64_t num_atoms_with_interactions);
+
       // release neighbour list
       void clear();
 
@@ -24,6 +24,8 @@
 //
 #ifndef RANDOM_H_
 #define RANDOM_H_
+#include <stdint.h>
+#include <vector>
 #include "mtrand.hpp"
 namespace mtrandom
 //==========================================================
@@ -33,9 +35,17 @@ namespace mtrandom
 	extern MTRand grnd; /// single sequence of random numbers
 	extern double gaussian();
 	extern double gaussianc(MTRand&);
+	extern void gaussian_fill(std::vector<double>& array, const int start, const int end);
 	
 	extern int voronoi_seed;
 	extern int integration_seed;
+
+	// counter based generator for decomposition independent random numbers
+	extern bool philox_thermal_noise;
+	extern void philox_gaussian(const std::vector<uint64_t>& id, const uint64_t step, const uint32_t seed, const uint32_t stream,
+	                            const int start, const int end, std::vector<double>& x, std::vector<double>& y, std::vector<double>& z);
+	extern void philox_numbers(const uint64_t id, const uint64_t step, const uint32_t seed, const uint32_t stream,
+	                           double gaussian[3], double& uniform);
 }
 
 
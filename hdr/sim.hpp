@@ -38,6 +38,7 @@ enum pump_functions_t {square=0, two_temperature, double_pump_two_temperature, d
 namespace sim{
 	extern std::ofstream mag_file;
 	extern uint64_t time;
+	extern uint64_t total_steps; /// integration steps since start of simulation (never reset)
 	extern uint64_t total_time;
 	extern uint64_t loop_time;
 	extern uint64_t partial_time;
@@ -119,6 +120,7 @@ namespace sim{
 
 	extern int integrator;
 	extern int program;
+	extern int num_threads; /// number of shared memory threads per process
 
    // Local system variables
 	extern bool local_temperature; /// flag to enable material specific temperature
@@ -132,6 +134,8 @@ namespace sim{
    extern bool save_checkpoint_flag; // Save checkpoint
    extern bool save_checkpoint_continuous_flag; // save checkpoints during simulations
    extern int save_checkpoint_rate; // Default increment between checkpoints
+   extern bool checkpoint_shared_file; // save and load single checkpoint file shared by all processes
+   extern bool asynchronous_checkpoint; // write checkpoints to disk in the background
 
 	// Initialization functions
 	extern void initialize(int num_materials);
@@ -164,6 +168,7 @@ namespace sim{
 
 	// Field and energy functions
 	extern double calculate_spin_energy(const int atom);
+	extern double calculate_spin_energy_difference(const int atom, const double old_spin[3], const double new_spin[3]);
    extern double spin_applied_field_energy(const double, const double, const double);
    extern double spin_magnetostatic_energy(const int, const double, const double, const double);
 
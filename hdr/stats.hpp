@@ -85,6 +85,10 @@ namespace stats
    class susceptibility_statistic_t;
    class specific_heat_statistic_t;
 
+   // single pass calculation of all energy and magnetization statistics
+   void update_fused(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
+                     const std::vector<double>& mm, const std::vector<int>& mat, const double temperature);
+
    class standard_deviation_statistic_t;
    //----------------------------------
    // Energy class definition
@@ -92,6 +96,8 @@ namespace stats
    class energy_statistic_t{
 
       friend class specific_heat_statistic_t;
+      friend void update_fused(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
+                               const std::vector<double>& mm, const std::vector<int>& mat, const double temperature);
 
    public:
       energy_statistic_t (std::string n):initialized(false){
@@ -123,6 +129,8 @@ namespace stats
       std::string output_mean_energy(enum energy_t energy_type, bool header);
 
    private:
+      void accumulate_mean_energy();
+
       bool initialized;
       int num_atoms;
       int mask_size;
@@ -156,6 +164,8 @@ namespace stats
 
       friend class susceptibility_statistic_t;
       friend class standard_deviation_statistic_t;
+      friend void update_fused(const std::vector<double>& sx, const std::vector<double>& sy, const std::vector<double>& sz,
+                               const std::vector<double>& mm, const std::vector<int>& mat, const double temperature);
       public:
          magnetization_statistic_t (std::string n):initialized(false){
            name = n;
@@ -177,6 +187,8 @@ namespace stats
          std::string output_mean_magnetization(bool header);
 
       private:
+         void normalize_magnetization();
+
          bool initialized;
          int num_atoms;
          int mask_size;
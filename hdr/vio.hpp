@@ -188,8 +188,17 @@ class fixed_width_output{
 }
 
 // Checkpoint load/save functions
+bool checkpoint_exists();
 void load_checkpoint();
 void save_checkpoint();
+void load_shared_checkpoint();
+void save_shared_checkpoint();
+void complete_shared_checkpoint();
+void finalize_checkpoint();
+
+// Staging buffers for asynchronous checkpoint output
+std::vector<char>& next_checkpoint_buffer();
+void queue_checkpoint_buffer(const std::string filename);
 
 namespace vio{
    bool match_input_parameter(std::string const key, std::string const word, std::string const value, std::string const unit, int const line);
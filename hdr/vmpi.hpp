@@ -47,6 +47,9 @@ namespace vmpi{
 	extern int num_processors;			///< Total number of CPUs
 	extern int mpi_mode; 				///< MPI Simulation Mode (0 = Geometric Decomposition, 1 = Replicated Data, 2 = Statistical Parallelism)
    extern unsigned int ppn;			///< Processors per node
+   extern bool weighted_decomposition; ///< Flag to balance geometric decomposition by number of atoms
+   extern bool single_precision_halo; ///< Flag to exchange halo spin data in single precision
+   extern bool shared_memory_halo; ///< Flag to exchange halo spin data on same node through shared memory
 	extern int num_core_atoms;			///< Number of atoms on local CPU with no external communication
 	extern int num_bdry_atoms;			///< Number of atoms on local CPU with external communication
 	extern int num_halo_atoms;			///< Number of atoms on remote CPUs needed for boundary atom integration
@@ -102,11 +105,13 @@ namespace vmpi{
 	extern int hosts();
 	extern int finalise();
    extern void geometric_decomposition(int, double []);
+   extern void recursive_bisection_decomposition(double system_size[3], double cell_size[3], int num_cells[3], std::vector<double>& coordinates);
 	extern double SwapTimer(double, double&);
 
    // functions for sending/receiving halo data
    extern void mpi_init_halo_swap();
    extern void mpi_complete_halo_swap();
+   extern void mpi_finalise_halo_swap();
 
 	// wrapper functions avoiding MPI library
 	extern void barrier();
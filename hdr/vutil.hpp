@@ -11,6 +11,13 @@
 
 // System headers
 #include <chrono>
+#include <memory>
+#include <new>
+#include <utility>
+
+#ifdef _OPENMP
+   #include <omp.h>
+#endif
 
 // Program headers
 
@@ -46,6 +53,72 @@ namespace vutil{
       }
    };
 
+   //---------------------------------------------------------------------------
+   // Allocator which leaves default constructed elements uninitialised. Memory
+   // pages are then only mapped when first written, so arrays initialised in a
+   // parallel loop are placed in the memory local to the thread using them.
+   //---------------------------------------------------------------------------
+   template <class T> class first_touch_allocator : public std::allocator<T>{
+
+   public:
+
+      template <class U> struct rebind { typedef first_touch_allocator<U> other; };
+
+      first_touch_allocator(){}
+      template <class U> first_touch_allocator(const first_touch_allocator<U>&){}
+
+      // default construction does not touch memory
+      template <class U> void construct(U* ptr){
+         ::new(static_cast<void*>(ptr)) U;
+      }
+
+      template <class U, class... Args> void construct(U* ptr, Args&&... args){
+         ::new(static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+      }
+
+   };
+
+   //---------------------------------------------------------------------------
+   // Function to return the number of threads in the current parallel region
+   //---------------------------------------------------------------------------
+   inline int num_threads(){
+      #ifdef _OPENMP
+         return omp_get_num_threads();
+      #else
+         return 1;
+      #endif
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to return the thread id in the current parallel region
+   //---------------------------------------------------------------------------
+   inline int thread_id(){
+      #ifdef _OPENMP
+         return omp_get_thread_num();
+      #else
+         return 0;
+      #endif
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to calculate a static partition of the range [start, end) for
+   // the calling thread. Each thread is given a contiguous block of atoms which
+   // is the same for every call with the same range, so that data first
+   // touched by a thread stays local to that thread throughout the simulation.
+   //---------------------------------------------------------------------------
+   inline void thread_partition(const int start, const int end, int& thread_start, int& thread_end){
+
+      const long range = end - start;
+      const long tid = thread_id();
+      const long nt = num_threads();
+
+      thread_start = start + int( (range*tid)/nt );
+      thread_end   = start + int( (range*(tid+1))/nt );
+
+      return;
+
+   }
+
 } // end of namespace vutil
 
 #endif //VUTIL_H_
@@ -66,9 +66,6 @@ namespace anisotropy{
       double neel_exponential_range          = 2.5; // r0 value for range dependence of Neel anisotropy
       double neel_exponential_factor         = 5.53; // F value for range dependence of Neel anisotropy (default assumes nnn fraction of 10% of nn value)
 
-      // arrays for storing unrolled parameters for lattice anisotropy
-      std::vector<double> klattice_array(0); // anisoptropy constant
-
    } // end of internal namespace
 
 } // end of anisotropy namespace
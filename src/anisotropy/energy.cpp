@@ -49,4 +49,31 @@ namespace anisotropy{
 
    }
 
+   //---------------------------------------------------------------------------
+   // Function to calculate change in anisotropy energy for a spin moved from
+   // old to new direction, evaluating both directions for each enabled term
+   //---------------------------------------------------------------------------
+   double single_spin_energy_difference(const int atom, const int mat, const double old_spin[3], const double new_spin[3], const double temperature){
+
+      const double ox = old_spin[0], oy = old_spin[1], oz = old_spin[2];
+      const double nx = new_spin[0], ny = new_spin[1], nz = new_spin[2];
+
+      // variable to add energy differences
+      double energy = 0.0;
+
+      if(internal::enable_uniaxial_second_order)         energy += internal::uniaxial_second_order_energy(atom, mat, nx, ny, nz)         - internal::uniaxial_second_order_energy(atom, mat, ox, oy, oz);
+      if(internal::enable_uniaxial_fourth_order)         energy += internal::uniaxial_fourth_order_energy(atom, mat, nx, ny, nz)         - internal::uniaxial_fourth_order_energy(atom, mat, ox, oy, oz);
+      if(internal::enable_uniaxial_sixth_order)          energy += internal::uniaxial_sixth_order_energy (atom, mat, nx, ny, nz)         - internal::uniaxial_sixth_order_energy (atom, mat, ox, oy, oz);
+
+      if(internal::enable_cubic_fourth_order)            energy += internal::cubic_fourth_order_energy(atom, mat, nx, ny, nz)            - internal::cubic_fourth_order_energy(atom, mat, ox, oy, oz);
+      if(internal::enable_cubic_fourth_order_rotation)   energy += internal::cubic_fourth_order_rotation_energy(atom, mat, nx, ny, nz)   - internal::cubic_fourth_order_rotation_energy(atom, mat, ox, oy, oz);
+      if(internal::enable_cubic_sixth_order)             energy += internal::cubic_sixth_order_energy (atom, mat, nx, ny, nz)            - internal::cubic_sixth_order_energy (atom, mat, ox, oy, oz);
+
+      if(internal::enable_neel_anisotropy)               energy += internal::neel_energy(atom, mat, nx, ny, nz)                          - internal::neel_energy(atom, mat, ox, oy, oz);
+      if(internal::enable_lattice_anisotropy)            energy += internal::lattice_energy(atom, mat, nx, ny, nz, temperature)          - internal::lattice_energy(atom, mat, ox, oy, oz, temperature);
+
+      return energy;
+
+   }
+
 } // end of anisotropy namespace
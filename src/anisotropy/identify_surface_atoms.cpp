@@ -31,7 +31,7 @@ namespace anisotropy{
    //---------------------------------------------------------------------------
    // Function to identify less than fully coordinated atoms
    //---------------------------------------------------------------------------
-   void identify_surface_atoms(std::vector<cs::catom_t> & catom_array, std::vector<std::vector <neighbours::neighbour_t> > & cneighbourlist){
+   void identify_surface_atoms(std::vector<cs::catom_t> & catom_array, neighbours::list_t& cneighbourlist){
 
       // initialise surface threshold if not overidden by input file
       if(internal::neel_anisotropy_threshold == 123456789) internal::neel_anisotropy_threshold = cs::unit_cell.surface_threshold;
@@ -100,20 +100,17 @@ namespace anisotropy{
       // and so everything is derived from that.
       //------------------------------------------------------------
 
-      // vector to identify all nearest neighbour interactions
-      std::vector <std::vector <bool> > nearest_neighbour_interactions_list(atoms::num_atoms);
+      // vector to identify all nearest neighbour interactions (same layout as neighbour list)
+      std::vector <bool> nearest_neighbour_interactions_list(cneighbourlist.nn.size(), false);
 
       // loop over all atoms
       for(int atom=0; atom < atoms::num_atoms; atom++){
 
-         // set all interactions for atom as non-nearest neighbour by default
-         nearest_neighbour_interactions_list[atom].resize(cneighbourlist[atom].size(),false);
-
          // loop over all interactions for atom
-         for(unsigned int nn=0;nn<cneighbourlist[atom].size();nn++){
+         for(uint64_t nn = cneighbourlist.start_index[atom]; nn < cneighbourlist.start_index[atom+1]; nn++){
 
             // get interaction type (same as unit cell interaction id)
-            unsigned int id = cneighbourlist[atom][nn].i;
+            unsigned int id = cneighbourlist.i[nn];
 
             // Ensure valid interaction id
             if(id>nn_interaction.size()){
@@ -123,7 +120,7 @@ namespace anisotropy{
             }
 
             // set mask to true or false for non-fully coordinated atoms in the bulk
-            nearest_neighbour_interactions_list[atom][nn]=nn_interaction.at(id);
+            nearest_neighbour_interactions_list[nn]=nn_interaction.at(id);
 
          }
       }
@@ -149,10 +146,10 @@ namespace anisotropy{
             unsigned int nnn_int=0;
 
             // Loop over all interactions to determine number of nearest neighbour interactions
-            for(unsigned int nn = 0 ; nn < cneighbourlist[atom].size(); nn++){
+            for(uint64_t nn = cneighbourlist.start_index[atom]; nn < cneighbourlist.start_index[atom+1]; nn++){
 
                // If interaction is nn, increment counter
-               if(nearest_neighbour_interactions_list[atom][nn]) nnn_int++;
+               if(nearest_neighbour_interactions_list[nn]) nnn_int++;
 
             }
 
@@ -147,9 +147,6 @@ namespace anisotropy{
       //---------------------------------------------------------------------
       if(internal::enable_lattice_anisotropy){
 
-         // arrays for storing unrolled parameters for lattice anisotropy
-         internal::klattice_array.resize(num_materials); // anisoptropy constant
-
          // loop over all materials and set up lattice anisotropy constants
          for(int m = 0; m < num_materials; m++){
 
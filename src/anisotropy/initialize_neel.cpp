@@ -33,8 +33,8 @@ namespace internal{
    //---------------------------------------------------------------------------
    // Function to calculate surface anisotropy tensor
    //---------------------------------------------------------------------------
-   void initialise_neel_anisotropy_tensor(std::vector <std::vector <bool> >& nearest_neighbour_interactions_list,
-                                          std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist){
+   void initialise_neel_anisotropy_tensor(std::vector<bool>& nearest_neighbour_interactions_list,
+                                          neighbours::list_t& cneighbourlist){
 
       // Print informative message to log file
       zlog << zTs() << "Using Néel pair anisotropy for atoms with < threshold number of neighbours." << std::endl;
@@ -62,19 +62,20 @@ namespace internal{
             for(int idx = 0; idx < 9; idx++) tmp_tensor[idx] = 0.0;
 
             // loop over all neighbours
-            for(unsigned int nn = 0; nn < cneighbourlist[atom].size(); nn++){
+            for(uint64_t nn = cneighbourlist.start_index[atom]; nn < cneighbourlist.start_index[atom+1]; nn++){
 
                // only add nearest neighbours to list
-               if(nearest_neighbour_interactions_list[atom][nn]==true){
+               if(nearest_neighbour_interactions_list[nn]==true){
 
                   // get atom number for neighbour
-                  const unsigned int natom = cneighbourlist[atom][nn].nn;
+                  const unsigned int natom = cneighbourlist.nn[nn];
 
                   // get material id for j atom
                   const unsigned int jmat = atoms::type_array[natom];
 
                   // get atomic position vector i->j
-                  double eij[3]={cneighbourlist[atom][nn].vx, cneighbourlist[atom][nn].vy, cneighbourlist[atom][nn].vz};
+                  double eij[3];
+                  cneighbourlist.vector(nn, atom, atoms::x_coord_array, atoms::y_coord_array, atoms::z_coord_array, eij[0], eij[1], eij[2]);
 
                   // normalise to unit vector
                   const double rij = sqrt(eij[0]*eij[0]+eij[1]*eij[1]+eij[2]*eij[2]);
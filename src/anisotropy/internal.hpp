@@ -194,9 +194,6 @@ namespace anisotropy{
       extern double neel_exponential_range;          // r0 value for range dependence of Neel anisotropy
       extern double neel_exponential_factor;         // F value for range dependence of Neel anisotropy
 
-      // arrays for storing unrolled parameters for lattice anisotropy
-      extern std::vector<double> klattice_array; // anisoptropy constant
-
       //-------------------------------------------------------------------------
       // internal function declarations
       //-------------------------------------------------------------------------
@@ -325,8 +322,8 @@ namespace anisotropy{
 
       double lattice_energy(const int atom, const int mat, const double sx, const double sy, const double sz, const double temperature);
 
-      void initialise_neel_anisotropy_tensor(std::vector <std::vector <bool> >& nearest_neighbour_interactions_list,
-                                             std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
+      void initialise_neel_anisotropy_tensor(std::vector<bool>& nearest_neighbour_interactions_list,
+                                             neighbours::list_t& cneighbourlist);
 
    } // end of internal namespace
 
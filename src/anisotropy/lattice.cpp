@@ -51,8 +51,10 @@ namespace anisotropy{
          if(!internal::enable_lattice_anisotropy) return;
 
          // Precalculate material lattice anisotropy constants from current temperature
+         // (stored locally as fields may be calculated by several threads at once)
+         std::vector<double> klattice_array(mp::num_materials);
          for(int imat=0; imat<mp::num_materials; imat++){
-            internal::klattice_array[imat] = -2.0 * internal::mp[imat].k_lattice * internal::mp[imat].lattice_anisotropy.get_lattice_anisotropy_constant(temperature);
+            klattice_array[imat] = -2.0 * internal::mp[imat].k_lattice * internal::mp[imat].lattice_anisotropy.get_lattice_anisotropy_constant(temperature);
          }
 
          // Now calculate fields
@@ -72,7 +74,7 @@ namespace anisotropy{
 
             const double sdote = (sx*ex + sy*ey + sz*ez);
 
-            const double kl = internal::klattice_array[mat];
+            const double kl = klattice_array[mat];
 
             // add lattice anisotropy field to total
             field_array_x[atom] += kl * ex * sdote;
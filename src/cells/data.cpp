@@ -30,6 +30,9 @@ namespace cells{
 
    int num_atoms_in_unit_cell=0;
    int num_cells; /// number of macro-cells
+   int num_cells_x = 0; /// number of macro-cells in x,y,z
+   int num_cells_y = 0;
+   int num_cells_z = 0;
    int num_local_cells=0; /// number of macro-cells
    double macro_cell_size = 10.0; /// macro-cells size (A)
 
@@ -75,6 +78,16 @@ namespace cells{
       std::vector<double> spin_array_z;
       std::vector<int> atom_type_array;
       int num_atoms;
+
+      std::vector<double> mag_buffer; /// packed cell moments (3*n) for reduction
+      std::vector<double> async_mag_buffer; /// packed cell moments (3*n) for non-blocking reduction
+      bool mag_reduction_pending = false; /// flag set if non-blocking reduction is outstanding
+      std::vector<double> local_mag_buffer; /// packed moments (3*n) of local atoms in cells, updated incrementally
+      bool tracking_spin_changes = false; /// flag set if local_mag_buffer is being updated incrementally
+      #ifdef MPICF
+         MPI_Request mag_request; /// request handle for non-blocking reduction
+      #endif
+
    } // end of internal namespace
 
 } // end of cells namespace
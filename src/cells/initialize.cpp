@@ -83,6 +83,9 @@ namespace cells{
       unsigned int dz =  static_cast<unsigned int>(ceil((system_dimensions_z+0.01)/cells::macro_cell_size));
 
       cells::num_cells = dx*dy*dz;
+      cells::num_cells_x = dx;
+      cells::num_cells_y = dy;
+      cells::num_cells_z = dz;
       cells::internal::cell_position_array.resize(3*cells::num_cells);
 
       //std::cout << " variable cells::num_cells = " << cells::num_cells << std::endl;
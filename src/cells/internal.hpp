@@ -28,6 +28,10 @@
 #include "cells.hpp"
 #include "material.hpp"
 
+#ifdef MPICF
+   #include <mpi.h>
+#endif
+
 // cells module headers
 #include "internal.hpp"
 
@@ -56,9 +60,19 @@ namespace cells{
       extern int num_atoms;
       //extern int num_local_atoms;
 
+      extern std::vector<double> mag_buffer; /// packed cell moments (3*n) for reduction
+      extern std::vector<double> async_mag_buffer; /// packed cell moments (3*n) for non-blocking reduction
+      extern bool mag_reduction_pending; /// flag set if non-blocking reduction is outstanding
+      extern std::vector<double> local_mag_buffer; /// packed moments (3*n) of local atoms in cells, updated incrementally
+      extern bool tracking_spin_changes; /// flag set if local_mag_buffer is being updated incrementally
+      #ifdef MPICF
+         extern MPI_Request mag_request; /// request handle for non-blocking reduction
+      #endif
+
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
+      void calculate_local_cell_moments(std::vector<double>& buffer);
 
    } // end of internal namespace
 
@@ -37,42 +37,171 @@ namespace cells{
      // check calling of routine if error checking is activated
       if(err::check==true) std::cout << "cells::mag has been called" << std::endl;
 
+      // calulate total moment in each cell, or use incrementally updated moments if available
+      if(cells::internal::tracking_spin_changes) cells::internal::mag_buffer = cells::internal::local_mag_buffer;
+      else cells::internal::calculate_local_cell_moments(cells::internal::mag_buffer);
+
+      #ifdef MPICF
+      // Reduce magnetisation on all nodes in a single packed message
+      MPI_Allreduce(MPI_IN_PLACE, &cells::internal::mag_buffer[0], cells::internal::mag_buffer.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      #endif
+
       for(int i=0; i<cells::num_cells; ++i) {
-         cells::mag_array_x[i] = 0.0;
-         cells::mag_array_y[i] = 0.0;
-         cells::mag_array_z[i] = 0.0;
+         cells::mag_array_x[i] = cells::internal::mag_buffer[3*i+0];
+         cells::mag_array_y[i] = cells::internal::mag_buffer[3*i+1];
+         cells::mag_array_z[i] = cells::internal::mag_buffer[3*i+2];
       }
 
+      return EXIT_SUCCESS;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to post non-blocking reduction of cell magnetisation. Local
+   // moments are calculated now and cells::mag_array is left unchanged until
+   // end_mag() is called, so that the reduction can overlap with later work.
+   //-----------------------------------------------------------------------------
+   void begin_mag(){
+
+      // complete any previous reduction so that only one is outstanding
+      cells::end_mag();
+
+      if(cells::internal::tracking_spin_changes) cells::internal::async_mag_buffer = cells::internal::local_mag_buffer;
+      else cells::internal::calculate_local_cell_moments(cells::internal::async_mag_buffer);
+
       #ifdef MPICF
-         int num_local_atoms = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
-      #else
-         int num_local_atoms = cells::internal::num_atoms;
+      MPI_Iallreduce(MPI_IN_PLACE, &cells::internal::async_mag_buffer[0], cells::internal::async_mag_buffer.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &cells::internal::mag_request);
       #endif
 
-      // calulate total moment in each cell
-      for(int i=0;i<num_local_atoms;++i) {
-         int cell = cells::atom_cell_id_array[i];
-         int type = cells::internal::atom_type_array[i];
-         //// Consider only cells with n_atoms != 0
-         //if(cells::num_atoms_in_cell[cell]>0){
-            const double mus = mp::material[type].mu_s_SI;
-            // Consider only magnetic elements
-            if(mp::material[type].non_magnetic==0){
-               cells::mag_array_x[cell] += atoms::x_spin_array[i]*mus;
-               cells::mag_array_y[cell] += atoms::y_spin_array[i]*mus;
-               cells::mag_array_z[cell] += atoms::z_spin_array[i]*mus;
-            }
-         //}
+      cells::internal::mag_reduction_pending = true;
+
+      return;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to complete non-blocking reduction of cell magnetisation and
+   // store result in cells::mag_array. Returns false if none was outstanding.
+   //-----------------------------------------------------------------------------
+   bool end_mag(){
+
+      if(!cells::internal::mag_reduction_pending) return false;
+
+      #ifdef MPICF
+      MPI_Wait(&cells::internal::mag_request, MPI_STATUS_IGNORE);
+      #endif
+
+      for(int i=0; i<cells::num_cells; ++i) {
+         cells::mag_array_x[i] = cells::internal::async_mag_buffer[3*i+0];
+         cells::mag_array_y[i] = cells::internal::async_mag_buffer[3*i+1];
+         cells::mag_array_z[i] = cells::internal::async_mag_buffer[3*i+2];
       }
 
+      cells::internal::mag_reduction_pending = false;
+
+      return true;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to progress outstanding non-blocking reduction, since many MPI
+   // libraries only advance collectives inside MPI calls
+   //-----------------------------------------------------------------------------
+   void test_mag(){
+
       #ifdef MPICF
-      // Reduce magnetisation on all nodes
-      MPI_Allreduce(MPI_IN_PLACE, &cells::mag_array_x[0],   cells::mag_array_x.size(),   MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &cells::mag_array_y[0],   cells::mag_array_y.size(),   MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &cells::mag_array_z[0],   cells::mag_array_z.size(),   MPI_DOUBLE,MPI_SUM, MPI_COMM_WORLD);
+      if(cells::internal::mag_reduction_pending){
+         int flag = 0;
+         MPI_Test(&cells::internal::mag_request, &flag, MPI_STATUS_IGNORE);
+      }
       #endif
 
-      return EXIT_SUCCESS;
+      return;
 
    }
+
+   //-----------------------------------------------------------------------------
+   // Function to start incremental calculation of cell magnetisation. The
+   // moments of local atoms in each cell are summed once here, and then only
+   // updated for each change of spin until tracking is stopped.
+   //-----------------------------------------------------------------------------
+   void start_tracking_spin_changes(){
+
+      if(cells::internal::tracking_spin_changes) return;
+
+      cells::internal::calculate_local_cell_moments(cells::internal::local_mag_buffer);
+      cells::internal::tracking_spin_changes = true;
+
+      return;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to stop incremental calculation of cell magnetisation, needed
+   // whenever spins are changed without calling add_spin_change()
+   //-----------------------------------------------------------------------------
+   void stop_tracking_spin_changes(){
+
+      cells::internal::tracking_spin_changes = false;
+
+      return;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to add change in moment for a single local atom to its cell
+   //-----------------------------------------------------------------------------
+   void add_spin_change(const int atom, const double Sold[3], const double Snew[3]){
+
+      if(!cells::internal::tracking_spin_changes) return;
+
+      const int type = cells::internal::atom_type_array[atom];
+
+      // Consider only magnetic elements
+      if(mp::material[type].non_magnetic==0){
+         const double mus = mp::material[type].mu_s_SI;
+         const int cell = cells::atom_cell_id_array[atom];
+         cells::internal::local_mag_buffer[3*cell+0] += (Snew[0] - Sold[0])*mus;
+         cells::internal::local_mag_buffer[3*cell+1] += (Snew[1] - Sold[1])*mus;
+         cells::internal::local_mag_buffer[3*cell+2] += (Snew[2] - Sold[2])*mus;
+      }
+
+      return;
+
+   }
+
+   namespace internal{
+
+      //--------------------------------------------------------------------------
+      // Function to calculate total moment of local atoms in each cell, packed
+      // as x,y,z for each cell
+      //--------------------------------------------------------------------------
+      void calculate_local_cell_moments(std::vector<double>& buffer){
+
+         buffer.assign(3*cells::num_cells, 0.0);
+
+         #ifdef MPICF
+            int num_local_atoms = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
+         #else
+            int num_local_atoms = cells::internal::num_atoms;
+         #endif
+
+         for(int i=0;i<num_local_atoms;++i) {
+            int cell = cells::atom_cell_id_array[i];
+            int type = cells::internal::atom_type_array[i];
+            const double mus = mp::material[type].mu_s_SI;
+            // Consider only magnetic elements
+            if(mp::material[type].non_magnetic==0){
+               buffer[3*cell+0] += atoms::x_spin_array[i]*mus;
+               buffer[3*cell+1] += atoms::y_spin_array[i]*mus;
+               buffer[3*cell+2] += atoms::z_spin_array[i]*mus;
+            }
+         }
+
+         return;
+
+      }
+
+   } // end of internal namespace
+
 } // end of cells namespace
@@ -97,6 +97,11 @@ void atoms(){
          break;
 
       case config::internal::mpi_io:{
+         // start non-blocking output in the background
+         if(config::internal::asynchronous_output){
+            io_time = queue_mpi_io_data(filename, config::internal::local_buffer);
+            break;
+         }
          vutil::vtimer_t timer; // instantiate timer
          MPI_File fh; // MPI file handle
          MPI_Status status; // MPI io status
@@ -104,16 +109,25 @@ void atoms(){
          char *cfilename = (char*)filename.c_str();
          // Open file on all processors
          MPI_File_open(MPI_COMM_WORLD, cfilename, MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &fh);
-         // write number of atoms on root process
-         if(vmpi::my_rank == 0) MPI_File_write(fh, &total_output_atoms, 1, MPI_UINT64_T, &status);
-
-         // Calculate local byte offset since MPI-IO is simple and doesn't update the file handle pointer after I/O
-         MPI_Offset data_offset = config::internal::buffer_offset + sizeof(uint64_t);
 
          timer.start(); // start timer
 
-         // Write data to disk
-         MPI_File_write_at_all(fh, data_offset, &config::internal::local_buffer[0], config::internal::local_buffer.size(), MPI_DOUBLE, &status);
+         // compressed data are written as one variable size block per process
+         if(config::internal::format == config::internal::compressed){
+            std::vector<char> data;
+            MPI_Offset data_offset = compress_data_mpi_io(config::internal::local_buffer, data);
+            MPI_File_write_at_all(fh, data_offset, &data[0], data.size(), MPI_BYTE, &status);
+         }
+         else{
+            // write number of atoms on root process
+            if(vmpi::my_rank == 0) MPI_File_write(fh, &total_output_atoms, 1, MPI_UINT64_T, &status);
+
+            // Calculate local byte offset since MPI-IO is simple and doesn't update the file handle pointer after I/O
+            MPI_Offset data_offset = config::internal::buffer_offset + sizeof(uint64_t);
+
+            // Write data to disk
+            MPI_File_write_at_all(fh, data_offset, &config::internal::local_buffer[0], config::internal::local_buffer.size(), MPI_DOUBLE, &status);
+         }
          //MPI_File_write_ordered(fh, &config::internal::local_buffer[0], config::internal::local_buffer.size(), MPI_DOUBLE, &status);
 
          timer.stop(); // Stop timer
@@ -127,14 +141,18 @@ void atoms(){
       }
 
       case config::internal::fpprocess:
-         io_time = write_data(filename, config::internal::local_buffer);
+         if(config::internal::asynchronous_output) io_time = queue_data(filename, config::internal::local_buffer);
+         else io_time = write_data(filename, config::internal::local_buffer);
          break;
 
       case config::internal::fpnode:
          // Gather data from all processors in io group
          MPI_Gatherv(&local_buffer[0], local_buffer.size(), MPI_DOUBLE, &collated_buffer[0], &io_group_recv_counts[0], &io_group_displacements[0], MPI_DOUBLE, io_group_master_id, io_comm);
          // output data on master io processes
-         if(config::internal::io_group_master) io_time = write_data(filename, config::internal::collated_buffer);
+         if(config::internal::io_group_master){
+            if(config::internal::asynchronous_output) io_time = queue_data(filename, config::internal::collated_buffer);
+            else io_time = write_data(filename, config::internal::collated_buffer);
+         }
          double max_io_time = 0.0;
          // calculate actual bandwidth on root process
          MPI_Reduce(&io_time, &max_io_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
@@ -150,14 +168,18 @@ void atoms(){
       // check for legacy output
       if(config::internal::mode == config::internal::legacy) io_time = config::internal::legacy_atoms();
       // otherwise use new one by default
+      else if(config::internal::asynchronous_output) io_time = queue_data(filename, config::internal::local_buffer);
       else io_time = write_data(filename, config::internal::local_buffer);
    #endif
 
    // stop total timer
    total_timer.stop();
 
-   // Output bandwidth to log file
-   zlog << config::internal::io_data_size/io_time << " GB/s in " << io_time << " s [ " << total_timer.elapsed_time() << " s]" << std::endl;
+   // Output bandwidth to log file (or time held for asynchronous output)
+   if(config::internal::asynchronous_output && config::internal::mode != config::internal::legacy){
+      zlog << "queued for output in " << io_time << " s [ " << total_timer.elapsed_time() << " s]" << std::endl;
+   }
+   else zlog << config::internal::io_data_size/io_time << " GB/s in " << io_time << " s [ " << total_timer.elapsed_time() << " s]" << std::endl;
 
    // increment file counter
    sim::output_atoms_file_counter++;
@@ -0,0 +1,168 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+#include <cmath>
+#include <cstring>
+
+// Vampire headers
+#include "config.hpp"
+
+// config headers
+#include "internal.hpp"
+
+namespace config
+{
+namespace internal
+{
+
+//--------------------------------------------------------------------------------------------------------
+//  Functions for compressed output of spin configurations
+//
+//  Spin directions are unit vectors and are stored using octahedral encoding, where the unit sphere
+//  is projected onto an octahedron and unfolded onto a square, quantised to two 16-bit integers per
+//  spin (maximum angular error ~ 5e-5 rad). The 16-bit codes are then delta encoded between
+//  consecutive atoms, which are usually neighbours with similar directions, and the differences are
+//  stored as zigzag variable length integers with runs of zeros stored as a zero byte and the run
+//  length.
+//
+//  File layout (all integers in native byte order as for binary output):
+//
+//     header | char[8] "VCSPINS1" | uint32 encoding | uint32 codec | uint64 atoms | uint64 blocks |
+//     block  | uint64 atoms in block | uint64 bytes in block | compressed data |
+//     ...
+//
+//  Each block is independent so that processes can compress their own data in mpi-io mode.
+//
+//--------------------------------------------------------------------------------------------------------
+
+namespace{
+
+   // append integer to byte stream
+   template <typename T> void append(std::vector<char>& data, const T value){
+      const char* bytes = reinterpret_cast<const char*>(&value);
+      data.insert(data.end(), bytes, bytes + sizeof(T));
+   }
+
+   // append variable length unsigned integer (7 bits per byte, high bit set for more bytes)
+   void append_varint(std::vector<char>& data, uint64_t value){
+      while(value >= 0x80){
+         data.push_back(char((value & 0x7F) | 0x80));
+         value >>= 7;
+      }
+      data.push_back(char(value));
+   }
+
+   // quantise value in range -1 to 1 to 16-bit integer
+   inline uint16_t quantise(const double p){
+      double q = std::floor((p * 0.5 + 0.5) * 65535.0 + 0.5);
+      if(q < 0.0) q = 0.0;
+      if(q > 65535.0) q = 65535.0;
+      return uint16_t(q);
+   }
+
+}
+
+//----------------------------------------------------------------------------------------------------
+// Function to append header for compressed spin data file
+//----------------------------------------------------------------------------------------------------
+//
+void append_compressed_header(std::vector<char>& data, const uint64_t num_atoms, const uint64_t num_blocks){
+
+   const char magic[8] = {'V','C','S','P','I','N','S','1'};
+   data.insert(data.end(), magic, magic + 8);
+
+   append(data, uint32_t(1)); // encoding (1 = octahedral, 2 x 16 bit)
+   append(data, uint32_t(1)); // codec (1 = delta, zigzag varint with zero runs)
+   append(data, num_atoms);
+   append(data, num_blocks);
+
+   return;
+
+}
+
+//----------------------------------------------------------------------------------------------------
+// Function to append block of compressed spin data for | x y z | x y z | ... buffer
+//----------------------------------------------------------------------------------------------------
+//
+void append_compressed_spin_data(std::vector<char>& data, const std::vector<double>& buffer){
+
+   const uint64_t num_atoms = buffer.size() / 3;
+
+   // save start of block and write placeholder for size
+   const uint64_t block_start = data.size();
+   append(data, num_atoms);
+   append(data, uint64_t(0));
+
+   uint16_t last[2] = {32768, 32768}; // previous code (encodes +z)
+   uint64_t zero_run = 0;             // number of consecutive zero differences
+
+   for(uint64_t atom = 0; atom < num_atoms; atom++){
+
+      const double x = buffer[3*atom + 0];
+      const double y = buffer[3*atom + 1];
+      const double z = buffer[3*atom + 2];
+
+      // project onto octahedron |x|+|y|+|z| = 1
+      const double norm = std::fabs(x) + std::fabs(y) + std::fabs(z);
+      const double inorm = norm > 0.0 ? 1.0 / norm : 0.0;
+      double px = x * inorm;
+      double py = y * inorm;
+
+      // fold lower hemisphere onto corners of square
+      if(z < 0.0){
+         const double fx = (1.0 - std::fabs(py)) * (px >= 0.0 ? 1.0 : -1.0);
+         const double fy = (1.0 - std::fabs(px)) * (py >= 0.0 ? 1.0 : -1.0);
+         px = fx;
+         py = fy;
+      }
+
+      const uint16_t code[2] = {quantise(px), quantise(py)};
+
+      for(int c = 0; c < 2; c++){
+
+         // difference to previous atom with wraparound and zigzag mapping to unsigned
+         const int16_t diff = int16_t(uint16_t(code[c] - last[c]));
+         const uint16_t zz = uint16_t((uint16_t(diff) << 1) ^ uint16_t(diff >> 15));
+         last[c] = code[c];
+
+         if(zz == 0){
+            zero_run++;
+            continue;
+         }
+
+         // flush any pending run of zeros
+         if(zero_run > 0){
+            data.push_back(0);
+            append_varint(data, zero_run - 1);
+            zero_run = 0;
+         }
+
+         append_varint(data, zz);
+
+      }
+
+   }
+
+   // flush final run of zeros
+   if(zero_run > 0){
+      data.push_back(0);
+      append_varint(data, zero_run - 1);
+   }
+
+   // store number of compressed bytes in block
+   const uint64_t num_bytes = data.size() - block_start - 2 * sizeof(uint64_t);
+   std::memcpy(&data[block_start + sizeof(uint64_t)], &num_bytes, sizeof(uint64_t));
+
+   return;
+
+}
+
+} // end of namespace internal
+} // end of namespace config
@@ -31,7 +31,7 @@ namespace config{
       //------------------------------------------------------------------------
 
       // interface and selection variables
-      format_t format = text; // format for data output (text, binary)
+      format_t format = text; // format for data output (text, binary, compressed)
       mode_t mode = fpnode; // output mode (legacy, mpi_io, file per process, file per io node)
 
       bool initialised = false; // flag to signify if config has been initialised
@@ -79,7 +79,22 @@ namespace config{
       std::vector<int> io_group_recv_counts(0); // data to receive from each process in io group
       std::vector<int> io_group_displacements(0); // offsets in obuf to receive from each process in io group
 
+      // variables for asynchronous data output
+      bool asynchronous_output = false; // flag to write data to disk in the background
+      int num_output_buffers = 2; // number of buffers in ring of data waiting to be written
+      std::vector< std::vector<double> > output_buffers(0); // ring of data buffers waiting to be written
+      std::vector<std::string> output_filenames(0); // file names for each buffer
+      uint64_t num_queued_outputs = 0; // total number of buffers queued for output
+      uint64_t num_completed_outputs = 0; // total number of buffers written to disk
+      bool output_thread_active = false; // flag set while writer thread is running
+      std::thread output_thread; // thread writing buffers to disk
+      std::mutex output_mutex; // mutex protecting ring counters
+      std::condition_variable output_condition; // signals changes in ring counters
+      std::vector< std::vector<char> > output_compressed_buffers(0); // ring of compressed data for mpi-io output
+
       #ifdef MPICF
+         std::vector<MPI_File> output_files(0); // open files for non-blocking mpi-io output of each buffer
+         std::vector<MPI_Request> output_requests(0); // requests for non-blocking mpi-io output of each buffer
          MPI_Offset linear_offset; // offset for mpi-io collective routines for integer data (bytes)
          MPI_Offset buffer_offset; // offset for mpi-io collective routines for 3 vector double data (bytes)
          MPI_Comm io_comm; // MPI IO communicator specifying a group of processors who output as a group
@@ -85,11 +85,17 @@ namespace config{
             config::internal::format = internal::text;
             return EXIT_SUCCESS;
          }
+         test="compressed";
+         if(value == test){
+            config::internal::format = internal::compressed;
+            return EXIT_SUCCESS;
+         }
          else{
             terminaltextcolor(RED);
             std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
             std::cerr << "\t\"binary\"" << std::endl;
             std::cerr << "\t\"text\"" << std::endl;
+            std::cerr << "\t\"compressed\"" << std::endl;
             terminaltextcolor(WHITE);
             err::vexit();
          }
@@ -129,6 +135,20 @@ namespace config{
          }
       }
       //--------------------------------------------------------------------
+      test="asynchronous-output";
+      if(word==test){
+         config::internal::asynchronous_output = vin::check_for_valid_bool(value, word, line, prefix,"input");
+         return EXIT_SUCCESS;
+      }
+      //--------------------------------------------------------------------
+      test="output-buffers";
+      if(word==test){
+         int n=atoi(value.c_str());
+         vin::check_for_valid_int(n, word, line, prefix, 1, 1000,"input","1 - 1,000");
+         config::internal::num_output_buffers = n;
+         return EXIT_SUCCESS;
+      }
+      //--------------------------------------------------------------------
       test="output-nodes";
       if(word==test){
          int x=atoi(value.c_str());
@@ -20,7 +20,12 @@
 //---------------------------------------------------------------------
 
 // C++ standard library headers
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 // Vampire headers
 #include "config.hpp"
@@ -33,14 +38,14 @@ namespace internal
 {
 
    // enumerated integers for option selection
-   enum format_t{ binary = 0, text = 1};
+   enum format_t{ binary = 0, text = 1, compressed = 2};
    enum mode_t{ legacy = 0, mpi_io = 1, fpprocess = 2, fpnode = 3};
 
    //-------------------------------------------------------------------------
    // Internal data type definitions
    //-------------------------------------------------------------------------
 
-   extern format_t format; // format for data output (text, binary)
+   extern format_t format; // format for data output (text, binary, compressed)
    extern mode_t mode; // output mode (legacy, mpi_io, file per process, file per io node)
 
    extern bool initialised; // flag to signify if config has been initialised
@@ -88,7 +93,22 @@ namespace internal
    extern std::vector<int> io_group_recv_counts; // data to receive from each process in io group
    extern std::vector<int> io_group_displacements; // offsets in obuf to receive from each process in io group
 
+   // variables for asynchronous data output
+   extern bool asynchronous_output; // flag to write data to disk in the background
+   extern int num_output_buffers; // number of buffers in ring of data waiting to be written
+   extern std::vector< std::vector<double> > output_buffers; // ring of data buffers waiting to be written
+   extern std::vector<std::string> output_filenames; // file names for each buffer
+   extern uint64_t num_queued_outputs; // total number of buffers queued for output
+   extern uint64_t num_completed_outputs; // total number of buffers written to disk
+   extern bool output_thread_active; // flag set while writer thread is running
+   extern std::thread output_thread; // thread writing buffers to disk
+   extern std::mutex output_mutex; // mutex protecting ring counters
+   extern std::condition_variable output_condition; // signals changes in ring counters
+   extern std::vector< std::vector<char> > output_compressed_buffers; // ring of compressed data for mpi-io output
+
    #ifdef MPICF
+      extern std::vector<MPI_File> output_files; // open files for non-blocking mpi-io output of each buffer
+      extern std::vector<MPI_Request> output_requests; // requests for non-blocking mpi-io output of each buffer
       extern MPI_Offset linear_offset; // offset for mpi-io collective routines for integer data (bytes)
       extern MPI_Offset buffer_offset; // offset for mpi-io collective routines for 3 vector double data (bytes)
       extern MPI_Comm io_comm; // MPI IO communicator specifying a group of processors who output as a group
@@ -113,6 +133,8 @@ namespace internal
    void legacy_cells_coords();
 
    double write_data(std::string, const std::vector<double> &buffer);
+   void append_compressed_header(std::vector<char>& data, const uint64_t num_atoms, const uint64_t num_blocks);
+   void append_compressed_spin_data(std::vector<char>& data, const std::vector<double>& buffer);
    double write_coord_data(std::string filename, const std::vector<double>& buffer, const std::vector<int>& type_buffer, const std::vector<int>& category_buffer);
 
    void copy_data_to_buffer(const std::vector<double> &x, // vector data
@@ -135,6 +157,14 @@ namespace internal
 
    std::string data_filename(bool coords);
 
+   double queue_data(const std::string filename, const std::vector<double>& buffer);
+   void finalize_output();
+
+   #ifdef MPICF
+      double queue_mpi_io_data(const std::string filename, const std::vector<double>& buffer);
+      MPI_Offset compress_data_mpi_io(const std::vector<double> &buffer, std::vector<char> &data);
+   #endif
+
 } // end of internal namespace
 
 } // end of config namespace
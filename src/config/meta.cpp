@@ -47,6 +47,10 @@ namespace config{
                format_string = "text";
                break;
 
+            case config::internal::compressed:
+               format_string = "compressed";
+               break;
+
          }
 
          // Get system date
@@ -165,6 +169,10 @@ namespace config{
                format_string = "text";
                break;
 
+            case config::internal::compressed:
+               format_string = "compressed";
+               break;
+
          }
 
          // Get system date
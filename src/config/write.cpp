@@ -17,6 +17,7 @@
 #include "errors.hpp"
 #include "config.hpp"
 #include "vio.hpp"
+#include "vmpi.hpp"
 #include "vutil.hpp"
 #include "sim.hpp"
 
@@ -31,6 +32,7 @@ namespace internal
 // Forward function declarations
 double write_data_text(std::string filename, const std::vector<double> &buffer);
 double write_data_binary(std::string filename, const std::vector<double> &buffer);
+double write_data_compressed(std::string filename, const std::vector<double> &buffer);
 
 //--------------------------------------------------------------------------------------------------------
 //  Function to copy and cast masked 3-vector data array to output buffer (serial and parallel versions)
@@ -39,7 +41,7 @@ double write_data_binary(std::string filename, const std::vector<double> &buffer
 //
 //                       | x y z | x y z | x y z | ... | x y z |
 //
-//  format which is then written to disk sequentially in binary or text mode.
+//  format which is then written to disk sequentially in binary, text or compressed mode.
 //
 //  Data which are to be output are predetermined in the mask for improved peformance. Data are also
 //  cast to float to reduce storage requirements from 24 to 12 bytes per datum for improved write
@@ -88,6 +90,10 @@ double write_data(std::string filename, const std::vector<double> &buffer){
          io_time = write_data_text(filename, buffer);
          break;
 
+      case config::internal::compressed:
+         io_time = write_data_compressed(filename, buffer);
+         break;
+
    }
 
    return io_time;
@@ -172,7 +178,63 @@ double write_data_binary(std::string filename, const std::vector<double> &buffer
 
 }
 
+//----------------------------------------------------------------------------------------------------
+// Function to output spin data in compressed format (see compress.cpp)
+//----------------------------------------------------------------------------------------------------
+//
+double write_data_compressed(std::string filename, const std::vector<double> &buffer){
+
+   // instantiate timer
+   vutil::vtimer_t timer;
+
+   // start timer (includes compression time)
+   timer.start();
+
+   // compress data as single block
+   std::vector<char> data;
+   data.reserve(64 + 2 * sizeof(double) * buffer.size() / 3);
+   append_compressed_header(data, buffer.size() / 3, 1);
+   append_compressed_spin_data(data, buffer);
+
+   // Declare and open output file
+   std::ofstream ofile;
+   ofile.open(filename.c_str(), std::ios::binary);
+
+   // output compressed data to disk
+   ofile.write(&data[0], data.size());
+
+   // close output file
+   ofile.close();
+
+   // end timer
+   timer.stop();
+
+   // return bandwidth
+   return timer.elapsed_time();
+
+}
+#ifdef MPICF
+//----------------------------------------------------------------------------------------------------
+// Function to compress local spin data for mpi-io output as one block per process, with the file
+// header prepended on the root process. Returns the byte offset of the data in the file.
+//----------------------------------------------------------------------------------------------------
+//
+MPI_Offset compress_data_mpi_io(const std::vector<double> &buffer, std::vector<char> &data){
+
+   data.clear();
+   if(vmpi::my_rank == 0) append_compressed_header(data, config::internal::total_output_atoms, vmpi::num_processors);
+   append_compressed_spin_data(data, buffer);
+
+   // calculate offset from compressed sizes on lower ranks
+   uint64_t local_size = data.size();
+   uint64_t offset = 0;
+   MPI_Exscan(&local_size, &offset, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+   if(vmpi::my_rank == 0) offset = 0; // result undefined on root
 
+   return MPI_Offset(offset);
+
+}
+#endif
 
 } // end of namespace internal
 } // end of namespace config
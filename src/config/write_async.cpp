@@ -0,0 +1,231 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// C++ standard library headers
+
+// Vampire headers
+#include "config.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// config headers
+#include "internal.hpp"
+
+namespace config
+{
+namespace internal
+{
+
+//--------------------------------------------------------------------------------------------------------
+//  Functions for asynchronous output of configuration data
+//
+//  Data to be written are copied into a ring of preallocated buffers and written to disk in the
+//  background, so that the simulation only waits for output when all buffers are waiting to be
+//  written.
+//
+//                     num_completed_outputs          num_queued_outputs
+//                              v                             v
+//  output_buffers    | written | being written | queued | ... | free | free |
+//
+//  In serial and file per process/node modes a dedicated thread writes the buffers using
+//  write_data(). The writer thread makes no MPI calls. In mpi-io mode the buffers are instead
+//  written with non-blocking collective MPI_File_iwrite_at_all() calls, which are completed when
+//  the buffer is next needed.
+//
+//--------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+// Function run by writer thread to write queued buffers to disk in order
+//----------------------------------------------------------------------------------------------------
+//
+void output_thread_function(){
+
+   std::unique_lock<std::mutex> lock(config::internal::output_mutex);
+
+   while(true){
+
+      // wait for queued data or end of simulation
+      while(num_completed_outputs == num_queued_outputs && output_thread_active) output_condition.wait(lock);
+
+      // finish once all data are written
+      if(num_completed_outputs == num_queued_outputs) break;
+
+      const int buffer = num_completed_outputs % num_output_buffers;
+
+      // write buffer to disk without holding lock (buffer is not changed until output is completed)
+      lock.unlock();
+      write_data(output_filenames[buffer], output_buffers[buffer]);
+      lock.lock();
+
+      num_completed_outputs++;
+      output_condition.notify_all();
+
+   }
+
+   return;
+
+}
+
+//----------------------------------------------------------------------------------------------------
+// Function to copy data to next free buffer for writing to disk by writer thread. Returns time
+// (seconds) for which the simulation was held.
+//----------------------------------------------------------------------------------------------------
+//
+double queue_data(const std::string filename, const std::vector<double>& buffer){
+
+   // instantiate timer
+   vutil::vtimer_t timer;
+
+   // start timer
+   timer.start();
+
+   std::unique_lock<std::mutex> lock(config::internal::output_mutex);
+
+   // allocate buffers and start writer thread on first call
+   if(!output_thread_active && output_buffers.size() == 0){
+      output_buffers.resize(num_output_buffers);
+      output_filenames.resize(num_output_buffers);
+      for(int b = 0; b < num_output_buffers; b++) output_buffers[b].reserve(buffer.size());
+      output_thread_active = true;
+      output_thread = std::thread(output_thread_function);
+   }
+
+   // wait for free buffer if all buffers are waiting to be written
+   while(num_queued_outputs - num_completed_outputs >= uint64_t(num_output_buffers)) output_condition.wait(lock);
+
+   const int b = num_queued_outputs % num_output_buffers;
+
+   // copy data without holding lock (buffer is not used by writer thread until queued)
+   lock.unlock();
+   output_buffers[b].assign(buffer.begin(), buffer.end());
+   output_filenames[b] = filename;
+   lock.lock();
+
+   num_queued_outputs++;
+   output_condition.notify_all();
+
+   // end timer
+   timer.stop();
+
+   return timer.elapsed_time();
+
+}
+
+#ifdef MPICF
+//----------------------------------------------------------------------------------------------------
+// Function to copy data to next free buffer and start non-blocking collective mpi-io output.
+// Returns time (seconds) for which the simulation was held.
+//----------------------------------------------------------------------------------------------------
+//
+double queue_mpi_io_data(const std::string filename, const std::vector<double>& buffer){
+
+   // instantiate timer
+   vutil::vtimer_t timer;
+
+   // start timer
+   timer.start();
+
+   // allocate buffers on first call
+   if(output_buffers.size() == 0){
+      output_buffers.resize(num_output_buffers);
+      output_files.resize(num_output_buffers);
+      output_requests.resize(num_output_buffers);
+      if(config::internal::format == config::internal::compressed) output_compressed_buffers.resize(num_output_buffers);
+      for(int b = 0; b < num_output_buffers; b++) output_buffers[b].reserve(buffer.size());
+   }
+
+   // complete oldest output if all buffers are waiting to be written
+   if(num_queued_outputs - num_completed_outputs >= uint64_t(num_output_buffers)){
+      const int b = num_completed_outputs % num_output_buffers;
+      MPI_Wait(&output_requests[b], MPI_STATUS_IGNORE);
+      MPI_File_close(&output_files[b]);
+      num_completed_outputs++;
+   }
+
+   const int b = num_queued_outputs % num_output_buffers;
+
+   // convert filename to character string for output
+   char *cfilename = (char*)filename.c_str();
+   // Open file on all processors
+   MPI_File_open(MPI_COMM_WORLD, cfilename, MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &output_files[b]);
+
+   // compressed data are written as one variable size block per process
+   if(config::internal::format == config::internal::compressed){
+      MPI_Offset data_offset = compress_data_mpi_io(buffer, output_compressed_buffers[b]);
+      MPI_File_iwrite_at_all(output_files[b], data_offset, &output_compressed_buffers[b][0], output_compressed_buffers[b].size(), MPI_BYTE, &output_requests[b]);
+   }
+   else{
+      output_buffers[b].assign(buffer.begin(), buffer.end());
+
+      MPI_Status status; // MPI io status
+      // write number of atoms on root process
+      if(vmpi::my_rank == 0) MPI_File_write(output_files[b], &total_output_atoms, 1, MPI_UINT64_T, &status);
+
+      // Calculate local byte offset since MPI-IO is simple and doesn't update the file handle pointer after I/O
+      MPI_Offset data_offset = config::internal::buffer_offset + sizeof(uint64_t);
+
+      // Start writing data to disk
+      MPI_File_iwrite_at_all(output_files[b], data_offset, &output_buffers[b][0], output_buffers[b].size(), MPI_DOUBLE, &output_requests[b]);
+   }
+
+   num_queued_outputs++;
+
+   // end timer
+   timer.stop();
+
+   return timer.elapsed_time();
+
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------
+// Function to complete all outstanding asynchronous output at end of simulation
+//----------------------------------------------------------------------------------------------------
+//
+void finalize_output(){
+
+   // stop writer thread once all queued data are written
+   if(output_thread_active){
+      {
+         std::unique_lock<std::mutex> lock(config::internal::output_mutex);
+         output_thread_active = false;
+         output_condition.notify_all();
+      }
+      output_thread.join();
+   }
+
+   // complete outstanding non-blocking mpi-io output
+   #ifdef MPICF
+      while(num_completed_outputs < num_queued_outputs){
+         const int b = num_completed_outputs % num_output_buffers;
+         MPI_Wait(&output_requests[b], MPI_STATUS_IGNORE);
+         MPI_File_close(&output_files[b]);
+         num_completed_outputs++;
+      }
+   #endif
+
+   return;
+
+}
+
+} // end of namespace internal
+
+//----------------------------------------------------------------------------------------------------
+// Function to complete all outstanding output at end of simulation
+//----------------------------------------------------------------------------------------------------
+//
+void finalize(){
+
+   config::internal::finalize_output();
+
+   return;
+
+}
+
+} // end of namespace config
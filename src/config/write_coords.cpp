@@ -42,7 +42,9 @@ double write_coord_data(std::string filename, const std::vector<double>& buffer,
 
    switch (config::internal::format){
 
+      // coordinates are not compressed to preserve precision
       case config::internal::binary:
+      case config::internal::compressed:
          io_time = write_coord_data_binary(filename, buffer, type_buffer, category_buffer);
          break;
 
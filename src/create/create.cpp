@@ -128,46 +128,62 @@ int create(){
 		if(vmpi::mpi_mode==0) vmpi::geometric_decomposition(vmpi::num_processors,cs::system_dimensions);
 	#endif
 
-	// Create block of crystal of desired size
-	cs::create_crystal_structure(catom_array);
-
-	// Cut system to the correct type, species etc
-	create::create_system_type(catom_array);
-
-	// Copy atoms for interprocessor communications
-	#ifdef MPICF
-	if(vmpi::mpi_mode==0){
-		create::internal::copy_halo_atoms(catom_array);
-   }
-	#endif
-
    //---------------------------------------------
-	// Create Neighbour lists for system
+   // Neighbour lists for system
    //---------------------------------------------
    neighbours::list_t bilinear; // bilinear exchange list
    neighbours::list_t biquadratic; // biquadratic exchange list
 
-   // generate bilinear exchange list
-   bilinear.generate(catom_array, cs::unit_cell.bilinear, na, ucx, ucy, ucz);
+   // Load previously generated structure from cache if available, otherwise generate structure
+   if(!create::internal::load_structure_cache(catom_array, bilinear, biquadratic)){
 
-   // optionally create a biquadratic neighbour list
-   if(exchange::biquadratic){
-      biquadratic.generate(catom_array, cs::unit_cell.biquadratic, na, ucx, ucy, ucz);
-   }
+      // Optionally rebalance decomposition by number of atoms on each process
+      #ifdef MPICF
+         if(vmpi::mpi_mode==0 && vmpi::weighted_decomposition) create::internal::balance_decomposition(catom_array);
+      #endif
 
-	#ifdef MPICF
-		create::internal::identify_mpi_boundary_atoms(catom_array,bilinear);
-      if(exchange::biquadratic) create::internal::identify_mpi_boundary_atoms(catom_array,biquadratic);
-      create::internal::mark_non_interacting_halo(catom_array);
-      // Sort Arrays by MPI Type
-      create::internal::sort_atoms_by_mpi_type(catom_array, bilinear, biquadratic);
-	#endif
+      // Create block of crystal of desired size
+      cs::create_crystal_structure(catom_array);
 
-	#ifdef MPICF
-      // ** Must be done in parallel **
-		create::internal::init_mpi_comms(catom_array);
-		vmpi::barrier();
-	#endif
+      // Cut system to the correct type, species etc
+      create::create_system_type(catom_array);
+
+      // Copy atoms for interprocessor communications
+      #ifdef MPICF
+      if(vmpi::mpi_mode==0){
+         create::internal::copy_halo_atoms(catom_array);
+      }
+      #endif
+
+      // generate bilinear exchange list
+      bilinear.generate(catom_array, cs::unit_cell.bilinear, na, ucx, ucy, ucz);
+
+      // optionally create a biquadratic neighbour list
+      if(exchange::biquadratic){
+         biquadratic.generate(catom_array, cs::unit_cell.biquadratic, na, ucx, ucy, ucz);
+      }
+
+      #ifdef MPICF
+         create::internal::identify_mpi_boundary_atoms(catom_array,bilinear);
+         if(exchange::biquadratic) create::internal::identify_mpi_boundary_atoms(catom_array,biquadratic);
+         create::internal::mark_non_interacting_halo(catom_array);
+         // Sort Arrays by MPI Type
+         create::internal::sort_atoms_by_mpi_type(catom_array, bilinear, biquadratic);
+      #endif
+
+      // Optionally sort atoms along a space filling curve for improved memory locality
+      create::internal::sort_atoms_by_curve(catom_array, bilinear, biquadratic);
+
+      #ifdef MPICF
+         // ** Must be done in parallel **
+         create::internal::init_mpi_comms(catom_array);
+         vmpi::barrier();
+      #endif
+
+      // Save generated structure to cache for subsequent runs
+      create::internal::save_structure_cache(catom_array, bilinear, biquadratic);
+
+   }
 
 	// Print informative message
 	std::cout << "Copying system data to optimised data structures." << std::endl;
@@ -245,6 +261,15 @@ int create(){
 	MPI_Reduce(&my_num_atoms,&total_num_atoms, 1,MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
 	std::cout << "Total number of atoms (all CPUs): " << total_num_atoms << std::endl;
    zlog << zTs() << "Total number of atoms (all CPUs): " << total_num_atoms << std::endl;
+
+   // Determine load imbalance factor (maximum/mean atoms per process)
+   int max_num_atoms=0;
+   MPI_Reduce(&my_num_atoms,&max_num_atoms, 1,MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
+   if(vmpi::my_rank==0){
+      const double imbalance = double(max_num_atoms)*double(vmpi::num_processors)/double(total_num_atoms);
+      std::cout << "Load imbalance factor (maximum/mean atoms per CPU): " << imbalance << std::endl;
+      zlog << zTs() << "Load imbalance factor (maximum/mean atoms per CPU): " << imbalance << std::endl;
+   }
 	#else
 	std::cout << "Number of atoms generated: " << atoms::num_atoms << std::endl;
    zlog << zTs() << "Number of atoms generated: " << atoms::num_atoms << std::endl;
@@ -62,6 +62,7 @@ void set_atom_vars(std::vector<cs::catom_t> & catom_array,
    atoms::category_array.resize( atoms::num_atoms,0);
    atoms::grain_array.resize(    atoms::num_atoms,0);
    atoms::cell_array.resize(     atoms::num_atoms,0);
+   atoms::global_id_array.resize(atoms::num_atoms,0);
 
 	atoms::x_total_spin_field_array.resize(atoms::num_atoms,0.0);
 	atoms::y_total_spin_field_array.resize(atoms::num_atoms,0.0);
@@ -81,6 +82,12 @@ void set_atom_vars(std::vector<cs::catom_t> & catom_array,
 	dipole::atom_mu0demag_field_array_y.resize(atoms::num_atoms,0.0);
 	dipole::atom_mu0demag_field_array_z.resize(atoms::num_atoms,0.0);
 
+   // Number of unit cells and atoms per unit cell for global atom id
+   const int64_t ncx = cs::total_num_unit_cells[0];
+   const int64_t ncy = cs::total_num_unit_cells[1];
+   const int64_t ncz = cs::total_num_unit_cells[2];
+   const int64_t nuca = cs::unit_cell.atom.size();
+
    // Set custom RNG for spin initialisation
    MTRand random_spin_rng;
    random_spin_rng.seed(vmpi::parallel_rng_seed(create::internal::spin_init_seed));
@@ -96,6 +103,12 @@ void set_atom_vars(std::vector<cs::catom_t> & catom_array,
 		//std::cout << atom << " grain: " << catom_array[atom].grain << std::endl;
 		atoms::grain_array[atom] = catom_array[atom].grain;
 
+		// set global atom id from unit cell position (periodic images share the same id)
+		const int64_t scx = ((catom_array[atom].scx % ncx) + ncx) % ncx;
+		const int64_t scy = ((catom_array[atom].scy % ncy) + ncy) % ncy;
+		const int64_t scz = ((catom_array[atom].scz % ncz) + ncz) % ncz;
+		atoms::global_id_array[atom] = uint64_t(((scz*ncy + scy)*ncx + scx)*nuca + catom_array[atom].uc_id);
+
 		// initialise atomic spin positions
       // Use a normalised gaussian for uniform distribution on a unit sphere
 		int mat=atoms::type_array[atom];
@@ -121,7 +134,7 @@ void set_atom_vars(std::vector<cs::catom_t> & catom_array,
    //---------------------------------------------------------------------------
    // Identify surface atoms and initialise anisotropy data
    //---------------------------------------------------------------------------
-   anisotropy::identify_surface_atoms(catom_array, bilinear.list);
+   anisotropy::identify_surface_atoms(catom_array, bilinear);
 
 	//===========================================================
 	// Create 1-D neighbourlist
@@ -133,16 +146,16 @@ void set_atom_vars(std::vector<cs::catom_t> & catom_array,
    //-------------------------------------------------
 	//	Initialise exchange calculation
 	//-------------------------------------------------
-   exchange::initialize(bilinear.list, biquadratic.list);
+   exchange::initialize(bilinear, biquadratic);
 
    // Save number of atoms in unit cell first
    cells::num_atoms_in_unit_cell = cs::unit_cell.atom.size();
 
    // Now nuke generation vectors to free memory NOW
    std::vector<cs::catom_t> zerov;
-   std::vector<std::vector <neighbours::neighbour_t> > zerovv;
    catom_array.swap(zerov);
-   bilinear.list.swap(zerovv);
+   bilinear.clear();
+   biquadratic.clear();
 
    return;
 
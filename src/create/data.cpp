@@ -53,6 +53,11 @@ namespace create{
 
          bool select_material_by_z_height = false;	// Toggle overwriting of material id by z-height
 
+         atom_ordering_t atom_ordering = generation_order; // order of atoms in memory after creation
+
+         bool structure_cache = false; // flag to save and load generated structure from cache file
+         std::string structure_cache_directory = "."; // directory for structure cache files
+
       } // end of internal namespace
 
 } // end of create namespace
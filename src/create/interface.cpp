@@ -519,6 +519,45 @@ namespace create{
          create::internal::spin_init_seed = sirs;
          return true;
       }
+      //--------------------------------------------------------------------
+      test="structure-cache";
+      if(word==test){
+         create::internal::structure_cache = vin::check_for_valid_bool(value, word, line, prefix,"input");
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test="structure-cache-directory";
+      if(word==test){
+         create::internal::structure_cache_directory = value;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test="atom-ordering";
+      if(word==test){
+         test="generation";
+         if(value==test){
+            create::internal::atom_ordering = create::internal::generation_order;
+            return true;
+         }
+         test="morton";
+         if(value==test){
+            create::internal::atom_ordering = create::internal::morton_order;
+            return true;
+         }
+         test="hilbert";
+         if(value==test){
+            create::internal::atom_ordering = create::internal::hilbert_order;
+            return true;
+         }
+         terminaltextcolor(RED);
+         std::cerr << "Error - value for \'create:" << word << "\' must be one of:" << std::endl;
+         std::cerr << "\t\"generation\"" << std::endl;
+         std::cerr << "\t\"morton\"" << std::endl;
+         std::cerr << "\t\"hilbert\"" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error - value for \'create:" << word << "\' must be one of generation, morton or hilbert" << std::endl;
+         err::vexit();
+      }
       /*std::string test="slonczewski-spin-polarization-unit-vector";
       if(word==test){
          std::vector<double> u(3);
@@ -34,6 +34,9 @@ namespace create{
       enum host_alloy_d_t { homogeneous, random, granular };
       enum slave_alloy_d_t { native, reciprocal, uniform };
 
+      // ordering of atoms in memory
+      enum atom_ordering_t { generation_order, morton_order, hilbert_order };
+
       struct core_radius_t{
          int mat;
          double radius;
@@ -124,6 +127,11 @@ namespace create{
 
       extern bool select_material_by_z_height;
 
+      extern atom_ordering_t atom_ordering; // order of atoms in memory after creation
+
+      extern bool structure_cache; // flag to save and load generated structure from cache file
+      extern std::string structure_cache_directory; // directory for structure cache files
+
       //-----------------------------------------------------------------------------
       // Internal functions for create module
       //-----------------------------------------------------------------------------
@@ -150,6 +158,7 @@ namespace create{
       extern void hex_particle_array(std::vector<cs::catom_t> &);
       extern void centre_particle_on_atom(std::vector<double>& particle_origin, std::vector<cs::catom_t>& catom_array);
       extern void sort_atoms_by_grain(std::vector<cs::catom_t> & catom_array);
+      extern void sort_atoms_by_curve(std::vector<cs::catom_t> & catom_array, neighbours::list_t& bilinear, neighbours::list_t& biquadratic);
       extern void clear_atoms(std::vector<cs::catom_t> &);
 
       extern void voronoi_substructure(std::vector<cs::catom_t> & catom_array);
@@ -170,6 +179,11 @@ namespace create{
       extern void mark_non_interacting_halo(std::vector<cs::catom_t>& catom_array);
       extern void sort_atoms_by_mpi_type(std::vector<cs::catom_t> & catom_array, neighbours::list_t& bilinear, neighbours::list_t& biquadratic);
       extern void init_mpi_comms(std::vector<cs::catom_t> & catom_array);
+      extern void balance_decomposition(std::vector<cs::catom_t> & catom_array);
+
+      // structure cache functions
+      bool load_structure_cache(std::vector<cs::catom_t>& catom_array, neighbours::list_t& bilinear, neighbours::list_t& biquadratic);
+      void save_structure_cache(const std::vector<cs::catom_t>& catom_array, const neighbours::list_t& bilinear, const neighbours::list_t& biquadratic);
 
    } // end of internal namespace
 } // end of create namespace
@@ -21,10 +21,12 @@
 #include "create.hpp"
 #include "material.hpp"
 #include "errors.hpp"
+#include "random.hpp"
 #include "vio.hpp"
 #include "vmpi.hpp"
 
-
+// Internal create header
+#include "internal.hpp"
 
 #ifdef MPICF
 
@@ -503,10 +505,10 @@ namespace create{
             const int my_mpi_type = catom_array[atom].mpi_type;
 
             // loop over all neighbours for atom
-            for( unsigned int nn = 0; nn < cneighbourlist.list[atom].size(); nn++ ){
+            for( uint64_t nn = cneighbourlist.start_index[atom]; nn < cneighbourlist.start_index[atom+1]; nn++ ){
 
                // identify neighbour atom
-               const uint64_t natom = cneighbourlist.list[atom][nn].nn;
+               const uint64_t natom = cneighbourlist.nn[nn];
 
                // define nearest neighbour MPI type
                int nn_mpi_type = catom_array[natom].mpi_type;
@@ -641,100 +643,27 @@ namespace create{
          zlog << zTs() << "Number of local atoms: " << vmpi::num_core_atoms +vmpi::num_bdry_atoms << std::endl;
          zlog << zTs() << "Number of total atoms: " << vmpi::num_core_atoms +vmpi::num_bdry_atoms + vmpi::num_halo_atoms << std::endl;
 
-         // create temporary catom and cneighbourlist arrays for copying data
+         // create temporary catom array for copying data
          std::vector <cs::catom_t> tmp_catom_array(new_num_atoms);
-         std::vector <std::vector <neighbours::neighbour_t> > tmp_bilinear(new_num_atoms);
-         std::vector <std::vector <neighbours::neighbour_t> > tmp_biquadratic(new_num_atoms);
+
+         // old atom number for each new atom number
+         std::vector<int> old_atom_number(new_num_atoms);
 
          // Populate tmp arrays (assuming all mpi_type=3 atoms are at the end of the array?)
          for (unsigned int atom=0;atom<new_num_atoms;atom++){ // new atom number
             unsigned int old_atom_num = mpi_type_vec[atom].atom_number;
             tmp_catom_array[atom]=catom_array[old_atom_num];
             tmp_catom_array[atom].mpi_old_atom_number=old_atom_num; // Store old atom numbers for translation after sorting
-            //---//tmp_cneighbourlist[atom].reserve(cneighbourlist[old_atom_num].size());
-
-            //Copy neighbourlist using new atom numbers
-            //if(vmpi::my_rank==0) std::cout << vmpi::my_rank << " old " << old_atom_num << " nn: ";
-            /*for(unsigned int nn=0;nn<cneighbourlist[old_atom_num].size();nn++){
-               unsigned int old_nn_number = cneighbourlist[old_atom_num][nn].nn;
-               unsigned int interaction_id= cneighbourlist[old_atom_num][nn].i;
-               unsigned int new_nn_number = inv_mpi_type_vec[old_nn_number];
-               cs::neighbour_t temp_nt;
-               temp_nt.nn=new_nn_number;
-               temp_nt.i=interaction_id;
-               // Actual neighbours stay the same so simply copy separation vectors
-               temp_nt.vx=cneighbourlist[old_atom_num][nn].vx;
-               temp_nt.vy=cneighbourlist[old_atom_num][nn].vy;
-               temp_nt.vz=cneighbourlist[old_atom_num][nn].vz;
-               // ignore all halo-x interactions but not x-halo
-               //if(!((mpi_type_vec[atom].mpi_type==2) && (mpi_type_vec[new_nn_number].mpi_type==2)))
-               if(!(mpi_type_vec[atom].mpi_type==2))
-               tmp_cneighbourlist[atom].push_back(temp_nt);
-               //else std::cerr << "ignoring interaction " << atom << "\t" << new_nn_number << " on " << vmpi::my_rank << std::endl;
-               //if(vmpi::my_rank==0) std::cout << cneighbourlist[old_atom_num][nn].nn << "\t";
-            }*/
-
-            tmp_bilinear[atom].reserve(bilinear.list[old_atom_num].size());
-
-            // Copy bilinear neighbourlist using new atom numbers
-            for(unsigned int nn = 0; nn < bilinear.list[old_atom_num].size(); nn++){
-
-               unsigned int old_nn_number = bilinear.list[old_atom_num][nn].nn;
-               unsigned int interaction_id= bilinear.list[old_atom_num][nn].i;
-               unsigned int new_nn_number = inv_mpi_type_vec[old_nn_number];
-
-               neighbours::neighbour_t temp_nt;
-
-               temp_nt.nn=new_nn_number;
-               temp_nt.i=interaction_id;
-
-               // Actual neighbours stay the same so simply copy separation vectors
-               temp_nt.vx=bilinear.list[old_atom_num][nn].vx;
-               temp_nt.vy=bilinear.list[old_atom_num][nn].vy;
-               temp_nt.vz=bilinear.list[old_atom_num][nn].vz;
-
-               // ignore all halo-x interactions but not x-halo
-               if(!(mpi_type_vec[atom].mpi_type==2)) tmp_bilinear[atom].push_back(temp_nt);
-
-            }
-
-            // optionally replace biquadratic list
-            if(exchange::biquadratic){
-               tmp_biquadratic[atom].reserve(biquadratic.list[old_atom_num].size());
-
-               // Copy bilinear neighbourlist using new atom numbers
-               for(unsigned int nn = 0; nn < biquadratic.list[old_atom_num].size();nn++){
-
-                  unsigned int old_nn_number = biquadratic.list[old_atom_num][nn].nn;
-                  unsigned int interaction_id= biquadratic.list[old_atom_num][nn].i;
-                  unsigned int new_nn_number = inv_mpi_type_vec[old_nn_number];
-
-                  neighbours::neighbour_t temp_nt;
-
-                  temp_nt.nn = new_nn_number;
-                  temp_nt.i = interaction_id;
-
-                  // Actual neighbours stay the same so simply copy separation vectors
-                  temp_nt.vx = biquadratic.list[old_atom_num][nn].vx;
-                  temp_nt.vy = biquadratic.list[old_atom_num][nn].vy;
-                  temp_nt.vz = biquadratic.list[old_atom_num][nn].vz;
-
-                  // ignore all halo-x interactions but not x-halo
-                  if(!(mpi_type_vec[atom].mpi_type==2)) tmp_biquadratic[atom].push_back(temp_nt);
-
-               }
-            } // end of biquadratic
-
+            old_atom_number[atom] = old_atom_num;
          }
 
-
-
          // Swap tmp data over old data more efficient and saves memory
          catom_array.swap(tmp_catom_array);
-         //----// cneighbourlist.swap(tmp_cneighbourlist); // This actually works(!) - COPIES both pointers and elements of pointers
 
-         bilinear.list.swap(tmp_bilinear); // This actually works(!) - COPIES both pointers and elements of pointers
-         biquadratic.list.swap(tmp_biquadratic);
+         // Copy neighbour lists using new atom numbers, ignoring all halo-x interactions but not x-halo
+         const uint64_t num_local_atoms = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+         bilinear.reorder(old_atom_number, inv_mpi_type_vec, num_local_atoms);
+         if(exchange::biquadratic) biquadratic.reorder(old_atom_number, inv_mpi_type_vec, num_local_atoms);
 
          // Print out final neighbourlist
          //for (unsigned int atom=0;atom<new_num_atoms;atom++){
@@ -881,6 +810,52 @@ namespace create{
          return;
       }
 
+      //------------------------------------------------------------------------
+      // Function to rebalance geometric decomposition by number of atoms. The
+      // structure is generated for the initial geometric decomposition and the
+      // system is then decomposed by recursive bisection weighted by the atoms
+      // generated, after which the structure is discarded for regeneration.
+      // The states of the random number generators used in structure creation
+      // are restored so that the regenerated structure uses the same streams.
+      //------------------------------------------------------------------------
+      void balance_decomposition(std::vector<cs::catom_t> & catom_array){
+
+         zlog << zTs() << "Generating structure to determine atom-weighted decomposition" << std::endl;
+
+         // save state of random number generators
+         std::vector<uint32_t> create_rng_state(624); // 624 is hard coded in mt implementation
+         std::vector<uint32_t> global_rng_state(624);
+         int32_t create_rng_p = create::internal::grnd.get_state(create_rng_state);
+         int32_t global_rng_p = mtrandom::grnd.get_state(global_rng_state);
+
+         // generate structure for initial decomposition
+         cs::create_crystal_structure(catom_array);
+         create::create_system_type(catom_array);
+
+         // save coordinates of generated atoms
+         std::vector<double> coordinates(3*catom_array.size());
+         for(unsigned int atom = 0; atom < catom_array.size(); atom++){
+            coordinates[3*atom+0] = catom_array[atom].x;
+            coordinates[3*atom+1] = catom_array[atom].y;
+            coordinates[3*atom+2] = catom_array[atom].z;
+         }
+
+         // discard generated structure
+         std::vector<cs::catom_t>().swap(catom_array);
+         cs::non_magnetic_atoms_array.clear();
+
+         // restore state of random number generators for regeneration
+         create::internal::grnd.set_state(create_rng_state, create_rng_p);
+         mtrandom::grnd.set_state(global_rng_state, global_rng_p);
+
+         // decompose system weighted by atoms
+         int num_cells[3] = { int(cs::total_num_unit_cells[0]), int(cs::total_num_unit_cells[1]), int(cs::total_num_unit_cells[2]) };
+         vmpi::recursive_bisection_decomposition(cs::system_dimensions, cs::unit_cell.dimensions, num_cells, coordinates);
+
+         return;
+
+      }
+
    } // end of internal namespace
 
 } // end of create namespace
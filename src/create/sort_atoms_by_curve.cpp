@@ -0,0 +1,221 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+
+// Vampire headers
+#include "create.hpp"
+#include "exchange.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// Internal create header
+#include "internal.hpp"
+
+namespace create{
+namespace internal{
+
+   // simple class for sorting atoms along a curve
+   class curve_t{
+   public:
+      int mpi_type; // core, boundary and halo atoms are sorted separately
+      uint64_t key; // position of atom along curve
+      int atom; // atom number in original order
+   };
+
+   // comparison function
+   bool compare_curve(const curve_t& first, const curve_t& second){
+      if(first.mpi_type != second.mpi_type) return first.mpi_type < second.mpi_type;
+      return first.key < second.key;
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to calculate Morton (z-order) key by interleaving the bits of the
+   // integer coordinates
+   //------------------------------------------------------------------------------
+   uint64_t morton_key(const uint32_t x, const uint32_t y, const uint32_t z, const int bits){
+
+      uint64_t key = 0;
+      for(int b = bits-1; b >= 0; b--){
+         key = (key << 3) | (uint64_t((x >> b) & 1) << 2) | (uint64_t((y >> b) & 1) << 1) | uint64_t((z >> b) & 1);
+      }
+
+      return key;
+
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to calculate Hilbert key from integer coordinates, using the
+   // transpose method of J. Skilling, AIP Conf. Proc. 707, 381 (2004)
+   //------------------------------------------------------------------------------
+   uint64_t hilbert_key(const uint32_t x, const uint32_t y, const uint32_t z, const int bits){
+
+      uint32_t X[3] = {x, y, z};
+      const uint32_t M = 1u << (bits-1);
+
+      // inverse undo of excess work
+      for(uint32_t Q = M; Q > 1; Q >>= 1){
+         const uint32_t P = Q - 1;
+         for(int i = 0; i < 3; i++){
+            if(X[i] & Q) X[0] ^= P; // invert
+            else{ // exchange
+               const uint32_t t = (X[0] ^ X[i]) & P;
+               X[0] ^= t;
+               X[i] ^= t;
+            }
+         }
+      }
+
+      // gray encode
+      X[1] ^= X[0];
+      X[2] ^= X[1];
+      uint32_t t = 0;
+      for(uint32_t Q = M; Q > 1; Q >>= 1){
+         if(X[2] & Q) t ^= Q - 1;
+      }
+      for(int i = 0; i < 3; i++) X[i] ^= t;
+
+      // transposed coordinates interleave to give Hilbert index
+      return morton_key(X[0], X[1], X[2], bits);
+
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to estimate the number of cache misses when reading neighbouring
+   // spins in the exchange field loop. Spins are stored in three arrays of
+   // doubles, and the cache is modelled as set associative with 64 byte lines
+   // and least recently used replacement. At most max_atoms atoms are simulated.
+   //------------------------------------------------------------------------------
+   uint64_t exchange_cache_misses(const neighbours::list_t& list,
+                                  const int cache_size, const int ways, const int max_atoms){
+
+      const int num_atoms = list.num_atoms();
+      const int end = num_atoms < max_atoms ? num_atoms : max_atoms;
+      const uint64_t lines_per_array = (uint64_t(num_atoms) + 7)/8;
+      const int sets = cache_size/(64*ways);
+
+      std::vector<uint64_t> tag(sets*ways, ~uint64_t(0)); // line held in each way
+      std::vector<uint64_t> last_used(sets*ways, 0); // time of last use of each way
+      uint64_t time = 0;
+      uint64_t misses = 0;
+
+      for(int atom = 0; atom < end; atom++){
+         for(uint64_t nn = list.start_index[atom]; nn < list.start_index[atom+1]; nn++){
+            const uint64_t natom = list.nn[nn];
+            for(int component = 0; component < 3; component++){
+               const uint64_t line = component*lines_per_array + natom/8;
+               const int set = line % sets;
+               int lru = set*ways;
+               bool hit = false;
+               for(int way = set*ways; way < (set+1)*ways; way++){
+                  if(tag[way] == line){
+                     hit = true;
+                     lru = way;
+                     break;
+                  }
+                  if(last_used[way] < last_used[lru]) lru = way;
+               }
+               if(!hit){
+                  misses++;
+                  tag[lru] = line;
+               }
+               last_used[lru] = ++time;
+            }
+         }
+      }
+
+      return misses;
+
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to sort atoms along a space filling curve so that atoms which are
+   // close in space are also close in memory. Core, boundary and halo atoms are
+   // sorted separately to preserve the MPI ordering, and neighbour lists are
+   // renumbered. Must be called before MPI communications and atomic data
+   // structures are initialised, so that all per-atom data follows the new order.
+   //------------------------------------------------------------------------------
+   void sort_atoms_by_curve(std::vector<cs::catom_t> & catom_array, neighbours::list_t& bilinear, neighbours::list_t& biquadratic){
+
+      if(create::internal::atom_ordering == create::internal::generation_order) return;
+
+      const int num_atoms = catom_array.size();
+      if(num_atoms == 0) return;
+
+      // estimate cache misses for original order
+      const int max_atoms = 1000000; // maximum number of atoms to simulate in cache model
+      const int model_atoms = num_atoms < max_atoms ? num_atoms : max_atoms;
+      const uint64_t l1_misses_before = exchange_cache_misses(bilinear, 32*1024, 8, max_atoms);
+      const uint64_t l2_misses_before = exchange_cache_misses(bilinear, 1024*1024, 16, max_atoms);
+
+      // determine extent of system
+      double min[3] = { catom_array[0].x, catom_array[0].y, catom_array[0].z };
+      double max[3] = { catom_array[0].x, catom_array[0].y, catom_array[0].z };
+      for(int atom = 0; atom < num_atoms; atom++){
+         const double r[3] = { catom_array[atom].x, catom_array[atom].y, catom_array[atom].z };
+         for(int i = 0; i < 3; i++){
+            if(r[i] < min[i]) min[i] = r[i];
+            if(r[i] > max[i]) max[i] = r[i];
+         }
+      }
+      double extent = 0.0;
+      for(int i = 0; i < 3; i++) if(max[i] - min[i] > extent) extent = max[i] - min[i];
+
+      // calculate position of each atom along curve on a grid of 2^21 points in each direction
+      const int bits = 21;
+      const double scale = extent > 0.0 ? double((1u << bits) - 1)/extent : 0.0;
+
+      std::vector<curve_t> curve(num_atoms);
+      for(int atom = 0; atom < num_atoms; atom++){
+         const uint32_t x = uint32_t((catom_array[atom].x - min[0])*scale);
+         const uint32_t y = uint32_t((catom_array[atom].y - min[1])*scale);
+         const uint32_t z = uint32_t((catom_array[atom].z - min[2])*scale);
+         curve[atom].mpi_type = catom_array[atom].mpi_type;
+         curve[atom].key = create::internal::atom_ordering == create::internal::hilbert_order ? hilbert_key(x, y, z, bits) : morton_key(x, y, z, bits);
+         curve[atom].atom = atom;
+      }
+
+      // sort atoms (stable to give a reproducible order for atoms at the same point)
+      std::stable_sort(curve.begin(), curve.end(), compare_curve);
+
+      // determine old and new atom number for each atom
+      std::vector<int> old_atom_number(num_atoms);
+      std::vector<int> new_atom_number(num_atoms);
+      for(int atom = 0; atom < num_atoms; atom++){
+         old_atom_number[atom] = curve[atom].atom;
+         new_atom_number[curve[atom].atom] = atom;
+      }
+
+      // copy atoms to new order
+      std::vector <cs::catom_t> tmp_catom_array(num_atoms);
+      for(int atom = 0; atom < num_atoms; atom++) tmp_catom_array[atom] = catom_array[old_atom_number[atom]];
+      catom_array.swap(tmp_catom_array);
+
+      // reorder neighbour lists (neighbours keep the same order so that exchange fields are summed identically)
+      bilinear.reorder(old_atom_number, new_atom_number, num_atoms);
+      if(exchange::biquadratic) biquadratic.reorder(old_atom_number, new_atom_number, num_atoms);
+
+      // estimate cache misses for new order
+      const uint64_t l1_misses_after = exchange_cache_misses(bilinear, 32*1024, 8, max_atoms);
+      const uint64_t l2_misses_after = exchange_cache_misses(bilinear, 1024*1024, 16, max_atoms);
+
+      const std::string curve_name = create::internal::atom_ordering == create::internal::hilbert_order ? "Hilbert" : "Morton";
+      zlog << zTs() << "Atoms sorted along " << curve_name << " curve on rank " << vmpi::my_rank << std::endl;
+      zlog << zTs() << "Estimated cache misses per atom in exchange calculation (first " << model_atoms << " atoms):" << std::endl;
+      zlog << zTs() << "   32 KiB L1 cache: " << double(l1_misses_before)/double(model_atoms) << " -> " << double(l1_misses_after)/double(model_atoms) << std::endl;
+      zlog << zTs() << "   1 MiB L2 cache:  " << double(l2_misses_before)/double(model_atoms) << " -> " << double(l2_misses_after)/double(model_atoms) << std::endl;
+
+      return;
+
+   }
+
+} // end of namespace internal
+} // end of namespace create
@@ -0,0 +1,314 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+// Vampire headers
+#include "create.hpp"
+#include "errors.hpp"
+#include "exchange.hpp"
+#include "grains.hpp"
+#include "info.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// Internal create header
+#include "internal.hpp"
+
+//------------------------------------------------------------------------------
+//
+// Cache of generated structure
+//
+// The generated structure (atoms, neighbour lists and MPI communication tables)
+// is saved to a binary file for each process after creation, and loaded instead
+// of generating the structure in subsequent runs with the same structure
+// hash. The hash is calculated from all input parameters which define the
+// structure (create:, dimensions:, material:, unit-cell:, exchange: and mpi
+// input parameters and material files), the unit cell, the number of processes
+// and the code version, so that parameter sweeps varying only simulation
+// parameters can reuse the same structure.
+//
+// File layout (all data in native byte order):
+//
+//    | char[8] "VAMPSTR1" | scalars | arrays ... |
+//
+// where each array is stored as | uint64 number of elements | data |. The hash
+// is part of the file name, so that caches for different structures coexist.
+//
+//------------------------------------------------------------------------------
+
+namespace create{
+
+namespace{
+
+   // input parameters defining the generated structure
+   std::string structure_inputs;
+
+   // Fowler-Noll-Vo (FNV-1a) hash of string
+   uint64_t fnv1a_hash(const std::string& data){
+      uint64_t hash = 14695981039346656037ULL;
+      for(size_t i = 0; i < data.size(); i++){
+         hash ^= uint64_t(static_cast<unsigned char>(data[i]));
+         hash *= 1099511628211ULL;
+      }
+      return hash;
+   }
+
+   // write array to file
+   template <typename T> void write_array(std::ofstream& ofile, const std::vector<T>& data){
+      const uint64_t size = data.size();
+      ofile.write(reinterpret_cast<const char*>(&size), sizeof(uint64_t));
+      if(size > 0) ofile.write(reinterpret_cast<const char*>(&data[0]), size * sizeof(T));
+   }
+
+   // read array from file
+   template <typename T> bool read_array(std::ifstream& ifile, std::vector<T>& data){
+      uint64_t size = 0;
+      if(!ifile.read(reinterpret_cast<char*>(&size), sizeof(uint64_t))) return false;
+      data.resize(size);
+      if(size > 0) ifile.read(reinterpret_cast<char*>(&data[0]), size * sizeof(T));
+      return bool(ifile);
+   }
+
+   // write and read single value
+   template <typename T> void write_value(std::ofstream& ofile, const T value){
+      ofile.write(reinterpret_cast<const char*>(&value), sizeof(T));
+   }
+   template <typename T> bool read_value(std::ifstream& ifile, T& value){
+      return bool(ifile.read(reinterpret_cast<char*>(&value), sizeof(T)));
+   }
+
+   // write and read neighbour list
+   void write_list(std::ofstream& ofile, const neighbours::list_t& list){
+      write_array(ofile, list.start_index);
+      write_array(ofile, list.nn);
+      write_array(ofile, list.i);
+      write_array(ofile, list.image);
+      ofile.write(reinterpret_cast<const char*>(list.image_size), 3 * sizeof(double));
+   }
+   bool read_list(std::ifstream& ifile, neighbours::list_t& list){
+      return read_array(ifile, list.start_index) &&
+             read_array(ifile, list.nn) &&
+             read_array(ifile, list.i) &&
+             read_array(ifile, list.image) &&
+             bool(ifile.read(reinterpret_cast<char*>(list.image_size), 3 * sizeof(double)));
+   }
+
+   const char magic[8] = {'V','A','M','P','S','T','R','1'};
+
+}
+
+//------------------------------------------------------------------------------
+// Function to add input parameter to structure hash if it defines the structure
+//------------------------------------------------------------------------------
+void add_structure_input(std::string const key, std::string const word, std::string const value, std::string const unit){
+
+   // ignore parameters controlling the cache itself
+   if(word.compare(0, 15, "structure-cache") == 0) return;
+
+   if(key == "create" || key == "dimensions" || key == "material" || key == "unit-cell" || key == "exchange" || word == "mpi-mode" || word == "mpi-ppn" || word == "mpi-decomposition"){
+      structure_inputs += key + ":" + word + "=" + value + "!" + unit + "\n";
+   }
+
+   return;
+
+}
+
+namespace internal{
+
+   //---------------------------------------------------------------------------
+   // Function to calculate name of structure cache file for this process
+   //---------------------------------------------------------------------------
+   std::string structure_cache_filename(){
+
+      std::ostringstream data;
+      data << std::setprecision(17);
+
+      // code version and parallel configuration
+      data << "VAMPSTR1 " << vinfo::version() << " " << vinfo::githash() << "\n";
+      #ifdef MPICF
+         data << "parallel " << vmpi::num_processors << " " << vmpi::mpi_mode << "\n";
+      #else
+         data << "serial\n";
+      #endif
+
+      // input parameters
+      data << structure_inputs;
+
+      // unit cell
+      const unitcell::unit_cell_t& uc = cs::unit_cell;
+      data << uc.dimensions[0] << " " << uc.dimensions[1] << " " << uc.dimensions[2] << "\n";
+      for(unsigned int a = 0; a < uc.atom.size(); a++){
+         data << uc.atom[a].x << " " << uc.atom[a].y << " " << uc.atom[a].z << " " << uc.atom[a].mat << " "
+              << uc.atom[a].lc << " " << uc.atom[a].hc << " " << uc.atom[a].ni << " " << uc.atom[a].nm << "\n";
+      }
+      for(unsigned int i = 0; i < uc.bilinear.interaction.size(); i++){
+         const unitcell::interaction_t& t = uc.bilinear.interaction[i];
+         data << t.i << " " << t.j << " " << t.dx << " " << t.dy << " " << t.dz << "\n";
+      }
+      for(unsigned int i = 0; i < uc.biquadratic.interaction.size(); i++){
+         const unitcell::interaction_t& t = uc.biquadratic.interaction[i];
+         data << t.i << " " << t.j << " " << t.dx << " " << t.dy << " " << t.dz << "\n";
+      }
+
+      std::ostringstream filename;
+      filename << create::internal::structure_cache_directory << "/structure-" << std::hex << std::setw(16)
+               << std::setfill('0') << fnv1a_hash(data.str()) << std::dec << "-" << vmpi::my_rank << ".cache";
+
+      return filename.str();
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to load structure from cache file if present on all processes
+   //---------------------------------------------------------------------------
+   bool load_structure_cache(std::vector<cs::catom_t>& catom_array, neighbours::list_t& bilinear, neighbours::list_t& biquadratic){
+
+      if(!create::internal::structure_cache) return false;
+
+      const std::string filename = structure_cache_filename();
+
+      std::ifstream ifile(filename.c_str(), std::ios::binary);
+
+      // check for valid file header
+      char file_magic[8] = {0,0,0,0,0,0,0,0};
+      int found = bool(ifile.read(file_magic, 8)) && std::string(file_magic, 8) == std::string(magic, 8);
+
+      // only load cache if all processes have a valid file
+      #ifdef MPICF
+         MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+      #endif
+
+      if(!found){
+         zlog << zTs() << "No structure cache file found (" << filename << "), generating structure" << std::endl;
+         return false;
+      }
+
+      zlog << zTs() << "Loading generated structure from cache file " << filename << std::endl;
+
+      bool success = true;
+
+      // scalars
+      int64_t num_grains = 0;
+      int64_t non_filler = 0;
+      int64_t local_cells[3] = {0,0,0};
+      int64_t mpi_atoms[3] = {0,0,0};
+      double mpi_dimensions[6] = {0.0,0.0,0.0,0.0,0.0,0.0};
+      success = success && read_value(ifile, num_grains) && read_value(ifile, non_filler);
+      for(int i = 0; i < 3; i++) success = success && read_value(ifile, local_cells[i]);
+      for(int i = 0; i < 3; i++) success = success && read_value(ifile, mpi_atoms[i]);
+      for(int i = 0; i < 6; i++) success = success && read_value(ifile, mpi_dimensions[i]);
+
+      // atoms and neighbour lists
+      success = success && read_array(ifile, catom_array);
+      success = success && read_list(ifile, bilinear);
+      if(exchange::biquadratic) success = success && read_list(ifile, biquadratic);
+      success = success && read_array(ifile, cs::non_magnetic_atoms_array);
+
+      // MPI communication tables
+      #ifdef MPICF
+         success = success && read_array(ifile, vmpi::recv_num_array);
+         success = success && read_array(ifile, vmpi::send_num_array);
+         success = success && read_array(ifile, vmpi::recv_start_index_array);
+         success = success && read_array(ifile, vmpi::send_start_index_array);
+         success = success && read_array(ifile, vmpi::recv_atom_translation_array);
+         success = success && read_array(ifile, vmpi::send_atom_translation_array);
+         vmpi::recv_spin_data_array.resize(3 * vmpi::recv_atom_translation_array.size());
+         vmpi::send_spin_data_array.resize(3 * vmpi::send_atom_translation_array.size());
+      #endif
+
+      // a truncated or corrupt file cannot be recovered from as other processes may already be loaded
+      if(!success){
+         terminaltextcolor(RED);
+         std::cerr << "Error: Structure cache file " << filename << " is corrupt. Delete the file and try again. Exiting." << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error: Structure cache file " << filename << " is corrupt. Delete the file and try again. Exiting." << std::endl;
+         err::vexit();
+      }
+
+      grains::num_grains = num_grains;
+      create::num_total_atoms_non_filler = non_filler;
+      for(int i = 0; i < 3; i++) cs::local_num_unit_cells[i] = local_cells[i];
+      vmpi::num_core_atoms = mpi_atoms[0];
+      vmpi::num_bdry_atoms = mpi_atoms[1];
+      vmpi::num_halo_atoms = mpi_atoms[2];
+      for(int i = 0; i < 3; i++){
+         vmpi::min_dimensions[i] = mpi_dimensions[i];
+         vmpi::max_dimensions[i] = mpi_dimensions[3+i];
+      }
+
+      std::cout << "Loaded generated structure from cache" << std::endl;
+      zlog << zTs() << "\tLoaded " << catom_array.size() << " atoms and " << bilinear.nn.size() << " interactions from structure cache" << std::endl;
+
+      return true;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Function to save generated structure to cache file
+   //---------------------------------------------------------------------------
+   void save_structure_cache(const std::vector<cs::catom_t>& catom_array, const neighbours::list_t& bilinear, const neighbours::list_t& biquadratic){
+
+      if(!create::internal::structure_cache) return;
+
+      const std::string filename = structure_cache_filename();
+      const std::string tmpfilename = filename + ".tmp";
+
+      std::ofstream ofile(tmpfilename.c_str(), std::ios::binary);
+
+      ofile.write(magic, 8);
+
+      // scalars
+      write_value(ofile, int64_t(grains::num_grains));
+      write_value(ofile, int64_t(create::num_total_atoms_non_filler));
+      for(int i = 0; i < 3; i++) write_value(ofile, int64_t(cs::local_num_unit_cells[i]));
+      write_value(ofile, int64_t(vmpi::num_core_atoms));
+      write_value(ofile, int64_t(vmpi::num_bdry_atoms));
+      write_value(ofile, int64_t(vmpi::num_halo_atoms));
+      for(int i = 0; i < 3; i++) write_value(ofile, vmpi::min_dimensions[i]);
+      for(int i = 0; i < 3; i++) write_value(ofile, vmpi::max_dimensions[i]);
+
+      // atoms and neighbour lists
+      write_array(ofile, catom_array);
+      write_list(ofile, bilinear);
+      if(exchange::biquadratic) write_list(ofile, biquadratic);
+      write_array(ofile, cs::non_magnetic_atoms_array);
+
+      // MPI communication tables
+      #ifdef MPICF
+         write_array(ofile, vmpi::recv_num_array);
+         write_array(ofile, vmpi::send_num_array);
+         write_array(ofile, vmpi::recv_start_index_array);
+         write_array(ofile, vmpi::send_start_index_array);
+         write_array(ofile, vmpi::recv_atom_translation_array);
+         write_array(ofile, vmpi::send_atom_translation_array);
+      #endif
+
+      ofile.close();
+
+      // replace any existing file only once complete (failure to save cache is not fatal)
+      if(!ofile || std::rename(tmpfilename.c_str(), filename.c_str()) != 0){
+         std::remove(tmpfilename.c_str());
+         zlog << zTs() << "Warning: Unable to write structure cache file " << filename << std::endl;
+         return;
+      }
+
+      zlog << zTs() << "Saved generated structure to cache file " << filename << std::endl;
+
+      return;
+
+   }
+
+} // end of namespace internal
+} // end of namespace create
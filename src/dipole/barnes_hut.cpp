@@ -0,0 +1,903 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Vampire headers
+#include "dipole.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+#include "material.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+// alias interal dipole namespace for brevity
+namespace dp = dipole::internal;
+
+namespace dipole{
+
+namespace internal{
+
+   const int max_sources_in_leaf = 32; // maximum number of sources in leaf nodes
+   const int max_tree_depth = 24; // maximum depth of tree (for coincident sources)
+
+   //------------------------------------------------------------------------
+   // Function to recursively divide a node of the octree into octants
+   //------------------------------------------------------------------------
+   void subdivide_node(octree_t& octree, const int node, const double cx, const double cy, const double cz, const double half, const int depth){
+
+      const int start = octree.nodes[node].start;
+      const int end   = octree.nodes[node].end;
+
+      if(end - start <= max_sources_in_leaf || depth >= max_tree_depth) return;
+
+      // determine octant of each source
+      std::vector<int> octant(end - start);
+      int count[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      for(int s = start; s < end; s++){
+         const int id = octree.source[s];
+         const int o = (int(octree.x[id] >= cx) << 2) | (int(octree.y[id] >= cy) << 1) | int(octree.z[id] >= cz);
+         octant[s - start] = o;
+         count[o]++;
+      }
+
+      // sort sources by octant
+      int offset[8];
+      offset[0] = start;
+      for(int o = 1; o < 8; o++) offset[o] = offset[o-1] + count[o-1];
+
+      std::vector<int> sorted(end - start);
+      int next[8];
+      for(int o = 0; o < 8; o++) next[o] = offset[o];
+      for(int s = start; s < end; s++) sorted[next[octant[s - start]]++ - start] = octree.source[s];
+      for(int s = start; s < end; s++) octree.source[s] = sorted[s - start];
+
+      // create non-empty children consecutively
+      octree.nodes[node].first_child = octree.nodes.size();
+      for(int o = 0; o < 8; o++){
+         if(count[o] > 0){
+            tree_node_t child;
+            child.start = offset[o];
+            child.end = offset[o] + count[o];
+            child.first_child = 0;
+            child.num_children = 0;
+            octree.nodes.push_back(child);
+            octree.nodes[node].num_children++;
+         }
+      }
+
+      // subdivide children
+      int child = octree.nodes[node].first_child;
+      for(int o = 0; o < 8; o++){
+         if(count[o] > 0){
+            const double quarter = 0.5*half;
+            subdivide_node(octree, child, cx + ((o >> 2) & 1 ? quarter : -quarter),
+                                          cy + ((o >> 1) & 1 ? quarter : -quarter),
+                                          cz + ( o       & 1 ? quarter : -quarter), quarter, depth+1);
+            child++;
+         }
+      }
+
+      return;
+
+   }
+
+   //------------------------------------------------------------------------
+   // Function to build octree for a set of point dipole sources. Each node
+   // is centred on the sources weighted by their moment magnitude, and the
+   // size of a node includes the size of any sources which are themselves
+   // nodes of a tree on another processor. Positions are copied in tree order.
+   //------------------------------------------------------------------------
+   void build_octree(octree_t& octree,
+                     const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z,
+                     const std::vector<double>& weight, const std::vector<double>& size){
+
+      const int num_sources = x.size();
+
+      octree.nodes.resize(0);
+      octree.source.resize(num_sources);
+      octree.x = x;
+      octree.y = y;
+      octree.z = z;
+      for(int s = 0; s < num_sources; s++) octree.source[s] = s;
+
+      if(num_sources > 0){
+
+         // determine bounding cube of sources
+         double min[3] = { x[0], y[0], z[0] };
+         double max[3] = { x[0], y[0], z[0] };
+         for(int s = 0; s < num_sources; s++){
+            const double r[3] = { x[s], y[s], z[s] };
+            for(int i = 0; i < 3; i++){
+               if(r[i] < min[i]) min[i] = r[i];
+               if(r[i] > max[i]) max[i] = r[i];
+            }
+         }
+         double half = 0.0;
+         for(int i = 0; i < 3; i++) if(0.5*(max[i] - min[i]) > half) half = 0.5*(max[i] - min[i]);
+
+         tree_node_t root;
+         root.start = 0;
+         root.end = num_sources;
+         root.first_child = 0;
+         root.num_children = 0;
+         octree.nodes.push_back(root);
+
+         subdivide_node(octree, 0, 0.5*(min[0] + max[0]), 0.5*(min[1] + max[1]), 0.5*(min[2] + max[2]), half*(1.0 + 1.0e-9) + 1.0e-9, 0);
+
+      }
+
+      // calculate centre and size of each node
+      for(unsigned int n = 0; n < octree.nodes.size(); n++){
+
+         tree_node_t& node = octree.nodes[n];
+
+         double w = 0.0;
+         double cx = 0.0, cy = 0.0, cz = 0.0;
+         double gx = 0.0, gy = 0.0, gz = 0.0; // geometric centre for nodes with no moment
+         for(int s = node.start; s < node.end; s++){
+            const int id = octree.source[s];
+            w  += weight[id];
+            cx += weight[id]*x[id];
+            cy += weight[id]*y[id];
+            cz += weight[id]*z[id];
+            gx += x[id];
+            gy += y[id];
+            gz += z[id];
+         }
+         if(w > 0.0){
+            node.x = cx/w;
+            node.y = cy/w;
+            node.z = cz/w;
+         }
+         else{
+            const double n_sources = double(node.end - node.start);
+            node.x = gx/n_sources;
+            node.y = gy/n_sources;
+            node.z = gz/n_sources;
+         }
+
+         node.size = 0.0;
+         for(int s = node.start; s < node.end; s++){
+            const int id = octree.source[s];
+            const double dx = x[id] - node.x;
+            const double dy = y[id] - node.y;
+            const double dz = z[id] - node.z;
+            const double r = sqrt(dx*dx + dy*dy + dz*dz) + size[id];
+            if(r > node.size) node.size = r;
+         }
+
+         node.mx = 0.0;
+         node.my = 0.0;
+         node.mz = 0.0;
+
+      }
+
+      // copy coordinates to tree order
+      for(int s = 0; s < num_sources; s++){
+         octree.x[s] = x[octree.source[s]];
+         octree.y[s] = y[octree.source[s]];
+         octree.z[s] = z[octree.source[s]];
+      }
+
+      octree.mx.resize(num_sources, 0.0);
+      octree.my.resize(num_sources, 0.0);
+      octree.mz.resize(num_sources, 0.0);
+
+      return;
+
+   }
+
+   // index of symmetric pair of components (b,c) in second moment
+   const int pair_index[3][3] = { {0, 1, 2}, {1, 3, 4}, {2, 4, 5} };
+
+   //------------------------------------------------------------------------
+   // Function to add moments of a source or child node displaced by d from
+   // the node centre to the moments of the node
+   //------------------------------------------------------------------------
+   inline void add_displaced_moments(const double m[3], const double* q, const double* s, const double d[3],
+                                     double M[3], double Q[9], double S[18]){
+
+      for(int a = 0; a < 3; a++){
+         M[a] += m[a];
+         for(int b = 0; b < 3; b++) Q[3*a+b] += m[a]*d[b];
+         for(int b = 0; b < 3; b++){
+            for(int c = b; c < 3; c++) S[6*a+pair_index[b][c]] += m[a]*d[b]*d[c];
+         }
+      }
+
+      // sources which have their own distribution of moments
+      if(q != NULL){
+         for(int a = 0; a < 3; a++){
+            for(int b = 0; b < 3; b++) Q[3*a+b] += q[3*a+b];
+            for(int b = 0; b < 3; b++){
+               for(int c = b; c < 3; c++) S[6*a+pair_index[b][c]] += s[6*a+pair_index[b][c]] + q[3*a+b]*d[c] + q[3*a+c]*d[b];
+            }
+         }
+      }
+
+      return;
+
+   }
+
+   //------------------------------------------------------------------------
+   // Function to calculate total moment of each node from source moments,
+   // and the first (q) and second (s) moments of the distribution of
+   // moments about the node centre (children are always stored after their
+   // parent)
+   //------------------------------------------------------------------------
+   void calculate_node_moments(octree_t& octree){
+
+      for(int n = int(octree.nodes.size()) - 1; n >= 0; n--){
+
+         tree_node_t& node = octree.nodes[n];
+
+         double M[3] = {0.0, 0.0, 0.0};
+         double Q[9] = {0.0};
+         double S[18] = {0.0};
+
+         if(node.num_children == 0){
+            for(int s = node.start; s < node.end; s++){
+               const double m[3] = { octree.mx[s], octree.my[s], octree.mz[s] };
+               const double d[3] = { octree.x[s] - node.x, octree.y[s] - node.y, octree.z[s] - node.z };
+               if(octree.q.empty()) add_displaced_moments(m, NULL, NULL, d, M, Q, S);
+               else add_displaced_moments(m, &octree.q[9*s], &octree.s[18*s], d, M, Q, S);
+            }
+         }
+         else{
+            for(int c = node.first_child; c < node.first_child + node.num_children; c++){
+               const tree_node_t& child = octree.nodes[c];
+               const double m[3] = { child.mx, child.my, child.mz };
+               const double d[3] = { child.x - node.x, child.y - node.y, child.z - node.z };
+               add_displaced_moments(m, child.q, child.s, d, M, Q, S);
+            }
+         }
+
+         node.mx = M[0];
+         node.my = M[1];
+         node.mz = M[2];
+         for(int c = 0; c < 9; c++) node.q[c] = Q[c];
+         for(int c = 0; c < 18; c++) node.s[c] = S[c];
+
+      }
+
+      return;
+
+   }
+
+   //------------------------------------------------------------------------
+   // Function to add the field at separation r from the first (q) and second
+   // (s) moments of a distribution of dipoles about its centre, given by the
+   // Taylor expansion of the dipole tensor T_ij = d_i d_j (1/r)
+   //
+   //    B_i = d_ijk(1/r) q_jk + 1/2 d_ijkl(1/r) s_jkl
+   //------------------------------------------------------------------------
+   inline void add_moment_correction_field(const double rx, const double ry, const double rz, const double q[9], const double s[18],
+                                           double& bx, double& by, double& bz){
+
+      const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz); //Reciprocal of the distance
+
+      const double e[3] = { rx*rij, ry*rij, rz*rij };
+
+      const double rij4 = rij*rij*rij*rij;
+      const double rij5 = rij4*rij;
+
+      // first moment: e.q, q.e, trace(q) and e.q.e
+      double eq[3], qe[3];
+      for(int i = 0; i < 3; i++){
+         eq[i] = e[0]*q[i] + e[1]*q[3+i] + e[2]*q[6+i];
+         qe[i] = q[3*i]*e[0] + q[3*i+1]*e[1] + q[3*i+2]*e[2];
+      }
+      const double trace = q[0] + q[4] + q[8];
+      const double eqe = e[0]*qe[0] + e[1]*qe[1] + e[2]*qe[2];
+
+      // second moment contractions, where s_j is a symmetric matrix for each j
+      double se[3][3]; // s_j.e
+      for(int j = 0; j < 3; j++){
+         const double* sj = &s[6*j];
+         se[j][0] = sj[0]*e[0] + sj[1]*e[1] + sj[2]*e[2];
+         se[j][1] = sj[1]*e[0] + sj[3]*e[1] + sj[4]*e[2];
+         se[j][2] = sj[2]*e[0] + sj[4]*e[1] + sj[5]*e[2];
+      }
+      double p[3], u[3], x[3], y[3];
+      for(int j = 0; j < 3; j++){
+         p[j] = e[0]*se[j][0] + e[1]*se[j][1] + e[2]*se[j][2]; // e.s_j.e
+         u[j] = e[0]*se[0][j] + e[1]*se[1][j] + e[2]*se[2][j]; // sum_k e_k (s_k.e)_j
+         x[j] = s[6*j+0] + s[6*j+3] + s[6*j+5]; // trace(s_j)
+      }
+      y[0] = s[0]  + s[7]  + s[14]; // sum_k (s_k)_jk
+      y[1] = s[1]  + s[9]  + s[16];
+      y[2] = s[2]  + s[10] + s[17];
+      const double eee = e[0]*p[0] + e[1]*p[1] + e[2]*p[2];
+      const double v = se[0][0] + se[1][1] + se[2][2];
+      const double w = e[0]*x[0] + e[1]*x[1] + e[2]*x[2];
+
+      const double b[3] = { 3.0*(eq[0] + qe[0] + e[0]*(trace - 5.0*eqe))*rij4 + 0.5*(105.0*e[0]*eee - 15.0*(p[0] + 2.0*u[0] + e[0]*(2.0*v + w)) + 3.0*(x[0] + 2.0*y[0]))*rij5,
+                            3.0*(eq[1] + qe[1] + e[1]*(trace - 5.0*eqe))*rij4 + 0.5*(105.0*e[1]*eee - 15.0*(p[1] + 2.0*u[1] + e[1]*(2.0*v + w)) + 3.0*(x[1] + 2.0*y[1]))*rij5,
+                            3.0*(eq[2] + qe[2] + e[2]*(trace - 5.0*eqe))*rij4 + 0.5*(105.0*e[2]*eee - 15.0*(p[2] + 2.0*u[2] + e[2]*(2.0*v + w)) + 3.0*(x[2] + 2.0*y[2]))*rij5 };
+
+      bx += b[0];
+      by += b[1];
+      bz += b[2];
+
+      return;
+
+   }
+
+   //------------------------------------------------------------------------
+   // Function to initialise atomistic Barnes-Hut dipole solver.
+   //
+   // Each processor builds an octree of its local atoms. In parallel, each
+   // processor sends every other processor the nodes of its tree which
+   // satisfy the opening criterion for the whole domain of the receiving
+   // processor, and individual atoms otherwise (a locally essential tree).
+   // Only these sources are stored, and since the atoms do not move the
+   // lists are calculated once and only moments are exchanged at each update.
+   //------------------------------------------------------------------------
+   void initialize_barnes_hut_solver(int num_atoms,                      // number of atoms (only correct in serial)
+                                     std::vector<double>& x_coord_array, // atomic corrdinates (angstroms)
+                                     std::vector<double>& y_coord_array,
+                                     std::vector<double>& z_coord_array,
+                                     std::vector<double>& moments_array, // atomistic magnetic moments (bohr magnetons)
+                                     std::vector<int>& mat_id_array){    // atom material ID
+
+      zlog << zTs() << "Initialising Barnes-Hut dipole field calculation with opening angle " << dp::opening_angle << std::endl;
+
+      // instantiate timer
+      vutil::vtimer_t timer;
+      timer.start();
+
+      // calculate number of local atoms excluding halo
+      #ifdef MPICF
+         dp::num_local_atoms = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+      #else
+         dp::num_local_atoms = num_atoms;
+      #endif
+
+      // Zero all moments for non-magnetic materials by using copy of moments array
+      dp::sm.resize(dp::num_local_atoms);
+      for (int atom = 0; atom < dp::num_local_atoms; atom++){
+         int mat = mat_id_array[atom]; // get atomic material ID
+         if(mp::material[mat].non_magnetic != 0) dp::sm[atom] = 0.0; // set local moment to zero
+         else dp::sm[atom] = moments_array[atom];
+      }
+
+      // source positions, weights and sizes (local atoms followed by sources from other processors)
+      std::vector<double> x(x_coord_array.begin(), x_coord_array.begin() + dp::num_local_atoms);
+      std::vector<double> y(y_coord_array.begin(), y_coord_array.begin() + dp::num_local_atoms);
+      std::vector<double> z(z_coord_array.begin(), z_coord_array.begin() + dp::num_local_atoms);
+      std::vector<double> weight = dp::sm;
+      std::vector<double> size(dp::num_local_atoms, 0.0);
+
+      #ifdef MPICF
+
+         // build tree of local atoms
+         build_octree(dp::local_tree, x, y, z, weight, size);
+
+         // calculate bounding box of local atoms on each processor
+         std::vector<double> box(6, 0.0);
+         if(dp::num_local_atoms > 0){
+            box[0] = box[3] = x[0];
+            box[1] = box[4] = y[0];
+            box[2] = box[5] = z[0];
+         }
+         for(int atom = 0; atom < dp::num_local_atoms; atom++){
+            box[0] = std::min(box[0], x[atom]); box[3] = std::max(box[3], x[atom]);
+            box[1] = std::min(box[1], y[atom]); box[4] = std::max(box[4], y[atom]);
+            box[2] = std::min(box[2], z[atom]); box[5] = std::max(box[5], z[atom]);
+         }
+         std::vector<double> boxes(6*vmpi::num_processors);
+         MPI_Allgather(&box[0], 6, MPI_DOUBLE, &boxes[0], 6, MPI_DOUBLE, MPI_COMM_WORLD);
+
+         // determine sources to send to each processor
+         dp::tree_send_list.resize(0);
+         dp::tree_send_counts.assign(vmpi::num_processors, 0);
+         dp::tree_send_displacements.assign(vmpi::num_processors, 0);
+
+         std::vector<int> stack;
+         for(int p = 0; p < vmpi::num_processors; p++){
+
+            dp::tree_send_displacements[p] = dp::tree_send_list.size();
+            if(p == vmpi::my_rank || dp::local_tree.nodes.size() == 0) continue;
+
+            const double* b = &boxes[6*p];
+
+            stack.push_back(0);
+            while(stack.size() > 0){
+
+               const int n = stack.back();
+               stack.pop_back();
+               const tree_node_t& node = dp::local_tree.nodes[n];
+
+               // minimum distance from node centre to domain of processor p
+               const double dx = std::max(0.0, std::max(b[0] - node.x, node.x - b[3]));
+               const double dy = std::max(0.0, std::max(b[1] - node.y, node.y - b[4]));
+               const double dz = std::max(0.0, std::max(b[2] - node.z, node.z - b[5]));
+               const double d = sqrt(dx*dx + dy*dy + dz*dz);
+
+               if(node.size < dp::opening_angle*d) dp::tree_send_list.push_back(n);
+               else if(node.num_children == 0){
+                  for(int s = node.start; s < node.end; s++) dp::tree_send_list.push_back(-1-s);
+               }
+               else{
+                  for(int c = node.first_child; c < node.first_child + node.num_children; c++) stack.push_back(c);
+               }
+
+            }
+
+            dp::tree_send_counts[p] = dp::tree_send_list.size() - dp::tree_send_displacements[p];
+
+         }
+
+         // exchange number of sources
+         dp::tree_recv_counts.resize(vmpi::num_processors);
+         dp::tree_recv_displacements.resize(vmpi::num_processors);
+         MPI_Alltoall(&dp::tree_send_counts[0], 1, MPI_INT, &dp::tree_recv_counts[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+         int num_remote = 0;
+         for(int p = 0; p < vmpi::num_processors; p++){
+            dp::tree_recv_displacements[p] = num_remote;
+            num_remote += dp::tree_recv_counts[p];
+         }
+
+         // pack positions, weights and sizes of sources
+         std::vector<double> send_buffer(5*dp::tree_send_list.size());
+         for(unsigned int i = 0; i < dp::tree_send_list.size(); i++){
+            const int n = dp::tree_send_list[i];
+            if(n >= 0){
+               const tree_node_t& node = dp::local_tree.nodes[n];
+               double w = 0.0;
+               for(int s = node.start; s < node.end; s++) w += weight[dp::local_tree.source[s]];
+               send_buffer[5*i+0] = node.x;
+               send_buffer[5*i+1] = node.y;
+               send_buffer[5*i+2] = node.z;
+               send_buffer[5*i+3] = w;
+               send_buffer[5*i+4] = node.size;
+            }
+            else{
+               const int s = -1-n;
+               send_buffer[5*i+0] = dp::local_tree.x[s];
+               send_buffer[5*i+1] = dp::local_tree.y[s];
+               send_buffer[5*i+2] = dp::local_tree.z[s];
+               send_buffer[5*i+3] = weight[dp::local_tree.source[s]];
+               send_buffer[5*i+4] = 0.0;
+            }
+         }
+
+         std::vector<int> send_counts(vmpi::num_processors), send_displacements(vmpi::num_processors);
+         std::vector<int> recv_counts(vmpi::num_processors), recv_displacements(vmpi::num_processors);
+         for(int p = 0; p < vmpi::num_processors; p++){
+            send_counts[p] = 5*dp::tree_send_counts[p];
+            send_displacements[p] = 5*dp::tree_send_displacements[p];
+            recv_counts[p] = 5*dp::tree_recv_counts[p];
+            recv_displacements[p] = 5*dp::tree_recv_displacements[p];
+         }
+
+         std::vector<double> recv_buffer(5*num_remote + 1);
+         MPI_Alltoallv(&send_buffer[0], &send_counts[0], &send_displacements[0], MPI_DOUBLE,
+                       &recv_buffer[0], &recv_counts[0], &recv_displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
+
+         // add remote sources to list
+         for(int i = 0; i < num_remote; i++){
+            x.push_back(recv_buffer[5*i+0]);
+            y.push_back(recv_buffer[5*i+1]);
+            z.push_back(recv_buffer[5*i+2]);
+            weight.push_back(recv_buffer[5*i+3]);
+            size.push_back(recv_buffer[5*i+4]);
+         }
+
+      #endif
+
+      // build tree of all sources
+      build_octree(dp::tree, x, y, z, weight, size);
+      if(int(x.size()) > dp::num_local_atoms){
+         dp::tree.q.assign(9*x.size(), 0.0);
+         dp::tree.s.assign(18*x.size(), 0.0);
+      }
+
+      // determine leaves containing local atoms
+      dp::tree_target_leaves.resize(0);
+      for(unsigned int n = 0; n < dp::tree.nodes.size(); n++){
+         if(dp::tree.nodes[n].num_children == 0){
+            for(int s = dp::tree.nodes[n].start; s < dp::tree.nodes[n].end; s++){
+               if(dp::tree.source[s] < dp::num_local_atoms){
+                  dp::tree_target_leaves.push_back(n);
+                  break;
+               }
+            }
+         }
+      }
+
+      timer.stop();
+
+      // Calculate memory requirements and inform user
+      const double mem = double(dp::tree.x.size() + dp::local_tree.x.size())*(6.0*sizeof(double) + sizeof(int)) + double(dp::tree.q.size() + dp::tree.s.size())*sizeof(double) +
+                         double(dp::tree.nodes.size() + dp::local_tree.nodes.size())*sizeof(tree_node_t) +
+                         double(dp::tree_send_list.size())*sizeof(int);
+      zlog << zTs() << "Barnes-Hut tree contains " << dp::num_local_atoms << " local atoms and " << dp::tree.x.size() - dp::num_local_atoms << " sources from other processors in " << dp::tree.nodes.size() << " nodes" << std::endl;
+      zlog << zTs() << "Barnes-Hut dipole field calculation requires " << mem/1.0e6 << " MB of RAM" << std::endl;
+      std::cout     << "Barnes-Hut dipole field calculation requires " << mem/1.0e6 << " MB of RAM" << std::endl;
+      zlog << zTs() << "Construction of Barnes-Hut tree complete. Time taken: " << timer.elapsed_time() << " s" << std::endl;
+
+      // If enabled, output calculated atomistic dipole field coordinates and moments (passing local values)
+      if(dp::output_atomistic_dipole_field) output_atomistic_coordinates(num_atoms, x_coord_array, y_coord_array, z_coord_array, dp::sm);
+
+      return;
+
+   }
+
+   //------------------------------------------------------------------------
+   // Function to calculate atomistic dipole field using the Barnes-Hut tree.
+   //
+   // The tree is traversed once for each leaf containing local atoms. Nodes
+   // which are far from the leaf compared to their size are approximated as
+   // a single dipole at the node centre plus corrections for the first and
+   // second moments of the distribution of moments in the node, and otherwise
+   // the node is opened.
+   // Sources in opened leaves are summed directly.
+   //------------------------------------------------------------------------
+   void calculate_barnes_hut_dipole_field(std::vector<double>& x_spin_array, // atomic spin directions
+                                          std::vector<double>& y_spin_array,
+                                          std::vector<double>& z_spin_array){
+
+      const double prefactor = 0.9274009994; // mu_o_4pi * muB / Angstrom^3 = 1.0e-7 * 9.274009994e-24 / 1.0e-30 = 0.9274009994
+
+      const int num_local_atoms = dp::num_local_atoms;
+      const double theta = dp::opening_angle;
+
+      octree_t& tree = dp::tree;
+
+      #ifdef MPICF
+
+         // calculate moments of local tree
+         for(int s = 0; s < num_local_atoms; s++){
+            const int atom = dp::local_tree.source[s];
+            dp::local_tree.mx[s] = x_spin_array[atom]*dp::sm[atom];
+            dp::local_tree.my[s] = y_spin_array[atom]*dp::sm[atom];
+            dp::local_tree.mz[s] = z_spin_array[atom]*dp::sm[atom];
+         }
+         calculate_node_moments(dp::local_tree);
+
+         // pack moments, first and second moments of sources needed by other processors
+         std::vector<double> send_buffer(30*dp::tree_send_list.size() + 1, 0.0);
+         for(unsigned int i = 0; i < dp::tree_send_list.size(); i++){
+            const int n = dp::tree_send_list[i];
+            if(n >= 0){
+               const tree_node_t& node = dp::local_tree.nodes[n];
+               send_buffer[30*i+0] = node.mx;
+               send_buffer[30*i+1] = node.my;
+               send_buffer[30*i+2] = node.mz;
+               for(int c = 0; c < 9; c++) send_buffer[30*i+3+c] = node.q[c];
+               for(int c = 0; c < 18; c++) send_buffer[30*i+12+c] = node.s[c];
+            }
+            else{
+               send_buffer[30*i+0] = dp::local_tree.mx[-1-n];
+               send_buffer[30*i+1] = dp::local_tree.my[-1-n];
+               send_buffer[30*i+2] = dp::local_tree.mz[-1-n];
+            }
+         }
+
+         std::vector<int> send_counts(vmpi::num_processors), send_displacements(vmpi::num_processors);
+         std::vector<int> recv_counts(vmpi::num_processors), recv_displacements(vmpi::num_processors);
+         for(int p = 0; p < vmpi::num_processors; p++){
+            send_counts[p] = 30*dp::tree_send_counts[p];
+            send_displacements[p] = 30*dp::tree_send_displacements[p];
+            recv_counts[p] = 30*dp::tree_recv_counts[p];
+            recv_displacements[p] = 30*dp::tree_recv_displacements[p];
+         }
+
+         std::vector<double> recv_buffer(30*(tree.x.size() - num_local_atoms) + 1);
+         MPI_Alltoallv(&send_buffer[0], &send_counts[0], &send_displacements[0], MPI_DOUBLE,
+                       &recv_buffer[0], &recv_counts[0], &recv_displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
+
+      #endif
+
+      // set moments of all sources
+      for(unsigned int s = 0; s < tree.x.size(); s++){
+         const int id = tree.source[s];
+         if(id < num_local_atoms){
+            tree.mx[s] = x_spin_array[id]*dp::sm[id];
+            tree.my[s] = y_spin_array[id]*dp::sm[id];
+            tree.mz[s] = z_spin_array[id]*dp::sm[id];
+         }
+         #ifdef MPICF
+         else{
+            const int r = id - num_local_atoms;
+            tree.mx[s] = recv_buffer[30*r+0];
+            tree.my[s] = recv_buffer[30*r+1];
+            tree.mz[s] = recv_buffer[30*r+2];
+            for(int c = 0; c < 9; c++) tree.q[9*s+c] = recv_buffer[30*r+3+c];
+            for(int c = 0; c < 18; c++) tree.s[18*s+c] = recv_buffer[30*r+12+c];
+         }
+         #endif
+      }
+      calculate_node_moments(tree);
+
+      // temporary arrays for field at each source in tree order
+      std::vector<double> bx(tree.x.size(), 0.0);
+      std::vector<double> by(tree.x.size(), 0.0);
+      std::vector<double> bz(tree.x.size(), 0.0);
+
+      std::vector<int> stack;
+
+      //------------------------------------------------------------------------
+      // Loop over all leaves containing local atoms
+      //------------------------------------------------------------------------
+      for(unsigned int l = 0; l < dp::tree_target_leaves.size(); l++){
+
+         const tree_node_t& leaf = tree.nodes[dp::tree_target_leaves[l]];
+
+         stack.push_back(0);
+         while(stack.size() > 0){
+
+            const int n = stack.back();
+            stack.pop_back();
+            const tree_node_t& node = tree.nodes[n];
+
+            // distance between node and leaf centres
+            const double dx = node.x - leaf.x;
+            const double dy = node.y - leaf.y;
+            const double dz = node.z - leaf.z;
+            const double d = sqrt(dx*dx + dy*dy + dz*dz);
+
+            //------------------------------------------------------------------
+            // approximate node as a single dipole
+            //------------------------------------------------------------------
+            if(node.size < theta*(d - leaf.size)){
+
+               for(int t = leaf.start; t < leaf.end; t++){
+                  if(tree.source[t] >= num_local_atoms) continue;
+
+                  // calculate position vector i -> j
+                  const double rx = node.x - tree.x[t];
+                  const double ry = node.y - tree.y[t];
+                  const double rz = node.z - tree.z[t];
+
+                  // calculate distance between atom and node
+                  const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz); //Reciprocal of the distance
+
+                  // calculate unit vector from i -> j
+                  const double ex = rx*rij;
+                  const double ey = ry*rij;
+                  const double ez = rz*rij;
+
+                  // calculate cube of distance for normalisation
+                  const double rij3 = ( rij * rij * rij); // Angstroms
+
+                  // calculate r . m
+                  const double rdotm = ex*node.mx + ey*node.my + ez*node.mz;
+
+                  bx[t] += (3.0*ex*rdotm - node.mx) * rij3;
+                  by[t] += (3.0*ey*rdotm - node.my) * rij3;
+                  bz[t] += (3.0*ez*rdotm - node.mz) * rij3;
+
+                  // add correction for distribution of moments in node
+                  add_moment_correction_field(rx, ry, rz, node.q, node.s, bx[t], by[t], bz[t]);
+
+               }
+
+            }
+            //------------------------------------------------------------------
+            // sum over all sources in leaf directly
+            //------------------------------------------------------------------
+            else if(node.num_children == 0){
+
+               for(int t = leaf.start; t < leaf.end; t++){
+                  if(tree.source[t] >= num_local_atoms) continue;
+
+                  const double xi = tree.x[t];
+                  const double yi = tree.y[t];
+                  const double zi = tree.z[t];
+
+                  double bxi = 0.0;
+                  double byi = 0.0;
+                  double bzi = 0.0;
+
+                  for(int s = node.start; s < node.end; s++){
+                     if(s == t) continue;
+
+                     // calculate net spin moment of atom j
+                     const double mxj = tree.mx[s];
+                     const double myj = tree.my[s];
+                     const double mzj = tree.mz[s];
+
+                     // calculate position vector i -> j
+                     const double rx = tree.x[s] - xi;
+                     const double ry = tree.y[s] - yi;
+                     const double rz = tree.z[s] - zi;
+
+                     // calculate distance between atoms
+                     const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz); //Reciprocal of the distance
+
+                     // calculate unit vector from i -> j
+                     const double ex = rx*rij;
+                     const double ey = ry*rij;
+                     const double ez = rz*rij;
+
+                     // calculate cube of distance for normalisation
+                     const double rij3 = ( rij * rij * rij); // Angstroms
+
+                     // calculate r . m
+                     const double rdotm = ex*mxj + ey*myj + ez*mzj;
+
+                     bxi += (3.0*ex*rdotm - mxj) * rij3;
+                     byi += (3.0*ey*rdotm - myj) * rij3;
+                     bzi += (3.0*ez*rdotm - mzj) * rij3;
+
+                  }
+
+                  // add correction for sources which are nodes on other processors
+                  if(!tree.q.empty()){
+                     for(int s = node.start; s < node.end; s++){
+                        if(tree.source[s] >= num_local_atoms) add_moment_correction_field(tree.x[s] - xi, tree.y[s] - yi, tree.z[s] - zi, &tree.q[9*s], &tree.s[18*s], bxi, byi, bzi);
+                     }
+                  }
+
+                  bx[t] += bxi;
+                  by[t] += byi;
+                  bz[t] += bzi;
+
+               }
+
+            }
+            //------------------------------------------------------------------
+            // open node
+            //------------------------------------------------------------------
+            else{
+               for(int c = node.first_child; c < node.first_child + node.num_children; c++) stack.push_back(c);
+            }
+
+         }
+
+      }
+
+      // save total dipole field to atomic field array
+      for(unsigned int s = 0; s < tree.x.size(); s++){
+         const int atom = tree.source[s];
+         if(atom < num_local_atoms){
+            dipole::atom_dipolar_field_array_x[atom] = prefactor * bx[s];
+            dipole::atom_dipolar_field_array_y[atom] = prefactor * by[s];
+            dipole::atom_dipolar_field_array_z[atom] = prefactor * bz[s];
+         }
+      }
+
+      if(dp::output_atomistic_dipole_field) output_atomistic_dipole_fields();
+
+      return;
+
+   }
+
+   //------------------------------------------------------------------------
+   // Function to compare the Barnes-Hut dipole field with the exact sum over
+   // all atoms for a sample of around 1000 atoms, and estimate the time for
+   // the exact sum over all atoms. Each processor sums the fields from its
+   // local atoms at all sample atoms, so no copy of the system is needed.
+   //------------------------------------------------------------------------
+   void check_barnes_hut_accuracy(){
+
+      const int num_local_atoms = dp::num_local_atoms;
+      const octree_t& tree = dp::tree;
+
+      // determine sample of local atoms
+      const double num_atoms = double(vmpi::all_reduce_sum(uint64_t(num_local_atoms)));
+      const int stride = std::max(1, int(num_atoms/1000.0));
+
+      std::vector<double> sample; // coordinates and field of sample atoms
+      for(unsigned int s = 0; s < tree.x.size(); s++){
+         const int atom = tree.source[s];
+         if(atom < num_local_atoms && atom % stride == 0){
+            sample.push_back(tree.x[s]);
+            sample.push_back(tree.y[s]);
+            sample.push_back(tree.z[s]);
+            sample.push_back(dipole::atom_dipolar_field_array_x[atom]);
+            sample.push_back(dipole::atom_dipolar_field_array_y[atom]);
+            sample.push_back(dipole::atom_dipolar_field_array_z[atom]);
+         }
+      }
+
+      // share sample with all processors
+      #ifdef MPICF
+         int local_size = sample.size();
+         std::vector<int> counts(vmpi::num_processors), displacements(vmpi::num_processors, 0);
+         MPI_Allgather(&local_size, 1, MPI_INT, &counts[0], 1, MPI_INT, MPI_COMM_WORLD);
+         for(int p = 1; p < vmpi::num_processors; p++) displacements[p] = displacements[p-1] + counts[p-1];
+         std::vector<double> all_samples(displacements[vmpi::num_processors-1] + counts[vmpi::num_processors-1]);
+         MPI_Allgatherv(sample.data(), local_size, MPI_DOUBLE, all_samples.data(), &counts[0], &displacements[0], MPI_DOUBLE, MPI_COMM_WORLD);
+         sample.swap(all_samples);
+      #endif
+      const int num_samples = sample.size()/6;
+
+      // calculate exact field at sample atoms from local atoms
+      vutil::vtimer_t timer;
+      timer.start();
+
+      std::vector<double> exact(3*num_samples, 0.0);
+      for(int i = 0; i < num_samples; i++){
+
+         const double xi = sample[6*i+0];
+         const double yi = sample[6*i+1];
+         const double zi = sample[6*i+2];
+
+         double bx = 0.0;
+         double by = 0.0;
+         double bz = 0.0;
+
+         for(unsigned int s = 0; s < tree.x.size(); s++){
+            if(tree.source[s] >= num_local_atoms) continue;
+
+            const double rx = tree.x[s] - xi;
+            const double ry = tree.y[s] - yi;
+            const double rz = tree.z[s] - zi;
+
+            const double r2 = rx*rx+ry*ry+rz*rz;
+            if(r2 < 1.0e-12) continue; // exclude self interaction
+
+            const double rij = 1.0/sqrt(r2); //Reciprocal of the distance
+
+            const double ex = rx*rij;
+            const double ey = ry*rij;
+            const double ez = rz*rij;
+
+            const double rij3 = ( rij * rij * rij); // Angstroms
+
+            const double rdotm = ex*tree.mx[s] + ey*tree.my[s] + ez*tree.mz[s];
+
+            bx += (3.0*ex*rdotm - tree.mx[s]) * rij3;
+            by += (3.0*ey*rdotm - tree.my[s]) * rij3;
+            bz += (3.0*ez*rdotm - tree.mz[s]) * rij3;
+
+         }
+
+         exact[3*i+0] = 0.9274009994 * bx;
+         exact[3*i+1] = 0.9274009994 * by;
+         exact[3*i+2] = 0.9274009994 * bz;
+
+      }
+
+      timer.stop();
+      double time = timer.elapsed_time();
+
+      #ifdef MPICF
+         MPI_Allreduce(MPI_IN_PLACE, exact.data(), 3*num_samples, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+         MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+      #endif
+
+      // calculate relative rms and maximum errors
+      double sum_sq_error = 0.0;
+      double sum_sq_field = 0.0;
+      double max_error = 0.0;
+      for(int i = 0; i < num_samples; i++){
+         double error = 0.0;
+         for(int c = 0; c < 3; c++){
+            const double delta = sample[6*i+3+c] - exact[3*i+c];
+            error += delta*delta;
+            sum_sq_field += exact[3*i+c]*exact[3*i+c];
+         }
+         sum_sq_error += error;
+         if(sqrt(error) > max_error) max_error = sqrt(error);
+      }
+
+      const double rms_error = sum_sq_field > 0.0 ? sqrt(sum_sq_error/sum_sq_field) : 0.0;
+      const double direct_time = num_samples > 0 ? time*num_atoms/double(num_samples) : 0.0;
+
+      zlog << zTs() << "Barnes-Hut dipole field relative rms error for " << num_samples << " sample atoms: " << rms_error << " (maximum error " << max_error << " T)" << std::endl;
+      zlog << zTs() << "Estimated time required for exact dipole sum over all atoms: " << direct_time << " s" << std::endl;
+
+      return;
+
+   }
+
+} // end of namespace internal
+} // end of namespace dipole
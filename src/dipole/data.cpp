@@ -25,6 +25,7 @@ namespace dipole{
    int update_time=-1; /// last update time
 
    bool activated=false;
+   bool per_move_update=false; /// flag to update cell fields after every accepted Monte Carlo move
 
    // define arrays for B-field
    std::vector < double > cells_field_array_x;
@@ -57,6 +58,7 @@ namespace dipole{
       bool output_atomistic_dipole_field = false; // flag to toggle output of atomic resolution dipole field
 
       int update_time=-1; /// last update time
+      bool asynchronous_update = false; /// flag to overlap reduction of cell magnetisation with time steps (field lags one update)
 
       // solver to be used for dipole method
       dipole::internal::solver_t solver = dipole::internal::tensor; // default is tensor method
@@ -74,6 +76,7 @@ namespace dipole{
       int num_atoms;
       std::vector < int > atom_type_array;
       std::vector < int > atom_cell_id_array;
+      std::vector < int > cell_local_index_array; /// local index of each cell for per move updates (-1 if not local)
 
       int cells_num_cells;
       int cells_num_local_cells;
@@ -108,6 +111,69 @@ namespace dipole{
       std::vector <int> receive_counts(0);
       std::vector <int> receive_displacements(0);
 
+      //------------------------------------------------------------------------
+      // data structures for Barnes-Hut solver
+      //------------------------------------------------------------------------
+
+      double opening_angle = 0.5; // maximum ratio of node size to distance for approximation of node as a single dipole
+      bool barnes_hut_accuracy_check = false; // flag to compare field with exact sum for a sample of atoms at initialisation
+
+      octree_t tree; // octree of local atoms and sources from other processors
+      octree_t local_tree; // octree of local atoms only
+      std::vector <int> tree_target_leaves(0); // list of leaf nodes containing local atoms
+
+      // list of local tree nodes (>= 0) and tree positions of local atoms (< 0) sent to other processors
+      std::vector <int> tree_send_list(0);
+      std::vector <int> tree_send_counts(0);
+      std::vector <int> tree_send_displacements(0);
+      std::vector <int> tree_recv_counts(0);
+      std::vector <int> tree_recv_displacements(0);
+
+      //------------------------------------------------------------------------
+      // data structures for fft solver
+      //------------------------------------------------------------------------
+
+      int fft_num_cells[3] = {1, 1, 1}; // number of macrocells in x,y,z
+      int fft_padded_size[3] = {1, 1, 1}; // zero padded (power of 2) grid size in x,y,z
+
+      // twiddle factors for forward transform along x,y,z
+      std::vector < std::complex <double> > fft_twiddle[3];
+
+      // Fourier transform of dipole-dipole kernel (xx,xy,xz,yy,yz,zz) on padded grid
+      std::vector < std::complex <double> > fft_kernel(0);
+
+      // work arrays for cell magnetisation and field on padded grid
+      std::vector < std::complex <double> > fft_mx(0);
+      std::vector < std::complex <double> > fft_my(0);
+      std::vector < std::complex <double> > fft_mz(0);
+
+      // point dipole kernel for cells within near field range
+      std::vector <double> fft_range_kernel(0);
+
+      //------------------------------------------------------------------------
+      // data structures for near field tensor cache
+      //------------------------------------------------------------------------
+
+      int near_range = 0; // range of near field tensors in cells
+
+      // unique near field tensors (xx,xy,xz,yy,yz,zz)
+      std::vector <double> unique_tensor_array(0);
+
+      // near field tensors for each local cell in CSR format, in order of cell id
+      std::vector <int> near_start_index(0);
+      std::vector <int> near_cell_array(0);
+      std::vector <int> near_tensor_id_array(0); // id of tensor in unique_tensor_array
+
+      // positions and normalised moments of non-empty cells for far field update
+      int num_compact_cells = 0;
+      std::vector <int> compact_cell_id(0); // index of cell in compact arrays
+      std::vector <double> compact_x(0);
+      std::vector <double> compact_y(0);
+      std::vector <double> compact_z(0);
+      std::vector <double> compact_mx(0);
+      std::vector <double> compact_my(0);
+      std::vector <double> compact_mz(0);
+
       //------------------------------------------------------------------------
       // Shared functions inside dipole module
       //------------------------------------------------------------------------
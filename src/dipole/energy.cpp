@@ -8,6 +8,9 @@
 //------------------------------------------------------------------------------
 //
 
+// Vampire headers
+#include "material.hpp"
+
 // dipole module headers
 #include "internal.hpp"
 
@@ -18,6 +21,13 @@ namespace dipole{
 //------------------------------------------------------------------------------
 double spin_magnetostatic_energy(const int atom, const double sx, const double sy, const double sz){
 
+   // with per move updates only the cell fields are current
+   if(dipole::per_move_update){
+      if(mp::material[dipole::internal::atom_type_array[atom]].non_magnetic != 0) return 0.0;
+      const int cell = dipole::internal::atom_cell_id_array[atom];
+      return -1.0 * ( dipole::cells_mu0Hd_field_array_x[cell] * sx + dipole::cells_mu0Hd_field_array_y[cell] * sy + dipole::cells_mu0Hd_field_array_z[cell] * sz);
+   }
+
    return -1.0 * ( dipole::atom_mu0demag_field_array_x[atom] * sx + dipole::atom_mu0demag_field_array_y[atom] * sy + dipole::atom_mu0demag_field_array_z[atom] * sz);
 
 }
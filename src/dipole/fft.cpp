@@ -0,0 +1,584 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+// Vampire headers
+#include "cells.hpp"
+#include "dipole.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+#include "vutil.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to return smallest power of 2 >= n
+      //------------------------------------------------------------------------
+      int next_power_of_two(const int n){
+         int p = 1;
+         while(p < n) p <<= 1;
+         return p;
+      }
+
+      //------------------------------------------------------------------------
+      // In place radix-2 complex fast Fourier transform of n (power of 2)
+      // contiguous values. The inverse transform is not normalised.
+      //------------------------------------------------------------------------
+      void fft_1d(std::complex<double>* data, const int n, const std::vector< std::complex<double> >& twiddle, const bool inverse){
+
+         // bit reversal permutation
+         for(int i = 1, j = 0; i < n; i++){
+            int bit = n >> 1;
+            for(; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if(i < j) std::swap(data[i], data[j]);
+         }
+
+         const double sign = inverse ? -1.0 : 1.0;
+
+         // butterflies
+         for(int len = 2; len <= n; len <<= 1){
+            const int half = len >> 1;
+            const int step = n/len;
+            for(int i = 0; i < n; i += len){
+               for(int k = 0; k < half; k++){
+                  const double wr = twiddle[k*step].real();
+                  const double wi = sign*twiddle[k*step].imag();
+                  const double ur = data[i+k].real();
+                  const double ui = data[i+k].imag();
+                  const double vr = data[i+k+half].real()*wr - data[i+k+half].imag()*wi;
+                  const double vi = data[i+k+half].real()*wi + data[i+k+half].imag()*wr;
+                  data[i+k]      = std::complex<double>(ur + vr, ui + vi);
+                  data[i+k+half] = std::complex<double>(ur - vr, ui - vi);
+               }
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate 3D fast Fourier transform on padded grid. Lines
+      // which are known to be zero (forward) or are not needed (inverse) are
+      // skipped, where n gives the extent of the non-zero input data (forward)
+      // or required output data (inverse).
+      //------------------------------------------------------------------------
+      void fft_3d(std::vector< std::complex<double> >& data, const bool inverse, const int n[3]){
+
+         const int px = fft_padded_size[0];
+         const int py = fft_padded_size[1];
+         const int pz = fft_padded_size[2];
+
+         std::vector< std::complex<double> > line(std::max(px, py));
+
+         // forward transform along z (contiguous)
+         if(!inverse && pz > 1){
+            for(int i = 0; i < n[0]; i++){
+               for(int j = 0; j < n[1]; j++) fft_1d(&data[(i*py + j)*pz], pz, fft_twiddle[2], inverse);
+            }
+         }
+
+         // inverse transform along x
+         if(inverse && px > 1){
+            for(int j = 0; j < py; j++){
+               for(int k = 0; k < pz; k++){
+                  for(int i = 0; i < px; i++) line[i] = data[(i*py + j)*pz + k];
+                  fft_1d(&line[0], px, fft_twiddle[0], inverse);
+                  for(int i = 0; i < px; i++) data[(i*py + j)*pz + k] = line[i];
+               }
+            }
+         }
+
+         // transform along y
+         if(py > 1){
+            for(int i = 0; i < n[0]; i++){
+               for(int k = 0; k < pz; k++){
+                  for(int j = 0; j < py; j++) line[j] = data[(i*py + j)*pz + k];
+                  fft_1d(&line[0], py, fft_twiddle[1], inverse);
+                  for(int j = 0; j < py; j++) data[(i*py + j)*pz + k] = line[j];
+               }
+            }
+         }
+
+         // forward transform along x
+         if(!inverse && px > 1){
+            for(int j = 0; j < py; j++){
+               for(int k = 0; k < pz; k++){
+                  for(int i = 0; i < px; i++) line[i] = data[(i*py + j)*pz + k];
+                  fft_1d(&line[0], px, fft_twiddle[0], inverse);
+                  for(int i = 0; i < px; i++) data[(i*py + j)*pz + k] = line[i];
+               }
+            }
+         }
+
+         // inverse transform along z (contiguous)
+         if(inverse && pz > 1){
+            for(int i = 0; i < n[0]; i++){
+               for(int j = 0; j < n[1]; j++) fft_1d(&data[(i*py + j)*pz], pz, fft_twiddle[2], inverse);
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate corrections (tensor - kernel) between local cell
+      // lc and all cells within the near field range. Corrections for cells
+      // within the cutoff are cached, and corrections for the remaining cells
+      // account for the displacement of the cell centres of mass from the
+      // regular grid.
+      //------------------------------------------------------------------------
+      void fft_near_corrections(const int lc, std::vector <int>& near_cells, std::vector <double>& corrections){
+
+         near_cells.resize(0);
+         corrections.resize(0);
+
+         const int* nc = fft_num_cells;
+         const int range = dipole::internal::near_range;
+         const int width = 2*range+1;
+
+         const int i = cells::cell_id_array[lc];
+         const int ix = i/(nc[1]*nc[2]);
+         const int iy = (i/nc[2])%nc[1];
+         const int iz = i%nc[2];
+
+         int near = dipole::internal::near_start_index[lc];
+
+         for(int jx = std::max(0, ix-range); jx <= std::min(nc[0]-1, ix+range); jx++){
+            for(int jy = std::max(0, iy-range); jy <= std::min(nc[1]-1, iy+range); jy++){
+               for(int jz = std::max(0, iz-range); jz <= std::min(nc[2]-1, iz+range); jz++){
+
+                  const int j = (jx*nc[1] + jy)*nc[2] + jz;
+                  if(dipole::internal::cells_num_atoms_in_cell[j] == 0) continue;
+
+                  double tensor[6];
+                  if(near < dipole::internal::near_start_index[lc+1] && dipole::internal::near_cell_array[near] == j){
+                     const int id = dipole::internal::near_tensor_id_array[near];
+                     for(int c = 0; c < 6; c++) tensor[c] = dipole::internal::unique_tensor_array[6*id+c];
+                     near++;
+                  }
+                  else{
+                     point_dipole_tensor(cells_pos_and_mom_array[4*j+0] - cells_pos_and_mom_array[4*i+0],
+                                         cells_pos_and_mom_array[4*j+1] - cells_pos_and_mom_array[4*i+1],
+                                         cells_pos_and_mom_array[4*j+2] - cells_pos_and_mom_array[4*i+2], tensor);
+                     const double* kernel = &fft_range_kernel[6*(((jx-ix+range)*width + (jy-iy+range))*width + (jz-iz+range))];
+                     for(int c = 0; c < 6; c++) tensor[c] -= kernel[c];
+                  }
+
+                  near_cells.push_back(j);
+                  corrections.insert(corrections.end(), tensor, tensor+6);
+
+               }
+            }
+         }
+
+         return;
+
+      }
+
+      #ifdef MPICF
+      //------------------------------------------------------------------------
+      // Function to collate atom coordinates of all cells needed by the local
+      // cells for the fft solver from other processors
+      //------------------------------------------------------------------------
+      void collate_fft_cell_data(int cells_num_cells, /// number of macrocells
+                                 int cells_num_local_cells, /// number of local macrocells
+                                 const double cells_macro_cell_size,
+                                 std::vector <int>& cells_local_cell_array,
+                                 std::vector <int>& cells_num_atoms_in_cell, /// number of atoms in each cell
+                                 std::vector <int>& cells_num_atoms_in_cell_global, /// number of atoms in each cell
+                                 std::vector < std::vector <int> >& cells_index_atoms_array,
+                                 std::vector<double>& cells_pos_and_mom_array, // array to store positions and moment of cells
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z,
+                                 std::vector<int>& atom_type_array,
+                                 std::vector<double>& atom_coords_x, //atomic coordinates
+                                 std::vector<double>& atom_coords_y,
+                                 std::vector<double>& atom_coords_z){
+
+         const int num_local_atoms = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
+
+         std::vector<double> atom_pos_x(num_local_atoms,0.0);
+         std::vector<double> atom_pos_y(num_local_atoms,0.0);
+         std::vector<double> atom_pos_z(num_local_atoms,0.0);
+
+         for(int atom=0; atom<num_local_atoms; atom++){
+            atom_pos_x[atom]=atom_coords_x[atom];
+            atom_pos_y[atom]=atom_coords_y[atom];
+            atom_pos_z[atom]=atom_coords_z[atom];
+         }
+
+         for(int lc=0; lc<cells_num_cells; lc++){
+            // resize arrays
+            cells_atom_in_cell_coords_array_x[lc].resize(cells_num_atoms_in_cell[lc]);
+            cells_atom_in_cell_coords_array_y[lc].resize(cells_num_atoms_in_cell[lc]);
+            cells_atom_in_cell_coords_array_z[lc].resize(cells_num_atoms_in_cell[lc]);
+            cells_index_atoms_array[lc].resize(cells_num_atoms_in_cell[lc]);
+         }
+
+         // Exchange cells data
+         dipole::internal::send_recv_cells_data(dipole::internal::proc_cell_index_array1D,
+                                                cells_atom_in_cell_coords_array_x,
+                                                cells_atom_in_cell_coords_array_y,
+                                                cells_atom_in_cell_coords_array_z,
+                                                cells_index_atoms_array,
+                                                cells_pos_and_mom_array,
+                                                cells_num_atoms_in_cell,
+                                                cells::cell_id_array,
+                                                cells_local_cell_array,
+                                                cells_num_local_cells,
+                                                cells_num_cells);
+
+         // Exchange atoms data
+         dipole::internal::send_recv_atoms_data(dipole::internal::proc_cell_index_array1D,
+                                                cells::cell_id_array,
+                                                cells_local_cell_array,
+                                                atom_pos_x,
+                                                atom_pos_y,
+                                                atom_pos_z,
+                                                atom_type_array, // atomic moments (from dipole;:internal::atom_type_array)
+                                                cells_atom_in_cell_coords_array_x,
+                                                cells_atom_in_cell_coords_array_y,
+                                                cells_atom_in_cell_coords_array_z,
+                                                cells_index_atoms_array,
+                                                cells_pos_and_mom_array,
+                                                cells_num_atoms_in_cell,
+                                                cells_num_local_cells,
+                                                cells_num_cells,
+                                                cells_macro_cell_size);
+
+         // Reorder data structure
+         dipole::internal::sort_data(dipole::internal::proc_cell_index_array1D,
+                                     cells::cell_id_array,
+                                     cells_atom_in_cell_coords_array_x,
+                                     cells_atom_in_cell_coords_array_y,
+                                     cells_atom_in_cell_coords_array_z,
+                                     cells_index_atoms_array,
+                                     cells_pos_and_mom_array,
+                                     cells_num_atoms_in_cell,
+                                     cells_num_local_cells,
+                                     cells_num_cells);
+
+         // After transferring the data across cores, assign value cells_num_atoms_in_cell[] from cells_num_atoms_in_cell_global[]
+         for(unsigned int i=0; i<cells_num_atoms_in_cell_global.size(); i++){
+            if(cells_num_atoms_in_cell_global[i]>0 && cells_num_atoms_in_cell[i]==0){
+               cells_num_atoms_in_cell[i] = cells_num_atoms_in_cell_global[i];
+            }
+         }
+
+         // Clear memory
+         cells_num_atoms_in_cell_global.clear();
+
+         // Clear atom_pos_x,y,z
+         atom_pos_x.clear();
+         atom_pos_y.clear();
+         atom_pos_z.clear();
+
+         return;
+
+      }
+      #endif
+
+      //------------------------------------------------------------------------
+      // Function to initialise fft dipole solver.
+      //
+      // The macrocells form a regular grid, and so the dipole-dipole tensor
+      // between cell centres depends only on their separation. The long range
+      // field is then a convolution of the cell magnetisation with this kernel,
+      // which is calculated on a zero padded grid using fast Fourier transforms
+      // in O(N log N) time and O(N) memory. Cells within a few cells of each
+      // other are corrected to the tensor solver values, with inter and intra
+      // cell tensors calculated from the atomistic coordinates as usual.
+      //------------------------------------------------------------------------
+      void initialize_fft_solver(const double cells_macro_cell_size,
+                                 std::vector <int>& cells_num_atoms_in_cell, /// number of atoms in each cell
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z){
+
+         // Assign updated value of cells_num_atoms_in_cell to dipole::dipole_cells_num_atoms_in_cell. It is needed to print the config file. The actual value cells::num_atoms_in_cell is not changed instead
+         dipole::dipole_cells_num_atoms_in_cell=cells_num_atoms_in_cell;
+
+         zlog << zTs() << "Precalculating dipole kernel for dipole calculation using fft solver... " << std::endl;
+         std::cout     << "Precalculating dipole kernel for dipole calculation using fft solver"     << std::flush;
+
+         // instantiate timer
+         vutil::vtimer_t timer;
+
+         // start timer
+         timer.start();
+
+         //------------------------------------------------------
+         // Determine zero padded grid size
+         //------------------------------------------------------
+         const int nc[3] = { cells::num_cells_x, cells::num_cells_y, cells::num_cells_z };
+         for(int d = 0; d < 3; d++){
+            fft_num_cells[d] = nc[d];
+            fft_padded_size[d] = next_power_of_two(2*nc[d]-1);
+            fft_twiddle[d].resize(fft_padded_size[d]/2);
+            for(int k = 0; k < fft_padded_size[d]/2; k++){
+               const double theta = -2.0*M_PI*double(k)/double(fft_padded_size[d]);
+               fft_twiddle[d][k] = std::complex<double>(cos(theta), sin(theta));
+            }
+         }
+         const int px = fft_padded_size[0];
+         const int py = fft_padded_size[1];
+         const int pz = fft_padded_size[2];
+         const int num_padded_cells = px*py*pz;
+
+         //------------------------------------------------------
+         // Calculate Fourier transform of point dipole kernel
+         //------------------------------------------------------
+         fft_kernel.assign(6*num_padded_cells, std::complex<double>(0.0, 0.0));
+         std::vector< std::complex<double> > component(num_padded_cells);
+
+         // normalisation of inverse transform is included in kernel
+         const double inverse_norm = 1.0/double(num_padded_cells);
+
+         for(int c = 0; c < 6; c++){
+            for(int ix = 0; ix < px; ix++){
+               const int dx = ix < nc[0] ? ix : ix - px;
+               for(int iy = 0; iy < py; iy++){
+                  const int dy = iy < nc[1] ? iy : iy - py;
+                  for(int iz = 0; iz < pz; iz++){
+                     const int dz = iz < nc[2] ? iz : iz - pz;
+                     double tensor[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+                     // kernel is zero for self interaction and separations outside system
+                     const bool inside = abs(dx) < nc[0] && abs(dy) < nc[1] && abs(dz) < nc[2];
+                     if(inside && (dx != 0 || dy != 0 || dz != 0)){
+                        point_dipole_tensor(double(dx)*cells_macro_cell_size, double(dy)*cells_macro_cell_size, double(dz)*cells_macro_cell_size, tensor);
+                     }
+                     component[(ix*py + iy)*pz + iz] = std::complex<double>(tensor[c]*inverse_norm, 0.0);
+                  }
+               }
+            }
+            fft_3d(component, false, fft_padded_size);
+            std::copy(component.begin(), component.end(), fft_kernel.begin() + c*num_padded_cells);
+         }
+
+         fft_mx.resize(num_padded_cells);
+         fft_my.resize(num_padded_cells);
+         fft_mz.resize(num_padded_cells);
+
+         //------------------------------------------------------
+         // Calculate near field corrections for local cells
+         //------------------------------------------------------
+         calculate_near_tensors(cells_macro_cell_size, true, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+
+         // kernel for cells within near field range
+         const int range = dipole::internal::near_range;
+         const int width = 2*range+1;
+         fft_range_kernel.assign(6*width*width*width, 0.0);
+         for(int dx = -range; dx <= range; dx++){
+            for(int dy = -range; dy <= range; dy++){
+               for(int dz = -range; dz <= range; dz++){
+                  if(dx == 0 && dy == 0 && dz == 0) continue;
+                  point_dipole_tensor(double(dx)*cells_macro_cell_size, double(dy)*cells_macro_cell_size, double(dz)*cells_macro_cell_size,
+                                      &fft_range_kernel[6*(((dx+range)*width + (dy+range))*width + (dz+range))]);
+               }
+            }
+         }
+
+         // hold parallel calculation until all processors have completed the dipole calculation
+         vmpi::barrier();
+
+         // stop timer
+         timer.stop();
+
+         std::cout << "done! [ " << timer.elapsed_time() << " s ]" << std::endl;
+         zlog << zTs() << "Precalculation of dipole kernel for dipole calculation complete. Time taken: " << timer.elapsed_time() << " s"<< std::endl;
+
+         const double kernel_memory = double(9*num_padded_cells)*sizeof(std::complex<double>);
+         const double near_memory = double(dipole::internal::unique_tensor_array.size())*sizeof(double) + double(dipole::internal::near_start_index.size() + 2*dipole::internal::near_cell_array.size())*sizeof(int);
+         zlog << zTs() << "FFT grid size: " << px << " x " << py << " x " << pz << " (" << nc[0] << " x " << nc[1] << " x " << nc[2] << " macrocells)" << std::endl;
+         zlog << zTs() << "FFT dipole field calculation requires " << (kernel_memory + near_memory)/1.0e6 << " MB of RAM" << std::endl;
+         std::cout     << "FFT dipole field calculation requires " << (kernel_memory + near_memory)/1.0e6 << " MB of RAM" << std::endl;
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate dipole and demagnetising fields in local cells
+      // using the fft solver
+      //------------------------------------------------------------------------
+      void update_fft_field(){
+
+         // Define constant imuB = 1/muB to normalise to unitarian values the cell magnetisation
+         const double imuB = 1.0/9.27400915e-24;
+
+         const int* nc = fft_num_cells;
+         const int py = fft_padded_size[1];
+         const int pz = fft_padded_size[2];
+         const int num_padded_cells = fft_padded_size[0]*py*pz;
+
+         // copy normalised cell magnetisation to padded grid
+         std::fill(fft_mx.begin(), fft_mx.end(), std::complex<double>(0.0, 0.0));
+         std::fill(fft_my.begin(), fft_my.end(), std::complex<double>(0.0, 0.0));
+         std::fill(fft_mz.begin(), fft_mz.end(), std::complex<double>(0.0, 0.0));
+
+         for(int i = 0; i < dipole::internal::cells_num_cells; i++){
+            if(dipole::internal::cells_num_atoms_in_cell[i]>0){
+               const int index = ((i/(nc[1]*nc[2]))*py + (i/nc[2])%nc[1])*pz + i%nc[2];
+               fft_mx[index] = cells::mag_array_x[i]*imuB;
+               fft_my[index] = cells::mag_array_y[i]*imuB;
+               fft_mz[index] = cells::mag_array_z[i]*imuB;
+            }
+         }
+
+         fft_3d(fft_mx, false, nc);
+         fft_3d(fft_my, false, nc);
+         fft_3d(fft_mz, false, nc);
+
+         // multiply by kernel in Fourier space
+         const std::complex<double>* kxx = &fft_kernel[0*num_padded_cells];
+         const std::complex<double>* kxy = &fft_kernel[1*num_padded_cells];
+         const std::complex<double>* kxz = &fft_kernel[2*num_padded_cells];
+         const std::complex<double>* kyy = &fft_kernel[3*num_padded_cells];
+         const std::complex<double>* kyz = &fft_kernel[4*num_padded_cells];
+         const std::complex<double>* kzz = &fft_kernel[5*num_padded_cells];
+
+         for(int index = 0; index < num_padded_cells; index++){
+            const std::complex<double> mx = fft_mx[index];
+            const std::complex<double> my = fft_my[index];
+            const std::complex<double> mz = fft_mz[index];
+            fft_mx[index] = kxx[index]*mx + kxy[index]*my + kxz[index]*mz;
+            fft_my[index] = kxy[index]*mx + kyy[index]*my + kyz[index]*mz;
+            fft_mz[index] = kxz[index]*mx + kyz[index]*my + kzz[index]*mz;
+         }
+
+         fft_3d(fft_mx, true, nc);
+         fft_3d(fft_my, true, nc);
+         fft_3d(fft_mz, true, nc);
+
+         // temporary arrays for near field corrections
+         std::vector <int> near_cells;
+         std::vector <double> corrections;
+
+         // loop over local cells
+         for(int lc=0;lc<dipole::internal::cells_num_local_cells;lc++){
+
+            const int i = cells::cell_id_array[lc];
+
+            if(dipole::internal::cells_num_atoms_in_cell[i]>0){
+
+               const int index = ((i/(nc[1]*nc[2]))*py + (i/nc[2])%nc[1])*pz + i%nc[2];
+
+               double hx = fft_mx[index].real();
+               double hy = fft_my[index].real();
+               double hz = fft_mz[index].real();
+
+               // add near field corrections
+               fft_near_corrections(lc, near_cells, corrections);
+               for(unsigned int n = 0; n < near_cells.size(); n++){
+
+                  const int j = near_cells[n];
+                  const double* t = &corrections[6*n];
+
+                  const double mx = cells::mag_array_x[j]*imuB;
+                  const double my = cells::mag_array_y[j]*imuB;
+                  const double mz = cells::mag_array_z[j]*imuB;
+
+                  hx += mx*t[0] + my*t[1] + mz*t[2];
+                  hy += mx*t[1] + my*t[3] + mz*t[4];
+                  hz += mx*t[2] + my*t[4] + mz*t[5];
+
+               }
+
+               // Self demagnetisation factor multiplying m(i)
+               const double self_demag = 8.0*M_PI/(3.0*dipole::internal::cells_volume_array[i]);
+
+               const double mx_i = cells::mag_array_x[i]*imuB;
+               const double my_i = cells::mag_array_y[i]*imuB;
+               const double mz_i = cells::mag_array_z[i]*imuB;
+
+               // Multiply the cells B-field by mu_B * mu_0/(4*pi) /1e-30
+               dipole::cells_field_array_x[i] = hx * 9.27400915e-01;
+               dipole::cells_field_array_y[i] = hy * 9.27400915e-01;
+               dipole::cells_field_array_z[i] = hz * 9.27400915e-01;
+
+               // Add self demagnetisation to Hdemag
+               dipole::cells_mu0Hd_field_array_x[i] = (hx - 0.5*self_demag*mx_i) * 9.27400915e-01;
+               dipole::cells_mu0Hd_field_array_y[i] = (hy - 0.5*self_demag*my_i) * 9.27400915e-01;
+               dipole::cells_mu0Hd_field_array_z[i] = (hz - 0.5*self_demag*mz_i) * 9.27400915e-01;
+
+            }
+         }
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate sum of dipole tensors for each local cell,
+      // weighted by the number of atoms in each cell, for calculation of the
+      // demagnetisation tensor with the fft solver
+      //------------------------------------------------------------------------
+      void calculate_fft_demag_tensor(std::vector<double>& N_tensor_array){
+
+         const int* nc = fft_num_cells;
+         const int py = fft_padded_size[1];
+         const int pz = fft_padded_size[2];
+         const int num_padded_cells = fft_padded_size[0]*py*pz;
+
+         // Fourier transform of number of atoms in each cell
+         std::vector< std::complex<double> > num_atoms(num_padded_cells, std::complex<double>(0.0, 0.0));
+         for(int i = 0; i < dipole::internal::cells_num_cells; i++){
+            const int index = ((i/(nc[1]*nc[2]))*py + (i/nc[2])%nc[1])*pz + i%nc[2];
+            num_atoms[index] = double(dipole::internal::cells_num_atoms_in_cell[i]);
+         }
+         fft_3d(num_atoms, false, nc);
+
+         std::vector< std::complex<double> > component(num_padded_cells);
+
+         // temporary arrays for near field corrections
+         std::vector <int> near_cells;
+         std::vector <double> corrections;
+
+         for(int c = 0; c < 6; c++){
+
+            // convolve kernel with number of atoms
+            for(int index = 0; index < num_padded_cells; index++) component[index] = fft_kernel[c*num_padded_cells + index]*num_atoms[index];
+            fft_3d(component, true, nc);
+
+            for(int lc=0; lc<dipole::internal::cells_num_local_cells; lc++){
+               const int i = cells::cell_id_array[lc];
+               if(dipole::internal::cells_num_atoms_in_cell[i]>0){
+                  const int index = ((i/(nc[1]*nc[2]))*py + (i/nc[2])%nc[1])*pz + i%nc[2];
+                  double sum = component[index].real();
+                  fft_near_corrections(lc, near_cells, corrections);
+                  for(unsigned int n = 0; n < near_cells.size(); n++){
+                     sum += double(dipole::internal::cells_num_atoms_in_cell[near_cells[n]])*corrections[6*n+c];
+                  }
+                  N_tensor_array[6*i+c] = double(dipole::internal::cells_num_atoms_in_cell[i])*sum;
+               }
+            }
+
+         }
+
+         return;
+
+      }
+
+   } // end of namespace internal
+
+} // end of namespace dipole
@@ -74,18 +74,60 @@ namespace dipole{
                   dipole::internal::calculate_atomistic_dipole_field(x_spin_array, y_spin_array, z_spin_array);
                   break;
 
+               case dipole::internal::fft:
+                  dipole::internal::calculate_macrocell_dipole_field();
+                  break;
+
+               case dipole::internal::barnes_hut:
+                  dipole::internal::calculate_barnes_hut_dipole_field(x_spin_array, y_spin_array, z_spin_array);
+                  break;
+
             }
 
             // for gpu acceleration, transfer calculated fields now (does nothing for serial)
             gpu::transfer_dipole_fields_from_cpu_to_gpu();
 
 		   } // End of check for update rate
+
+         // progress outstanding reduction of cell magnetisation between updates
+         else if(dipole::internal::asynchronous_update) cells::test_mag();
+
 		} // end of check for update time
 
       return;
 
    }
 
+   //-----------------------------------------------------------------------------
+   // Function to update cell fields for a single accepted Monte Carlo move,
+   // so that the field seen by the next move includes all previous moves
+   //-----------------------------------------------------------------------------
+   void update_field_for_spin_change(const int atom, const double Sold[3], const double Snew[3]){
+
+      const int type = dipole::internal::atom_type_array[atom];
+
+      // Consider only magnetic elements
+      if(mp::material[type].non_magnetic==0){
+         // change in moment in Bohr magnetons
+         const double mus = mp::material[type].mu_s_SI/9.27400915e-24;
+         dipole::internal::update_field_for_moment_change(dipole::internal::atom_cell_id_array[atom], (Snew[0] - Sold[0])*mus, (Snew[1] - Sold[1])*mus, (Snew[2] - Sold[2])*mus);
+      }
+
+      return;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to complete outstanding communication before MPI is finalised
+   //-----------------------------------------------------------------------------
+   void finalize(){
+
+      if(dipole::internal::asynchronous_update) cells::end_mag();
+
+      return;
+
+   }
+
    namespace internal{
 
       void calculate_macrocell_dipole_field(){
@@ -95,7 +137,15 @@ namespace dipole{
          //timer.start();
 
          // update cell magnetisations
-         cells::mag();
+         if(dipole::internal::asynchronous_update){
+            // Use cell magnetisation from reduction posted at last update (or
+            // calculate directly at first update), and post reduction for next
+            // update. Communication then overlaps with the field calculation
+            // and the following time steps, with the field lagging one update.
+            if(!cells::end_mag()) cells::mag();
+            cells::begin_mag();
+         }
+         else cells::mag();
 
          // end timer
          //timer.stop();
@@ -105,7 +155,8 @@ namespace dipole{
          //zlog << zTs() << "Calculation cells magnetisation complete. Time taken: " << update_time << "s."<< std::endl;
 
          // recalculate dipole fields
-         dipole::internal::update_field();
+         if(dipole::internal::solver == dipole::internal::fft) dipole::internal::update_fft_field();
+         else dipole::internal::update_field();
 
          // For MPI version, only add local atoms
          #ifdef MPICF
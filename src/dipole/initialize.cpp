@@ -68,8 +68,9 @@ namespace dipole{
       std::cout << "Initialising dipole field calculation" << std::endl;
 		zlog << zTs() << "Initialising dipole field calculation" << std::endl;
 
-      // allocate memory for rij matrix
-      dipole::internal::allocate_memory(cells_num_local_cells, cells_num_cells);
+      // allocate memory for rij matrix (only needed for macrocell solver)
+      if(dipole::internal::solver == dipole::internal::macrocell) dipole::internal::allocate_memory(cells_num_local_cells, cells_num_cells);
+      else dipole::internal::allocate_memory(0, cells_num_cells);
 
       //-------------------------------------------------------------------------------------
       // Set const for functions
@@ -91,12 +92,14 @@ namespace dipole{
 		// Starting calculation of dipolar field
 		//-------------------------------------------------------------------------------------
 
-      // Check memory requirements and print to screen
-      zlog << zTs() << "Fast dipole field calculation has been enabled and requires " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_local_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
-      std::cout     << "Fast dipole field calculation has been enabled and requires " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_local_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
+      // Check memory requirements and print to screen (tensor and fft solver memory is output during initialisation)
+      if(dipole::internal::solver == dipole::internal::macrocell){
+         zlog << zTs() << "Fast dipole field calculation has been enabled and requires " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_local_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
+         std::cout     << "Fast dipole field calculation has been enabled and requires " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_local_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
 
-      zlog << zTs() << "Total memory for dipole calculation (all CPUs): " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
-      std::cout << "Total memory for dipole calculation (all CPUs): " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
+         zlog << zTs() << "Total memory for dipole calculation (all CPUs): " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
+         std::cout << "Total memory for dipole calculation (all CPUs): " << double(dipole::internal::cells_num_cells)*double(dipole::internal::cells_num_cells*6)*8.0/1.0e6 << " MB of RAM" << std::endl;
+      }
 
       zlog << zTs() << "Number of local cells for dipole calculation = " << dipole::internal::cells_num_local_cells << std::endl;
       zlog << zTs() << "Number of total cells for dipole calculation = " << dipole::internal::cells_num_cells << std::endl;
@@ -124,6 +127,50 @@ namespace dipole{
             dipole::internal::initialize_atomistic_solver(num_atoms, atom_coords_x, atom_coords_y, atom_coords_z, atom_moments, atom_type_array);
             break;
 
+         case dipole::internal::barnes_hut:
+            dipole::internal::initialize_barnes_hut_solver(num_atoms, atom_coords_x, atom_coords_y, atom_coords_z, atom_moments, atom_type_array);
+            break;
+
+         case dipole::internal::fft:
+            #ifdef MPICF
+               dipole::internal::collate_fft_cell_data(dipole::internal::cells_num_cells, dipole::internal::cells_num_local_cells, cells_macro_cell_size, dipole::internal::cells_local_cell_array,
+                                                       dipole::internal::cells_num_atoms_in_cell, cells_num_atoms_in_cell_global, cells_index_atoms_array, dipole::internal::cells_pos_and_mom_array,
+                                                       cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z,
+                                                       dipole::internal::atom_type_array, atom_coords_x, atom_coords_y, atom_coords_z);
+            #endif
+            dipole::internal::initialize_fft_solver(cells_macro_cell_size, dipole::internal::cells_num_atoms_in_cell,
+                                                    cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
+            break;
+
+      }
+
+      // Per move update of cell fields is available for the serial macrocell and tensor solvers
+      if(dipole::per_move_update){
+         #ifdef MPICF
+            const bool available = false;
+         #else
+            const bool available = dipole::internal::solver == dipole::internal::macrocell || dipole::internal::solver == dipole::internal::tensor;
+         #endif
+         if(!available){
+            zlog << zTs() << "Warning: Per move dipole update is only available for the macrocell and tensor solvers in serial and has been disabled" << std::endl;
+            dipole::per_move_update = false;
+         }
+         else{
+            dipole::internal::cell_local_index_array.assign(dipole::internal::cells_num_cells, -1);
+            for(int lc = 0; lc < dipole::internal::cells_num_local_cells; lc++) dipole::internal::cell_local_index_array[cells::cell_id_array[lc]] = lc;
+            // fields must be calculated from current cell magnetisation
+            dipole::internal::asynchronous_update = false;
+            zlog << zTs() << "Per move dipole update enabled: cell fields are updated after every accepted Monte Carlo move" << std::endl;
+         }
+      }
+
+      // Asynchronous update overlaps the reduction of cell magnetisation and so only applies to macrocell based solvers
+      if(dipole::internal::asynchronous_update){
+         if(dipole::internal::solver == dipole::internal::atomistic || dipole::internal::solver == dipole::internal::barnes_hut){
+            zlog << zTs() << "Warning: Asynchronous dipole update is not available for atomistic solvers and has been disabled" << std::endl;
+            dipole::internal::asynchronous_update = false;
+         }
+         else zlog << zTs() << "Asynchronous dipole update enabled: dipole field lags cell magnetisation by one update" << std::endl;
       }
 
       // Set initialised flag
@@ -150,6 +197,9 @@ namespace dipole{
 
       zlog << zTs() << "Time required for dipole update: " << timer.elapsed_time() << " s." << std::endl;
 
+      // compare Barnes-Hut field with exact sum for a sample of atoms
+      if(dipole::internal::solver == dipole::internal::barnes_hut && dipole::internal::barnes_hut_accuracy_check) dipole::internal::check_barnes_hut_accuracy();
+
       //--------------------------------------------------------------------------------------------------
       // Calculate gloabl demagnetizing factor from dipole tensors
       //--------------------------------------------------------------------------------------------------
@@ -164,8 +214,12 @@ namespace dipole{
       std::vector<double> N_tensor_array(6*dipole::internal::cells_num_cells,0.0);
 
 
+      // tensor and fft solvers calculate sum of tensors from near field tensors and long range form
+      if(dipole::internal::solver == dipole::internal::tensor) dipole::internal::calculate_tensor_demag_tensor(N_tensor_array);
+      if(dipole::internal::solver == dipole::internal::fft) dipole::internal::calculate_fft_demag_tensor(N_tensor_array);
+
       // Every cpus print to check dipolar matrix inter term
-      for(int lc=0; lc<dipole::internal::cells_num_local_cells; lc++){
+      for(int lc=0; lc<dipole::internal::cells_num_local_cells && dipole::internal::solver == dipole::internal::macrocell; lc++){
 
          // get id of cell
          int i = cells::cell_id_array[lc];
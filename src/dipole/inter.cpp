@@ -40,12 +40,12 @@ namespace dipole{
       void compute_inter_tensor(const double cells_macro_cell_size,
                                 const int i,
                                 const int j,
-                                const int lc,
                                 std::vector <int>& cells_num_atoms_in_cell, /// number of atoms in each cell
                                 //std::vector<double>& cells_pos_and_mom_array, // array to store positions and moment of cells
                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
-                                std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z){
+                                std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z,
+                                double tensor[6]){ // xx, xy, xz, yy, yz, zz components of tensor
 
          // create temporary variable to store components of tensor
          double tmp_rij_inter_xx = 0.0;
@@ -74,13 +74,13 @@ namespace dipole{
 	         const double rij3 = (rij*rij*rij); // Angstroms
 
             // calculate dipolar matrix for 6 entries because of symmetry
-	         dipole::internal::rij_tensor_xx[lc][j] = ((3.0*ex*ex - 1.0)*rij3);
-	         dipole::internal::rij_tensor_xy[lc][j] = ( 3.0*ex*ey      )*rij3 ;
-	         dipole::internal::rij_tensor_xz[lc][j] = ( 3.0*ex*ez      )*rij3 ;
+	         tensor[0] = ((3.0*ex*ex - 1.0)*rij3);
+	         tensor[1] = ( 3.0*ex*ey      )*rij3 ;
+	         tensor[2] = ( 3.0*ex*ez      )*rij3 ;
 
-	         dipole::internal::rij_tensor_yy[lc][j] = ((3.0*ey*ey - 1.0)*rij3);
-	         dipole::internal::rij_tensor_yz[lc][j] = ( 3.0*ey*ez      )*rij3 ;
-	         dipole::internal::rij_tensor_zz[lc][j] = ((3.0*ez*ez - 1.0)*rij3);
+	         tensor[3] = ((3.0*ey*ey - 1.0)*rij3);
+	         tensor[4] = ( 3.0*ey*ez      )*rij3 ;
+	         tensor[5] = ((3.0*ez*ez - 1.0)*rij3);
 
          }
 
@@ -120,13 +120,13 @@ namespace dipole{
                }
             }
 
-            dipole::internal::rij_tensor_xx[lc][j] =  (tmp_rij_inter_xx);
-            dipole::internal::rij_tensor_xy[lc][j] =  (tmp_rij_inter_xy);
-            dipole::internal::rij_tensor_xz[lc][j] =  (tmp_rij_inter_xz);
+            tensor[0] =  (tmp_rij_inter_xx);
+            tensor[1] =  (tmp_rij_inter_xy);
+            tensor[2] =  (tmp_rij_inter_xz);
 
-            dipole::internal::rij_tensor_yy[lc][j] =  (tmp_rij_inter_yy);
-            dipole::internal::rij_tensor_yz[lc][j] =  (tmp_rij_inter_yz);
-            dipole::internal::rij_tensor_zz[lc][j] =  (tmp_rij_inter_zz);
+            tensor[3] =  (tmp_rij_inter_yy);
+            tensor[4] =  (tmp_rij_inter_yz);
+            tensor[5] =  (tmp_rij_inter_zz);
 
             // // Uncomment in case you want to print the tensor components
             // std::cout << "\n############# INTER ###################\n";
@@ -138,13 +138,13 @@ namespace dipole{
             // std::cout << std::endl;
 
             // Normalisation by the number of atoms in the cell. This is required for the correct evaluation of the field in the update.cpp routine
-            dipole::internal::rij_tensor_xx[lc][j] = dipole::internal::rij_tensor_xx[lc][j]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
-            dipole::internal::rij_tensor_xy[lc][j] = dipole::internal::rij_tensor_xy[lc][j]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
-            dipole::internal::rij_tensor_xz[lc][j] = dipole::internal::rij_tensor_xz[lc][j]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+            tensor[0] = tensor[0]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+            tensor[1] = tensor[1]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+            tensor[2] = tensor[2]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
 
-            dipole::internal::rij_tensor_yy[lc][j] = dipole::internal::rij_tensor_yy[lc][j]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
-            dipole::internal::rij_tensor_yz[lc][j] = dipole::internal::rij_tensor_yz[lc][j]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
-            dipole::internal::rij_tensor_zz[lc][j] = dipole::internal::rij_tensor_zz[lc][j]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+            tensor[3] = tensor[3]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+            tensor[4] = tensor[4]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+            tensor[5] = tensor[5]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
          }  // End of Inter part calculated atomicstically
       }  // End of funtion calculating inter component of dipole tensor
 
@@ -54,11 +54,28 @@ namespace dipole{
             dipole::activated=true;
             return true;
          }
+         test="fft";
+         if(value == test){
+            dipole::internal::solver = dipole::internal::fft;
+            // enable dipole calculation
+            dipole::activated=true;
+            return true;
+         }
+         test="barnes-hut";
+         if(value == test){
+            dipole::internal::solver = dipole::internal::barnes_hut;
+            // enable dipole calculation
+            dipole::activated=true;
+            return true;
+         }
          else{
             terminaltextcolor(RED);
             std::cerr << "Error: Value for \'" << prefix << ":" << word << "\' must be one of:" << std::endl;
             std::cerr << "\t\"macrocell\"" << std::endl;
             std::cerr << "\t\"tensor\"" << std::endl;
+            std::cerr << "\t\"atomistic\"" << std::endl;
+            std::cerr << "\t\"fft\"" << std::endl;
+            std::cerr << "\t\"barnes-hut\"" << std::endl;
             terminaltextcolor(WHITE);
             err::vexit();
          }
@@ -80,6 +97,35 @@ namespace dipole{
          return true;
       }
       //-------------------------------------------------------------------
+      test="opening-angle";
+      if(word==test){
+         double theta=atof(value.c_str());
+         vin::check_for_valid_value(theta, word, line, prefix, unit, "",  0.0, 1.5,"input","0.0 - 1.5");
+         dipole::internal::opening_angle=theta;
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="barnes-hut-accuracy-check";
+      if(word==test){
+         // compare barnes-hut field with exact sum for a sample of atoms
+         dipole::internal::barnes_hut_accuracy_check = vin::check_for_valid_bool(value, word, line, prefix,"input");
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="asynchronous-update";
+      if(word==test){
+         // overlap reduction of cell magnetisation with subsequent time steps
+         dipole::internal::asynchronous_update = vin::check_for_valid_bool(value, word, line, prefix,"input");
+         return true;
+      }
+      //-------------------------------------------------------------------
+      test="per-move-update";
+      if(word==test){
+         // update cell fields after every accepted Monte Carlo move
+         dipole::per_move_update = vin::check_for_valid_bool(value, word, line, prefix,"input");
+         return true;
+      }
+      //-------------------------------------------------------------------
       test="output-atomistic-dipole-field";
       if(word==test){
          // set flag to output atomistic dipole field
@@ -18,6 +18,7 @@
 //---------------------------------------------------------------------
 
 // C++ standard library headers
+#include <complex>
 #include <vector>
 
 // Vampire headers
@@ -46,13 +47,16 @@ namespace dipole{
          tensor       = 1, // new macrocell with tensor including local corrections
          //multipole    = 2, // bare macrocell but with multipole expansion
          //hierarchical = 3, // new macrocell with tensor including local corrections and nearfield multipole
-         atomistic = 4 // new macrocell with tensor including local corrections and nearfield multipole
+         atomistic = 4, // new macrocell with tensor including local corrections and nearfield multipole
+         fft = 5, // tensor macrocell with long range part calculated by fast Fourier transform
+         barnes_hut = 6 // atomistic dipole with long range part approximated by octree (Barnes-Hut)
          //exact        = 4, // atomistic dipole dipole (too slow for anything over 1000 atoms)
       };
 
       extern solver_t solver;
 
       extern int update_time; /// last update time
+      extern bool asynchronous_update; /// flag to overlap reduction of cell magnetisation with time steps (field lags one update)
 
       extern const double prefactor; // 1e-7/1e30
 
@@ -67,6 +71,7 @@ namespace dipole{
       extern int num_atoms;
       extern std::vector < int > atom_type_array;
       extern std::vector < int > atom_cell_id_array;
+      extern std::vector < int > cell_local_index_array; /// local index of each cell for per move updates (-1 if not local)
 
       extern int cells_num_cells;
       extern int cells_num_local_cells;
@@ -100,11 +105,101 @@ namespace dipole{
       extern std::vector <int> receive_counts;
       extern std::vector <int> receive_displacements;
 
+      //------------------------------------------------------------------------
+      // data structures for Barnes-Hut solver
+      //------------------------------------------------------------------------
+
+      extern double opening_angle; // maximum ratio of node size to distance for approximation of node as a single dipole
+      extern bool barnes_hut_accuracy_check; // flag to compare field with exact sum for a sample of atoms at initialisation
+
+      // class for node of octree
+      class tree_node_t{
+      public:
+         double x, y, z; // centre of node weighted by atomic moment (angstroms)
+         double size; // maximum distance of sources in node from centre (angstroms)
+         double mx, my, mz; // total moment of node (bohr magnetons)
+         double q[9]; // sum of moment (a) times displacement from centre (b) of sources, q[3a+b]
+         double s[18]; // sum of moment (a) times displacements (b,c) of sources, s[6a+bc] with bc = xx,xy,xz,yy,yz,zz
+         int start; // position of first source in tree order
+         int end; // position of last source in tree order + 1
+         int first_child; // id of first child node
+         int num_children; // number of child nodes (0 for leaf nodes)
+      };
+
+      // class for octree of point dipole sources
+      class octree_t{
+      public:
+         std::vector <tree_node_t> nodes;
+         std::vector <int> source; // id of source at each position in tree order
+         std::vector <double> x, y, z; // coordinates of sources in tree order (angstroms)
+         std::vector <double> mx, my, mz; // moments of sources in tree order (bohr magnetons)
+         std::vector <double> q; // q of sources which are nodes on other processors (9 per source, empty if none)
+         std::vector <double> s; // s of sources which are nodes on other processors (18 per source, empty if none)
+      };
+
+      extern octree_t tree; // octree of local atoms and sources from other processors
+      extern octree_t local_tree; // octree of local atoms only
+      extern std::vector <int> tree_target_leaves; // list of leaf nodes containing local atoms
+
+      // list of local tree nodes (>= 0) and tree positions of local atoms (< 0) sent to other processors
+      extern std::vector <int> tree_send_list;
+      extern std::vector <int> tree_send_counts;
+      extern std::vector <int> tree_send_displacements;
+      extern std::vector <int> tree_recv_counts;
+      extern std::vector <int> tree_recv_displacements;
+
+      //------------------------------------------------------------------------
+      // data structures for fft solver
+      //------------------------------------------------------------------------
+
+      extern int fft_num_cells[3]; // number of macrocells in x,y,z
+      extern int fft_padded_size[3]; // zero padded (power of 2) grid size in x,y,z
+
+      // twiddle factors for forward transform along x,y,z
+      extern std::vector < std::complex <double> > fft_twiddle[3];
+
+      // Fourier transform of dipole-dipole kernel (xx,xy,xz,yy,yz,zz) on padded grid
+      extern std::vector < std::complex <double> > fft_kernel;
+
+      // work arrays for cell magnetisation and field on padded grid
+      extern std::vector < std::complex <double> > fft_mx;
+      extern std::vector < std::complex <double> > fft_my;
+      extern std::vector < std::complex <double> > fft_mz;
+
+      // point dipole kernel for cells within near field range
+      extern std::vector <double> fft_range_kernel;
+
+      //------------------------------------------------------------------------
+      // data structures for near field tensor cache
+      //------------------------------------------------------------------------
+
+      extern int near_range; // range of near field tensors in cells
+
+      // unique near field tensors (xx,xy,xz,yy,yz,zz)
+      extern std::vector <double> unique_tensor_array;
+
+      // near field tensors for each local cell in CSR format, in order of cell id
+      extern std::vector <int> near_start_index;
+      extern std::vector <int> near_cell_array;
+      extern std::vector <int> near_tensor_id_array; // id of tensor in unique_tensor_array
+
+      // positions and normalised moments of non-empty cells for far field update
+      extern int num_compact_cells;
+      extern std::vector <int> compact_cell_id; // index of cell in compact arrays
+      extern std::vector <double> compact_x;
+      extern std::vector <double> compact_y;
+      extern std::vector <double> compact_z;
+      extern std::vector <double> compact_mx;
+      extern std::vector <double> compact_my;
+      extern std::vector <double> compact_mz;
+
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
       //void write_macrocell_data();
       extern void update_field();
+      void update_field_for_moment_change(const int j, const double dmx, const double dmy, const double dmz);
+      void initialize_compact_cells();
 
       void allocate_memory(const int cells_num_local_cells, const int cells_num_cells);
 
@@ -131,20 +226,31 @@ namespace dipole{
       void compute_inter_tensor(const double cells_macro_cell_size,
                                 const int i,
                                 const int j,
-                                const int lc,
                                 std::vector <int>& cells_num_atoms_in_cell, /// number of atoms in each cell
                                 //std::vector<double>& cells_pos_and_mom_array, // array to store positions and moment of cells
                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
-                                std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z);
+                                std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z,
+                                double tensor[6]);
 
       void compute_intra_tensor(const int i,
                                 const int j,
-                                const int lc,
                                 std::vector <int>& cells_num_atoms_in_cell, /// number of atoms in each cell
                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
-                                std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z);
+                                std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z,
+                                double tensor[6]);
+
+      void point_dipole_tensor(const double rx, const double ry, const double rz, double tensor[6]);
+
+      void calculate_near_tensors(const double cells_macro_cell_size,
+                                  const bool subtract_kernel,
+                                  std::vector <int>& cells_num_atoms_in_cell,
+                                  std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                  std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                  std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z);
+
+      void calculate_tensor_demag_tensor(std::vector<double>& N_tensor_array);
 
       void initialize_macrocell_solver(const int cells_num_atoms_in_unit_cell,
                                        int cells_num_cells, /// number of macrocells
@@ -166,6 +272,33 @@ namespace dipole{
                                        std::vector<double>& atom_coords_z,
                                        int num_atoms);
 
+      void initialize_fft_solver(const double cells_macro_cell_size,
+                                 std::vector <int>& cells_num_atoms_in_cell, /// number of atoms in each cell
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z);
+
+      #ifdef MPICF
+         void collate_fft_cell_data(int cells_num_cells, /// number of macrocells
+                                    int cells_num_local_cells, /// number of local macrocells
+                                    const double cells_macro_cell_size,
+                                    std::vector <int>& cells_local_cell_array,
+                                    std::vector <int>& cells_num_atoms_in_cell, /// number of atoms in each cell
+                                    std::vector <int>& cells_num_atoms_in_cell_global, /// number of atoms in each cell
+                                    std::vector < std::vector <int> >& cells_index_atoms_array,
+                                    std::vector<double>& cells_pos_and_mom_array, // array to store positions and moment of cells
+                                    std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                    std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                    std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z,
+                                    std::vector<int>& atom_type_array,
+                                    std::vector<double>& atom_coords_x, //atomic coordinates
+                                    std::vector<double>& atom_coords_y,
+                                    std::vector<double>& atom_coords_z);
+      #endif
+
+      void update_fft_field();
+      void calculate_fft_demag_tensor(std::vector<double>& N_tensor_array);
+
       void initialize_atomistic_solver(int num_atoms,                      // number of atoms (only correct in serial)
                                        std::vector<double>& x_coord_array, // atomic corrdinates (angstroms)
                                        std::vector<double>& y_coord_array,
@@ -177,6 +310,19 @@ namespace dipole{
                                             std::vector<double>& y_spin_array,
                                             std::vector<double>& z_spin_array);
 
+      void initialize_barnes_hut_solver(int num_atoms,                      // number of atoms (only correct in serial)
+                                        std::vector<double>& x_coord_array, // atomic corrdinates (angstroms)
+                                        std::vector<double>& y_coord_array,
+                                        std::vector<double>& z_coord_array,
+                                        std::vector<double>& moments_array, // atomistic magnetic moments (bohr magnetons)
+                                        std::vector<int>& mat_id_array);    // atom material ID
+
+      void calculate_barnes_hut_dipole_field(std::vector<double>& x_spin_array, // atomic spin directions
+                                             std::vector<double>& y_spin_array,
+                                             std::vector<double>& z_spin_array);
+
+      void check_barnes_hut_accuracy();
+
       //-----------------------------------------------------------------------------
       // Function to send receive cells data to other cpus
       //-----------------------------------------------------------------------------
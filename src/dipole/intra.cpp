@@ -39,11 +39,11 @@ namespace dipole{
       //------------------------------------------------------------------------
       void compute_intra_tensor(const int i,
                                 const int j,
-                                const int lc,
                                 std::vector <int>& cells_num_atoms_in_cell, /// number of atoms in each cell
                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
                                 std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
-                                std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z){
+                                std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z,
+                                double tensor[6]){ // xx, xy, xz, yy, yz, zz components of tensor
 
          // Here we start
          // initialise temp vectors
@@ -112,13 +112,13 @@ namespace dipole{
           	}
          }
 
-         dipole::internal::rij_tensor_xx[lc][i] =  (tmp_rij_intra_xx);
-         dipole::internal::rij_tensor_xy[lc][i] =  (tmp_rij_intra_xy);
-         dipole::internal::rij_tensor_xz[lc][i] =  (tmp_rij_intra_xz);
+         tensor[0] =  (tmp_rij_intra_xx);
+         tensor[1] =  (tmp_rij_intra_xy);
+         tensor[2] =  (tmp_rij_intra_xz);
 
-         dipole::internal::rij_tensor_yy[lc][i] =  (tmp_rij_intra_yy);
-      	dipole::internal::rij_tensor_yz[lc][i] =  (tmp_rij_intra_yz);
-         dipole::internal::rij_tensor_zz[lc][i] =  (tmp_rij_intra_zz);
+         tensor[3] =  (tmp_rij_intra_yy);
+      	tensor[4] =  (tmp_rij_intra_yz);
+         tensor[5] =  (tmp_rij_intra_zz);
 
          // // Uncomment in case you want to check the tensor components
          // std::cout << "\n############# INTRA ###################\n";
@@ -129,13 +129,13 @@ namespace dipole{
          // std::cout << "\n################################\n";
          // std::cout << std::endl;
 
-      	dipole::internal::rij_tensor_xx[lc][i] = dipole::internal::rij_tensor_xx[lc][i]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
-         dipole::internal::rij_tensor_xy[lc][i] = dipole::internal::rij_tensor_xy[lc][i]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
-         dipole::internal::rij_tensor_xz[lc][i] = dipole::internal::rij_tensor_xz[lc][i]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+      	tensor[0] = tensor[0]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+         tensor[1] = tensor[1]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+         tensor[2] = tensor[2]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
 
-         dipole::internal::rij_tensor_yy[lc][i] = dipole::internal::rij_tensor_yy[lc][i]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
-         dipole::internal::rij_tensor_yz[lc][i] = dipole::internal::rij_tensor_yz[lc][i]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
-         dipole::internal::rij_tensor_zz[lc][i] = dipole::internal::rij_tensor_zz[lc][i]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+         tensor[3] = tensor[3]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+         tensor[4] = tensor[4]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
+         tensor[5] = tensor[5]/(double(cells_num_atoms_in_cell[i]) * double(cells_num_atoms_in_cell[j]));
 
       }  // End of funtion calculating Intra component of dipole tensor
 
@@ -34,8 +34,8 @@ namespace dipole{
       // Function to initialise dipole tensors with default scheme.
       //
       // The tensors between local cells with the cutoff range are calculated
-      // explictly from the atomistic coordinates. Longer range tensors assume
-      // the dipole-dipole form.
+      // explictly from the atomistic coordinates and cached. Longer range
+      // tensors assume the dipole-dipole form.
       //------------------------------------------------------------------------
       void initialize_tensor_solver(const int cells_num_atoms_in_unit_cell,
                                     int cells_num_cells, /// number of macrocells
@@ -156,42 +156,11 @@ namespace dipole{
          // start timer
          timer.start();
 
-         // loop over local cells
-         for(int lc=0;lc<cells_num_local_cells;lc++){
+         // calculate near field tensors, longer range tensors are calculated during update
+         calculate_near_tensors(cells_macro_cell_size, false, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z);
 
-            // print out progress to screen
-            if(fmod(ceil(lc),ceil(cells_num_local_cells)/10.0) == 0) std::cout << "." << std::flush;
-
-            // reference global cell ID
-            //int i = cells_local_cell_array[lc];
-            int i = cells::cell_id_array[lc];
-            if(cells_num_atoms_in_cell[i]>0){
-
-            	// Loop over all other cells to calculate contribution to local cell
-               for(int j=0;j<cells_num_cells;j++){
-
-                  /*==========================================================*/
-                  /* Calculation of inter part of dipolar tensor              */
-                  /*==========================================================*/
-                	if(i!=j && cells_num_atoms_in_cell[j]>0){
-
-                     // calculate inter term of dipolar tensor
-                     compute_inter_tensor(cells_macro_cell_size,i,j,lc,cells_num_atoms_in_cell,cells_atom_in_cell_coords_array_x,cells_atom_in_cell_coords_array_y,cells_atom_in_cell_coords_array_z);
-
-                  } // End of Inter part
-
-                  /*==========================================================*/
-                  /* Calculation of intra part of dipolar tensor              */
-                  /*==========================================================*/
-                  else if( i==j && cells_num_atoms_in_cell[j]>0){
-
-                     //Compute inter component of dipolar tensor
-                     compute_intra_tensor(i,j,lc,cells_num_atoms_in_cell,cells_atom_in_cell_coords_array_x,cells_atom_in_cell_coords_array_y,cells_atom_in_cell_coords_array_z);
-
-                  } // End of Intra part
-               }
-   			}
-   		}
+         // set up compact cell arrays used for the far field during update
+         initialize_compact_cells();
 
          // hold parallel calculation until all processors have completed the dipole calculation
          vmpi::barrier();
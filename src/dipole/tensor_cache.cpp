@@ -0,0 +1,262 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+// Vampire headers
+#include "cells.hpp"
+#include "dipole.hpp"
+#include "vio.hpp"
+
+// dipole module headers
+#include "internal.hpp"
+
+namespace dipole{
+
+   namespace internal{
+
+      //------------------------------------------------------------------------
+      // Function to calculate the point dipole tensor for separation r
+      //------------------------------------------------------------------------
+      void point_dipole_tensor(const double rx, const double ry, const double rz, double tensor[6]){
+
+         const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz); //Reciprocal of the distance
+
+         const double ex = rx*rij;
+         const double ey = ry*rij;
+         const double ez = rz*rij;
+
+         const double rij3 = (rij*rij*rij); // Angstroms
+
+         tensor[0] = ((3.0*ex*ex - 1.0)*rij3);
+         tensor[1] = ( 3.0*ex*ey      )*rij3 ;
+         tensor[2] = ( 3.0*ex*ez      )*rij3 ;
+         tensor[3] = ((3.0*ey*ey - 1.0)*rij3);
+         tensor[4] = ( 3.0*ey*ez      )*rij3 ;
+         tensor[5] = ((3.0*ez*ez - 1.0)*rij3);
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to return the occupancy signature of a cell, given by the
+      // sorted positions of atoms relative to the cell origin (to 1e-4 A).
+      // Cells with the same signature have identical tensors with any other
+      // cell at the same cell offset.
+      //------------------------------------------------------------------------
+      int cell_signature(const int cell,
+                         const double cells_macro_cell_size,
+                         std::vector <int>& cells_num_atoms_in_cell,
+                         std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                         std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                         std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z,
+                         std::map < std::vector <int>, int >& signatures,
+                         std::vector <int>& cell_signature_array){
+
+         // return previously calculated signature
+         if(cell_signature_array[cell] >= 0) return cell_signature_array[cell];
+
+         const int nc[3] = { cells::num_cells_x, cells::num_cells_y, cells::num_cells_z };
+         const double origin[3] = { double(cell/(nc[1]*nc[2]))*cells_macro_cell_size,
+                                     double((cell/nc[2])%nc[1])*cells_macro_cell_size,
+                                     double(cell%nc[2])*cells_macro_cell_size };
+
+         std::vector < std::vector <int> > positions(cells_num_atoms_in_cell[cell], std::vector<int>(3));
+         for(int atom = 0; atom < cells_num_atoms_in_cell[cell]; atom++){
+            positions[atom][0] = int(floor((cells_atom_in_cell_coords_array_x[cell][atom] - origin[0])*1.0e4 + 0.5));
+            positions[atom][1] = int(floor((cells_atom_in_cell_coords_array_y[cell][atom] - origin[1])*1.0e4 + 0.5));
+            positions[atom][2] = int(floor((cells_atom_in_cell_coords_array_z[cell][atom] - origin[2])*1.0e4 + 0.5));
+         }
+         std::sort(positions.begin(), positions.end());
+
+         std::vector<int> signature;
+         signature.reserve(3*positions.size());
+         for(unsigned int atom = 0; atom < positions.size(); atom++){
+            signature.insert(signature.end(), positions[atom].begin(), positions[atom].end());
+         }
+
+         // find existing signature or add a new one
+         std::map < std::vector <int>, int >::iterator it = signatures.find(signature);
+         if(it != signatures.end()){
+            cell_signature_array[cell] = it->second;
+         }
+         else{
+            const int id = signatures.size();
+            signatures[signature] = id;
+            cell_signature_array[cell] = id;
+         }
+
+         return cell_signature_array[cell];
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate near field tensors for local cells.
+      //
+      // Tensors between cells within the cutoff range are calculated
+      // explicitly from the atomistic coordinates, which dominates the
+      // initialisation time. For bulk-like regions every pair of cells at the
+      // same offset has the same tensor, and so tensors are cached by integer
+      // cell offset and the occupancy signatures of both cells. Each unique
+      // tensor is calculated once and each local cell stores a list of
+      // neighbouring cells and tensor ids. Longer range tensors have the
+      // dipole-dipole form and are calculated when needed from the cell
+      // positions. If subtract_kernel is set the point dipole tensor between
+      // the cell centres is subtracted, giving corrections for the fft solver.
+      //------------------------------------------------------------------------
+      void calculate_near_tensors(const double cells_macro_cell_size,
+                                  const bool subtract_kernel,
+                                  std::vector <int>& cells_num_atoms_in_cell,
+                                  std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_x,
+                                  std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_y,
+                                  std::vector < std::vector <double> >& cells_atom_in_cell_coords_array_z){
+
+         const int nc[3] = { cells::num_cells_x, cells::num_cells_y, cells::num_cells_z };
+
+         // Cell positions are magnetic centres of mass, and so range includes
+         // all cells within cutoff
+         dipole::internal::near_range = int(ceil(dipole::cutoff)) + 2;
+         const int range = dipole::internal::near_range;
+
+         std::map < std::vector <int>, int > signatures; // id of each unique cell occupancy
+         std::vector <int> cell_signature_array(dipole::internal::cells_num_cells, -1);
+         std::map < std::vector <int>, int > tensors; // id of each unique (offset, signature i, signature j)
+         std::vector <int> key(5);
+
+         dipole::internal::unique_tensor_array.resize(0);
+         dipole::internal::near_start_index.assign(1, 0);
+         dipole::internal::near_cell_array.resize(0);
+         dipole::internal::near_tensor_id_array.resize(0);
+
+         // loop over local cells
+         for(int lc=0; lc<dipole::internal::cells_num_local_cells; lc++){
+
+            // print out progress to screen
+            if(fmod(ceil(lc),ceil(dipole::internal::cells_num_local_cells)/10.0) == 0) std::cout << "." << std::flush;
+
+            const int i = cells::cell_id_array[lc];
+            if(cells_num_atoms_in_cell[i]>0){
+
+               const int ix = i/(nc[1]*nc[2]);
+               const int iy = (i/nc[2])%nc[1];
+               const int iz = i%nc[2];
+
+               for(int jx = std::max(0, ix-range); jx <= std::min(nc[0]-1, ix+range); jx++){
+                  for(int jy = std::max(0, iy-range); jy <= std::min(nc[1]-1, iy+range); jy++){
+                     for(int jz = std::max(0, iz-range); jz <= std::min(nc[2]-1, iz+range); jz++){
+
+                        const int j = (jx*nc[1] + jy)*nc[2] + jz;
+                        if(cells_num_atoms_in_cell[j] == 0) continue;
+
+                        // If distance between macro-cells > cutoff => dipole-dipole form
+                        if(i != j){
+                           const double rx = cells_pos_and_mom_array[4*j+0] - cells_pos_and_mom_array[4*i+0];
+                           const double ry = cells_pos_and_mom_array[4*j+1] - cells_pos_and_mom_array[4*i+1];
+                           const double rz = cells_pos_and_mom_array[4*j+2] - cells_pos_and_mom_array[4*i+2];
+                           const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz);
+                           if((1.0/rij)/cells_macro_cell_size > dipole::cutoff) continue;
+                        }
+
+                        key[0] = jx - ix;
+                        key[1] = jy - iy;
+                        key[2] = jz - iz;
+                        key[3] = cell_signature(i, cells_macro_cell_size, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z, signatures, cell_signature_array);
+                        key[4] = cell_signature(j, cells_macro_cell_size, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z, signatures, cell_signature_array);
+
+                        // find existing tensor or calculate a new one
+                        int id = 0;
+                        std::map < std::vector <int>, int >::iterator it = tensors.find(key);
+                        if(it != tensors.end()){
+                           id = it->second;
+                        }
+                        else{
+                           double tensor[6];
+                           if(i == j) compute_intra_tensor(i, j, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z, tensor);
+                           else compute_inter_tensor(cells_macro_cell_size, i, j, cells_num_atoms_in_cell, cells_atom_in_cell_coords_array_x, cells_atom_in_cell_coords_array_y, cells_atom_in_cell_coords_array_z, tensor);
+
+                           if(subtract_kernel && i != j){
+                              double kernel[6];
+                              point_dipole_tensor(double(key[0])*cells_macro_cell_size, double(key[1])*cells_macro_cell_size, double(key[2])*cells_macro_cell_size, kernel);
+                              for(int c = 0; c < 6; c++) tensor[c] -= kernel[c];
+                           }
+
+                           id = tensors.size();
+                           tensors[key] = id;
+                           dipole::internal::unique_tensor_array.insert(dipole::internal::unique_tensor_array.end(), tensor, tensor+6);
+                        }
+
+                        dipole::internal::near_cell_array.push_back(j);
+                        dipole::internal::near_tensor_id_array.push_back(id);
+
+                     }
+                  }
+               }
+            }
+            dipole::internal::near_start_index.push_back(dipole::internal::near_cell_array.size());
+         }
+
+         const double memory = double(dipole::internal::unique_tensor_array.size())*sizeof(double) + double(dipole::internal::near_start_index.size() + 2*dipole::internal::near_cell_array.size())*sizeof(int);
+
+         zlog << zTs() << "Number of unique cell occupancies: " << signatures.size() << std::endl;
+         zlog << zTs() << "Near field tensors for local cells: " << dipole::internal::near_cell_array.size() << " (" << tensors.size() << " unique)" << std::endl;
+         zlog << zTs() << "Memory required for near field tensors: " << memory/1.0e6 << " MB" << std::endl;
+
+         return;
+
+      }
+
+      //------------------------------------------------------------------------
+      // Function to calculate sum of dipole tensors for each local cell,
+      // weighted by the number of atoms in each cell, for calculation of the
+      // demagnetisation tensor with the tensor solver
+      //------------------------------------------------------------------------
+      void calculate_tensor_demag_tensor(std::vector<double>& N_tensor_array){
+
+         for(int lc=0; lc<dipole::internal::cells_num_local_cells; lc++){
+
+            const int i = cells::cell_id_array[lc];
+            if(dipole::internal::cells_num_atoms_in_cell[i]>0){
+
+               int near = dipole::internal::near_start_index[lc];
+
+               for(int j=0; j<dipole::internal::cells_num_cells; j++){
+                  if(dipole::internal::cells_num_atoms_in_cell[j]>0){
+
+                     double tensor[6];
+                     if(near < dipole::internal::near_start_index[lc+1] && dipole::internal::near_cell_array[near] == j){
+                        const int id = dipole::internal::near_tensor_id_array[near];
+                        for(int c = 0; c < 6; c++) tensor[c] = dipole::internal::unique_tensor_array[6*id+c];
+                        near++;
+                     }
+                     else{
+                        point_dipole_tensor(cells_pos_and_mom_array[4*j+0] - cells_pos_and_mom_array[4*i+0],
+                                            cells_pos_and_mom_array[4*j+1] - cells_pos_and_mom_array[4*i+1],
+                                            cells_pos_and_mom_array[4*j+2] - cells_pos_and_mom_array[4*i+2], tensor);
+                     }
+
+                     const double factor = double(dipole::internal::cells_num_atoms_in_cell[j]) * double(dipole::internal::cells_num_atoms_in_cell[i]);
+                     for(int c = 0; c < 6; c++) N_tensor_array[6*i+c] += factor*tensor[c];
+
+                  }
+               }
+            }
+         }
+
+         return;
+
+      }
+
+   } // end of namespace internal
+
+} // end of namespace dipole
@@ -34,6 +34,89 @@ namespace dipole{
    //-----------------------------------------------------------------------------
 
 
+   //-----------------------------------------------------------------------------
+   // Function to add the field from cells start to end-1 using the dipole-dipole
+   // form between cell centres of mass. Written without branches so that the
+   // loop is vectorised.
+   //-----------------------------------------------------------------------------
+   void far_field(const int start, const int end,
+                  const double xi, const double yi, const double zi,
+                  const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z,
+                  const std::vector<double>& mx, const std::vector<double>& my, const std::vector<double>& mz,
+                  double sum[3]){
+
+      double sum_x = 0.0;
+      double sum_y = 0.0;
+      double sum_z = 0.0;
+
+      #pragma omp simd reduction(+:sum_x,sum_y,sum_z)
+      for(int j = start; j < end; j++){
+
+         const double rx = x[j] - xi;
+         const double ry = y[j] - yi;
+         const double rz = z[j] - zi;
+
+         const double rij = 1.0/sqrt(rx*rx+ry*ry+rz*rz); //Reciprocal of the distance
+
+         const double ex = rx*rij;
+         const double ey = ry*rij;
+         const double ez = rz*rij;
+
+         const double rij3 = (rij*rij*rij); // Angstroms
+
+         const double txx = ((3.0*ex*ex - 1.0)*rij3);
+         const double txy = ( 3.0*ex*ey      )*rij3 ;
+         const double txz = ( 3.0*ex*ez      )*rij3 ;
+         const double tyy = ((3.0*ey*ey - 1.0)*rij3);
+         const double tyz = ( 3.0*ey*ez      )*rij3 ;
+         const double tzz = ((3.0*ez*ez - 1.0)*rij3);
+
+         sum_x += (mx[j]*txx + my[j]*txy + mz[j]*txz);
+         sum_y += (mx[j]*txy + my[j]*tyy + mz[j]*tyz);
+         sum_z += (mx[j]*txz + my[j]*tyz + mz[j]*tzz);
+
+      }
+
+      sum[0] += sum_x;
+      sum[1] += sum_y;
+      sum[2] += sum_z;
+
+      return;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to set up compact arrays of positions of non-empty cells for the
+   // tensor solver. Cell positions are fixed, so only the moments are updated
+   // in update_field().
+   //-----------------------------------------------------------------------------
+   void dipole::internal::initialize_compact_cells(){
+
+      dipole::internal::compact_cell_id.assign(dipole::internal::cells_num_cells, 0);
+      dipole::internal::compact_x.clear();
+      dipole::internal::compact_y.clear();
+      dipole::internal::compact_z.clear();
+
+      int num_compact = 0;
+      for(int j=0;j<dipole::internal::cells_num_cells;j++){
+         if(dipole::internal::cells_num_atoms_in_cell[j]>0){
+            dipole::internal::compact_cell_id[j] = num_compact;
+            dipole::internal::compact_x.push_back(dipole::internal::cells_pos_and_mom_array[4*j+0]);
+            dipole::internal::compact_y.push_back(dipole::internal::cells_pos_and_mom_array[4*j+1]);
+            dipole::internal::compact_z.push_back(dipole::internal::cells_pos_and_mom_array[4*j+2]);
+            num_compact++;
+         }
+      }
+
+      dipole::internal::num_compact_cells = num_compact;
+      dipole::internal::compact_mx.assign(num_compact, 0.0);
+      dipole::internal::compact_my.assign(num_compact, 0.0);
+      dipole::internal::compact_mz.assign(num_compact, 0.0);
+
+      return;
+
+   }
+
 	void dipole::internal::update_field(){
 
       if(!dipole::activated) return;
@@ -47,6 +130,29 @@ namespace dipole{
       // Define constant imuB = 1/muB to normalise to unitarian values the cell magnetisation
       const double imuB = 1.0/9.27400915e-24;
 
+      // Compact arrays of positions and normalised moments of non-empty cells
+      // for the tensor solver
+      const std::vector<int>& compact_id = dipole::internal::compact_cell_id;
+      const std::vector<double>& x = dipole::internal::compact_x;
+      const std::vector<double>& y = dipole::internal::compact_y;
+      const std::vector<double>& z = dipole::internal::compact_z;
+      std::vector<double>& mx = dipole::internal::compact_mx;
+      std::vector<double>& my = dipole::internal::compact_my;
+      std::vector<double>& mz = dipole::internal::compact_mz;
+      const int num_compact = dipole::internal::num_compact_cells;
+
+      // update moments of non-empty cells
+      if(dipole::internal::solver != dipole::internal::macrocell){
+         for(int j=0;j<dipole::internal::cells_num_cells;j++){
+            if(dipole::internal::cells_num_atoms_in_cell[j]>0){
+               const int cj = compact_id[j];
+               mx[cj] = cells::mag_array_x[j]*imuB;
+               my[cj] = cells::mag_array_y[j]*imuB;
+               mz[cj] = cells::mag_array_z[j]*imuB;
+            }
+         }
+      }
+
 		// loop over local cells
     	for(int lc=0;lc<dipole::internal::cells_num_local_cells;lc++){
 
@@ -64,43 +170,206 @@ namespace dipole{
             const double mz_i = cells::mag_array_z[i]*imuB;
 
             // Add self-demagnetisation as mu_0/4_PI * 8PI*m_cell/3V
-            dipole::cells_field_array_x[i] = self_demag * mx_i*0.0; //*0.0
-            dipole::cells_field_array_y[i] = self_demag * my_i*0.0; //*0.0
-            dipole::cells_field_array_z[i] = self_demag * mz_i*0.0; //*0.0
+            // (fields are accumulated locally to avoid repeated stores to the global arrays)
+            double field_x = self_demag * mx_i*0.0; //*0.0
+            double field_y = self_demag * my_i*0.0; //*0.0
+            double field_z = self_demag * mz_i*0.0; //*0.0
             // Add self demag to Hdemag --> To get only dipole-dipole contribution comment this and initialise to zero
-            dipole::cells_mu0Hd_field_array_x[i] = -0.5*self_demag * mx_i;
-            dipole::cells_mu0Hd_field_array_y[i] = -0.5*self_demag * my_i;
-            dipole::cells_mu0Hd_field_array_z[i] = -0.5*self_demag * mz_i;
-
-            // Loop over all other cells to calculate contribution to local cell
-            for(int j=0;j<dipole::internal::cells_num_cells;j++){
-         	   if(dipole::internal::cells_num_atoms_in_cell[j]>0){
-
-                  // Normalise the cell magnetisation by the Bohr magneton
-         		   const double mx = cells::mag_array_x[j]*imuB;
-         		   const double my = cells::mag_array_y[j]*imuB;
-         		   const double mz = cells::mag_array_z[j]*imuB;
-
-             		dipole::cells_field_array_x[i]+=(mx*internal::rij_tensor_xx[lc][j] + my*internal::rij_tensor_xy[lc][j] + mz*internal::rij_tensor_xz[lc][j]);
-             		dipole::cells_field_array_y[i]+=(mx*internal::rij_tensor_xy[lc][j] + my*internal::rij_tensor_yy[lc][j] + mz*internal::rij_tensor_yz[lc][j]);
-             		dipole::cells_field_array_z[i]+=(mx*internal::rij_tensor_xz[lc][j] + my*internal::rij_tensor_yz[lc][j] + mz*internal::rij_tensor_zz[lc][j]);
-                  // Demag field
-                  dipole::cells_mu0Hd_field_array_x[i] +=(mx*internal::rij_tensor_xx[lc][j] + my*internal::rij_tensor_xy[lc][j] + mz*internal::rij_tensor_xz[lc][j]);
-                  dipole::cells_mu0Hd_field_array_y[i] +=(mx*internal::rij_tensor_xy[lc][j] + my*internal::rij_tensor_yy[lc][j] + mz*internal::rij_tensor_yz[lc][j]);
-                  dipole::cells_mu0Hd_field_array_z[i] +=(mx*internal::rij_tensor_xz[lc][j] + my*internal::rij_tensor_yz[lc][j] + mz*internal::rij_tensor_zz[lc][j]);
-         	   }
+            double mu0Hd_x = -0.5*self_demag * mx_i;
+            double mu0Hd_y = -0.5*self_demag * my_i;
+            double mu0Hd_z = -0.5*self_demag * mz_i;
+
+            // macrocell solver stores all tensors
+            if(dipole::internal::solver == dipole::internal::macrocell){
+
+               // Loop over all other cells to calculate contribution to local cell
+               for(int j=0;j<dipole::internal::cells_num_cells;j++){
+            	   if(dipole::internal::cells_num_atoms_in_cell[j]>0){
+
+                     // Normalise the cell magnetisation by the Bohr magneton
+            		   const double mx = cells::mag_array_x[j]*imuB;
+            		   const double my = cells::mag_array_y[j]*imuB;
+            		   const double mz = cells::mag_array_z[j]*imuB;
+
+                		field_x+=(mx*internal::rij_tensor_xx[lc][j] + my*internal::rij_tensor_xy[lc][j] + mz*internal::rij_tensor_xz[lc][j]);
+                		field_y+=(mx*internal::rij_tensor_xy[lc][j] + my*internal::rij_tensor_yy[lc][j] + mz*internal::rij_tensor_yz[lc][j]);
+                		field_z+=(mx*internal::rij_tensor_xz[lc][j] + my*internal::rij_tensor_yz[lc][j] + mz*internal::rij_tensor_zz[lc][j]);
+                     // Demag field
+                     mu0Hd_x +=(mx*internal::rij_tensor_xx[lc][j] + my*internal::rij_tensor_xy[lc][j] + mz*internal::rij_tensor_xz[lc][j]);
+                     mu0Hd_y +=(mx*internal::rij_tensor_xy[lc][j] + my*internal::rij_tensor_yy[lc][j] + mz*internal::rij_tensor_yz[lc][j]);
+                     mu0Hd_z +=(mx*internal::rij_tensor_xz[lc][j] + my*internal::rij_tensor_yz[lc][j] + mz*internal::rij_tensor_zz[lc][j]);
+            	   }
+               }
+
+            }
+            // tensor solver calculates dipole-dipole form between cell centres
+            // of mass for all cells and then corrects the cached near cells
+            else{
+
+               const double xi = dipole::internal::cells_pos_and_mom_array[4*i+0];
+               const double yi = dipole::internal::cells_pos_and_mom_array[4*i+1];
+               const double zi = dipole::internal::cells_pos_and_mom_array[4*i+2];
+
+               double sum[3] = {0.0, 0.0, 0.0};
+               far_field(0, compact_id[i], xi, yi, zi, x, y, z, mx, my, mz, sum);
+               far_field(compact_id[i]+1, num_compact, xi, yi, zi, x, y, z, mx, my, mz, sum);
+
+               for(int near = dipole::internal::near_start_index[lc]; near < dipole::internal::near_start_index[lc+1]; near++){
+
+                  const int j = dipole::internal::near_cell_array[near];
+                  const int cj = compact_id[j];
+                  const double* t = &dipole::internal::unique_tensor_array[6*dipole::internal::near_tensor_id_array[near]];
+
+                  double tensor[6] = { t[0], t[1], t[2], t[3], t[4], t[5] };
+
+                  // remove dipole-dipole form already included above
+                  if(j != i){
+                     double far[6];
+                     dipole::internal::point_dipole_tensor(x[cj] - xi, y[cj] - yi, z[cj] - zi, far);
+                     for(int c = 0; c < 6; c++) tensor[c] -= far[c];
+                  }
+
+                  sum[0] += (mx[cj]*tensor[0] + my[cj]*tensor[1] + mz[cj]*tensor[2]);
+                  sum[1] += (mx[cj]*tensor[1] + my[cj]*tensor[3] + mz[cj]*tensor[4]);
+                  sum[2] += (mx[cj]*tensor[2] + my[cj]*tensor[4] + mz[cj]*tensor[5]);
+
+               }
+
+               field_x += sum[0];
+               field_y += sum[1];
+               field_z += sum[2];
+               // Demag field
+               mu0Hd_x += sum[0];
+               mu0Hd_y += sum[1];
+               mu0Hd_z += sum[2];
+
             }
+
             // Multiply the cells B-field by mu_B * mu_0/(4*pi) /1e-30  <-- (9.27400915e-24 * 1e-7 / 1e30)
             // where the last term accounts for the fact that the volume was calculated in Angstrom
-            dipole::cells_field_array_x[i] = dipole::cells_field_array_x[i] * 9.27400915e-01;
-            dipole::cells_field_array_y[i] = dipole::cells_field_array_y[i] * 9.27400915e-01;
-            dipole::cells_field_array_z[i] = dipole::cells_field_array_z[i] * 9.27400915e-01;
+            dipole::cells_field_array_x[i] = field_x * 9.27400915e-01;
+            dipole::cells_field_array_y[i] = field_y * 9.27400915e-01;
+            dipole::cells_field_array_z[i] = field_z * 9.27400915e-01;
             // Multiply Hdemg by mu_0/4pi * 1e30 * mu_B to account for normalisation
             // of magnetisation and volume in angstrom
-            dipole::cells_mu0Hd_field_array_x[i] = dipole::cells_mu0Hd_field_array_x[i] * 9.27400915e-01;
-            dipole::cells_mu0Hd_field_array_y[i] = dipole::cells_mu0Hd_field_array_y[i] * 9.27400915e-01;
-            dipole::cells_mu0Hd_field_array_z[i] = dipole::cells_mu0Hd_field_array_z[i] * 9.27400915e-01;
+            dipole::cells_mu0Hd_field_array_x[i] = mu0Hd_x * 9.27400915e-01;
+            dipole::cells_mu0Hd_field_array_y[i] = mu0Hd_y * 9.27400915e-01;
+            dipole::cells_mu0Hd_field_array_z[i] = mu0Hd_z * 9.27400915e-01;
      		}
     	}
 	} // end of dipole::internal::update_field() function
+
+   //-----------------------------------------------------------------------------
+   // Function to update the fields in local cells for a change dm (in Bohr
+   // magnetons) of the moment of cell j. Since the fields are linear in the
+   // cell moments the result is the same as a full update, apart from
+   // rounding, at a cost proportional to the number of cells. Used for per
+   // move updates with the serial Monte Carlo integrator.
+   //-----------------------------------------------------------------------------
+   void dipole::internal::update_field_for_moment_change(const int j, const double dmx, const double dmy, const double dmz){
+
+      // Multiply fields by mu_B * mu_0/(4*pi) /1e-30 as in update_field()
+      const double factor = 9.27400915e-01;
+
+      // Self demagnetisation contributes only to Hdemag
+      const double self_demag = 8.0*M_PI/(3.0*dipole::internal::cells_volume_array[j]);
+      dipole::cells_mu0Hd_field_array_x[j] -= 0.5*self_demag * dmx * factor;
+      dipole::cells_mu0Hd_field_array_y[j] -= 0.5*self_demag * dmy * factor;
+      dipole::cells_mu0Hd_field_array_z[j] -= 0.5*self_demag * dmz * factor;
+
+      // macrocell solver stores all tensors
+      if(dipole::internal::solver == dipole::internal::macrocell){
+
+         for(int lc=0;lc<dipole::internal::cells_num_local_cells;lc++){
+
+            const int i = cells::cell_id_array[lc];
+
+            if(dipole::internal::cells_num_atoms_in_cell[i]>0){
+
+               const double bx = (dmx*internal::rij_tensor_xx[lc][j] + dmy*internal::rij_tensor_xy[lc][j] + dmz*internal::rij_tensor_xz[lc][j]) * factor;
+               const double by = (dmx*internal::rij_tensor_xy[lc][j] + dmy*internal::rij_tensor_yy[lc][j] + dmz*internal::rij_tensor_yz[lc][j]) * factor;
+               const double bz = (dmx*internal::rij_tensor_xz[lc][j] + dmy*internal::rij_tensor_yz[lc][j] + dmz*internal::rij_tensor_zz[lc][j]) * factor;
+
+               dipole::cells_field_array_x[i] += bx;
+               dipole::cells_field_array_y[i] += by;
+               dipole::cells_field_array_z[i] += bz;
+               dipole::cells_mu0Hd_field_array_x[i] += bx;
+               dipole::cells_mu0Hd_field_array_y[i] += by;
+               dipole::cells_mu0Hd_field_array_z[i] += bz;
+
+            }
+         }
+
+      }
+      // tensor solver uses dipole-dipole form between cell centres of mass,
+      // corrected by the cached tensors for cells near to j
+      else{
+
+         const double xj = dipole::internal::cells_pos_and_mom_array[4*j+0];
+         const double yj = dipole::internal::cells_pos_and_mom_array[4*j+1];
+         const double zj = dipole::internal::cells_pos_and_mom_array[4*j+2];
+
+         for(int lc=0;lc<dipole::internal::cells_num_local_cells;lc++){
+
+            const int i = cells::cell_id_array[lc];
+
+            if(dipole::internal::cells_num_atoms_in_cell[i]>0 && i != j){
+
+               double tensor[6];
+               dipole::internal::point_dipole_tensor(xj - dipole::internal::cells_pos_and_mom_array[4*i+0],
+                                                     yj - dipole::internal::cells_pos_and_mom_array[4*i+1],
+                                                     zj - dipole::internal::cells_pos_and_mom_array[4*i+2], tensor);
+
+               const double bx = (dmx*tensor[0] + dmy*tensor[1] + dmz*tensor[2]) * factor;
+               const double by = (dmx*tensor[1] + dmy*tensor[3] + dmz*tensor[4]) * factor;
+               const double bz = (dmx*tensor[2] + dmy*tensor[4] + dmz*tensor[5]) * factor;
+
+               dipole::cells_field_array_x[i] += bx;
+               dipole::cells_field_array_y[i] += by;
+               dipole::cells_field_array_z[i] += bz;
+               dipole::cells_mu0Hd_field_array_x[i] += bx;
+               dipole::cells_mu0Hd_field_array_y[i] += by;
+               dipole::cells_mu0Hd_field_array_z[i] += bz;
+
+            }
+         }
+
+         // Near field tensors are symmetric (T_ij = T_ji), and so the cells
+         // near to j are given by the near list of j
+         const int lcj = dipole::internal::cell_local_index_array[j];
+
+         for(int near = dipole::internal::near_start_index[lcj]; near < dipole::internal::near_start_index[lcj+1]; near++){
+
+            const int i = dipole::internal::near_cell_array[near];
+            const double* t = &dipole::internal::unique_tensor_array[6*dipole::internal::near_tensor_id_array[near]];
+
+            double tensor[6] = { t[0], t[1], t[2], t[3], t[4], t[5] };
+
+            // remove dipole-dipole form already included above
+            if(i != j){
+               double far[6];
+               dipole::internal::point_dipole_tensor(xj - dipole::internal::cells_pos_and_mom_array[4*i+0],
+                                                     yj - dipole::internal::cells_pos_and_mom_array[4*i+1],
+                                                     zj - dipole::internal::cells_pos_and_mom_array[4*i+2], far);
+               for(int c = 0; c < 6; c++) tensor[c] -= far[c];
+            }
+
+            const double bx = (dmx*tensor[0] + dmy*tensor[1] + dmz*tensor[2]) * factor;
+            const double by = (dmx*tensor[1] + dmy*tensor[3] + dmz*tensor[4]) * factor;
+            const double bz = (dmx*tensor[2] + dmy*tensor[4] + dmz*tensor[5]) * factor;
+
+            dipole::cells_field_array_x[i] += bx;
+            dipole::cells_field_array_y[i] += by;
+            dipole::cells_field_array_z[i] += bz;
+            dipole::cells_mu0Hd_field_array_x[i] += bx;
+            dipole::cells_mu0Hd_field_array_y[i] += by;
+            dipole::cells_mu0Hd_field_array_z[i] += bz;
+
+         }
+
+      }
+
+      return;
+
+   }
 } // end of dipole namespace
@@ -57,6 +57,40 @@ namespace exchange{
 
    }
 
+   //-----------------------------------------------------------------------------------------
+   // Function to calculate change in biquadratic exchange energy for spin atom from old to
+   // new direction in a single pass over the neighbours
+   //-----------------------------------------------------------------------------------------
+   double single_spin_biquadratic_energy_difference(const int atom, const double old_spin[3], const double new_spin[3]){
+
+      // if biquadratic exchange not enabled do nothing
+      if(!exchange::biquadratic) return 0.0;
+
+      // only isotropic biquadratic exchange is implemented
+      if(internal::biquadratic_exchange_type != exchange::isotropic) return 0.0;
+
+      double energy = 0.0;
+
+      for(int nn = internal::biquadratic_neighbour_list_start_index[atom]; nn <= internal::biquadratic_neighbour_list_end_index[atom]; ++nn){
+
+         const int natom = internal::biquadratic_neighbour_list_array[nn];
+         const double Jbq = internal::bq_i_exchange_list[ internal::biquadratic_neighbour_interaction_type_array[nn] ].Jij;
+
+         const double sjx = atoms::x_spin_array[natom];
+         const double sjy = atoms::y_spin_array[natom];
+         const double sjz = atoms::z_spin_array[natom];
+
+         const double old_dot_sj = old_spin[0]*sjx + old_spin[1]*sjy + old_spin[2]*sjz;
+         const double new_dot_sj = new_spin[0]*sjx + new_spin[1]*sjy + new_spin[2]*sjz;
+
+         energy -= Jbq * (new_dot_sj * new_dot_sj - old_dot_sj * old_dot_sj);
+
+      }
+
+      return energy;
+
+   }
+
    //-----------------------------------------------------------------------------------------
    // Function to calculate biquadratic exchange energy for spin atom
    //-----------------------------------------------------------------------------------------
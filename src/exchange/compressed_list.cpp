@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <map>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "exchange.hpp"
+#include "gpu.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+namespace exchange{
+
+namespace internal{
+
+   //-----------------------------------------------------------------------------
+   // Function to return the exchange constants for an interaction type
+   //-----------------------------------------------------------------------------
+   std::vector<double> exchange_constants(const int type){
+
+      switch(internal::exchange_type){
+
+         case exchange::isotropic:
+            return std::vector<double>(1, atoms::i_exchange_list[type].Jij);
+
+         case exchange::vectorial:
+            return std::vector<double>(atoms::v_exchange_list[type].Jij, atoms::v_exchange_list[type].Jij+3);
+
+         case exchange::tensorial:
+            return std::vector<double>(&atoms::t_exchange_list[type].Jij[0][0], &atoms::t_exchange_list[type].Jij[0][0]+9);
+
+      }
+
+      return std::vector<double>(0);
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to compress the neighbour list into shared stencils. In a crystal
+   // most atoms have the same neighbours relative to their own atom number, and
+   // so each unique list of (neighbour offset, interaction type) pairs is stored
+   // only once, with a single stencil number saved for each atom. Atoms at
+   // surfaces, interfaces or near missing atoms generate additional stencils.
+   // Interaction types with identical exchange constants (as produced by
+   // unrolling normalised exchange) are merged so that they share stencils.
+   // The standard list is kept if the stencils do not save at least 3/4 of it.
+   //-----------------------------------------------------------------------------
+   void compress_neighbour_list(){
+
+      if(!internal::compressed_neighbour_list) return;
+
+      const int num_atoms = atoms::num_atoms;
+      const uint64_t num_interactions = atoms::neighbour_list_array.size();
+
+      // determine number of interaction types
+      int num_types = 0;
+      switch(internal::exchange_type){
+         case exchange::isotropic: num_types = atoms::i_exchange_list.size(); break;
+         case exchange::vectorial: num_types = atoms::v_exchange_list.size(); break;
+         case exchange::tensorial: num_types = atoms::t_exchange_list.size(); break;
+      }
+
+      // merge interaction types with identical exchange constants
+      std::map<std::vector<double>, int> unique_constants; // unique type for each set of exchange constants
+      std::vector<int> unique_type(num_types); // unique type for each interaction type
+      std::vector<int> first_type; // first interaction type for each unique type
+      for(int type = 0; type < num_types; type++){
+         const std::vector<double> constants = exchange_constants(type);
+         std::map<std::vector<double>, int>::iterator it = unique_constants.find(constants);
+         if(it != unique_constants.end()){
+            unique_type[type] = it->second;
+         }
+         else{
+            unique_type[type] = first_type.size();
+            unique_constants[constants] = first_type.size();
+            first_type.push_back(type);
+         }
+      }
+      std::map<std::vector<double>, int>().swap(unique_constants);
+
+      std::map<std::vector<int>, int> stencils; // stencil number for each unique neighbour pattern
+      std::vector<int> pattern; // (offset, type) pairs for current atom
+
+      internal::neighbour_stencil_id.resize(num_atoms);
+      internal::stencil_start_index.assign(1, 0);
+      internal::stencil_offset_array.resize(0);
+      internal::stencil_type_array.resize(0);
+
+      bool compressible = true;
+
+      for(int atom = 0; atom < num_atoms; atom++){
+
+         // determine neighbour pattern for atom
+         pattern.resize(0);
+         for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; nn++){
+            pattern.push_back(atoms::neighbour_list_array[nn] - atom);
+            pattern.push_back(unique_type[atoms::neighbour_interaction_type_array[nn]]);
+         }
+
+         // find existing stencil or add a new one
+         std::map<std::vector<int>, int>::iterator it = stencils.find(pattern);
+         if(it != stencils.end()){
+            internal::neighbour_stencil_id[atom] = it->second;
+            continue;
+         }
+
+         const int id = stencils.size();
+         stencils[pattern] = id;
+         for(unsigned int i = 0; i < pattern.size(); i += 2){
+            internal::stencil_offset_array.push_back(pattern[i]);
+            internal::stencil_type_array.push_back(pattern[i+1]);
+         }
+         internal::stencil_start_index.push_back(internal::stencil_offset_array.size());
+         internal::neighbour_stencil_id[atom] = id;
+
+         // stop if stencils are too large to be worthwhile (eg unrolled exchange)
+         if(4*internal::stencil_offset_array.size() > num_interactions){
+            compressible = false;
+            break;
+         }
+
+      }
+
+      if(!compressible){
+         zlog << zTs() << "Neighbour list is not regular enough to be compressed, using standard neighbour list" << std::endl;
+         internal::compressed_neighbour_list = false;
+         std::vector<int>().swap(internal::neighbour_stencil_id);
+         std::vector<int>().swap(internal::stencil_start_index);
+         std::vector<int>().swap(internal::stencil_offset_array);
+         std::vector<int>().swap(internal::stencil_type_array);
+         return;
+      }
+
+      // release excess capacity of stencil arrays
+      std::vector<int>(internal::stencil_start_index).swap(internal::stencil_start_index);
+      std::vector<int>(internal::stencil_offset_array).swap(internal::stencil_offset_array);
+      std::vector<int>(internal::stencil_type_array).swap(internal::stencil_type_array);
+
+      const double standard_bytes = (2.0*double(num_atoms) + 2.0*double(num_interactions))*sizeof(int);
+      const double compressed_bytes = (double(num_atoms) + double(internal::stencil_start_index.size()) + 2.0*double(internal::stencil_offset_array.size()))*sizeof(int);
+
+      zlog << zTs() << "Neighbour list compressed into " << stencils.size() << " stencils with " << internal::stencil_offset_array.size() << " interactions" << std::endl;
+      zlog << zTs() << "Memory required for neighbour list reduced from " << standard_bytes*1.0e-6 << " MB to " << compressed_bytes*1.0e-6 << " MB RAM (" << standard_bytes/compressed_bytes << "x)" << std::endl;
+
+      // free standard list unless needed by GPU or setting program
+      if(!gpu::acceleration && sim::program != 51){
+
+         std::vector<int>().swap(atoms::neighbour_list_array);
+         std::vector<int>().swap(atoms::neighbour_interaction_type_array);
+         std::vector<int>().swap(atoms::neighbour_list_start_index);
+         std::vector<int>().swap(atoms::neighbour_list_end_index);
+
+         // keep only unique exchange constants, which are numbered by unique type
+         const unsigned int num_unique = first_type.size();
+         switch(internal::exchange_type){
+            case exchange::isotropic:{
+               std::vector<zval_t> list(num_unique);
+               for(unsigned int i = 0; i < num_unique; i++) list[i] = atoms::i_exchange_list[first_type[i]];
+               atoms::i_exchange_list.swap(list);
+               break;
+            }
+            case exchange::vectorial:{
+               std::vector<zvec_t> list(num_unique);
+               for(unsigned int i = 0; i < num_unique; i++) list[i] = atoms::v_exchange_list[first_type[i]];
+               atoms::v_exchange_list.swap(list);
+               break;
+            }
+            case exchange::tensorial:{
+               std::vector<zten_t> list(num_unique);
+               for(unsigned int i = 0; i < num_unique; i++) list[i] = atoms::t_exchange_list[first_type[i]];
+               atoms::t_exchange_list.swap(list);
+               break;
+            }
+         }
+         zlog << zTs() << "Exchange constant list reduced from " << num_types << " to " << num_unique << " interaction types" << std::endl;
+
+      }
+      // otherwise refer to original interaction types
+      else{
+         for(unsigned int i = 0; i < internal::stencil_type_array.size(); i++){
+            internal::stencil_type_array[i] = first_type[internal::stencil_type_array[i]];
+         }
+      }
+
+      return;
+
+   }
+
+} // end of internal namespace
+
+} // end of exchange namespace
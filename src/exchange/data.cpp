@@ -41,6 +41,17 @@ namespace exchange{
 
       exchange_t minimum_needed_exchange_type = isotropic; // minimum support required for bilinear exchange type (for vectorial constants and DMI)
 
+      simd_t simd_kernel = simd_scalar; // kernel used for isotropic exchange field calculation
+      std::vector <int> simd_slice_start(0); // first slot in sliced neighbour list for each slice of atoms
+      std::vector <int> simd_neighbour_array(0); // neighbour list interleaved between atoms in each slice
+      std::vector <double> simd_jij_array(0); // isotropic exchange constant for each slot in sliced neighbour list
+
+      bool compressed_neighbour_list = false; // flag to store neighbour list as shared stencils of relative neighbour offsets
+      std::vector <int> neighbour_stencil_id(0); // stencil of neighbour offsets for each atom
+      std::vector <int> stencil_start_index(0); // first entry of each stencil (last +1 is start of next stencil)
+      std::vector <int> stencil_offset_array(0); // neighbour atom number relative to atom for each stencil entry
+      std::vector <int> stencil_type_array(0); // interaction type for each stencil entry
+
       bool use_material_exchange_constants = true; // flag to enable material exchange parameters
       bool use_material_biquadratic_exchange_constants = true; // flag to enable material biquadratic exchange parameters
 
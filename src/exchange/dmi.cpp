@@ -43,7 +43,7 @@ namespace internal{
    // within their respective cutoff ranges for i-k and j-k interactions.
    //
    //------------------------------------------------------------------------------
-   void calculate_dmi(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist){
+   void calculate_dmi(neighbours::list_t& cneighbourlist){
 
       // if dmi is not needed then do nothing
       if(!internal::enable_dmi) return;
@@ -71,10 +71,10 @@ namespace internal{
          const double i_mu_s = 1.0/mp::material[imat].mu_s_SI;
 
          // loop over all neighbours j
-         for(unsigned int j = 0; j < cneighbourlist[i].size(); j++){
+         for(uint64_t j = cneighbourlist.start_index[i]; j < cneighbourlist.start_index[i+1]; j++){
 
             // get atom number for neighbour i
-            const unsigned int nj = cneighbourlist[i][j].nn;
+            const unsigned int nj = cneighbourlist.nn[j];
 
             // get material id for j atom
             const unsigned int jmat = atoms::type_array[nj];
@@ -86,10 +86,10 @@ namespace internal{
             if(i != nj){
                // for each interaction j loop over all neighbours k to calculate
                // mediated interactions within cutoff range
-               for(unsigned int k = 0; k < cneighbourlist[i].size(); k++){
+               for(uint64_t k = cneighbourlist.start_index[i]; k < cneighbourlist.start_index[i+1]; k++){
 
                   // get atom number for neighbour k
-                  const unsigned int nk = cneighbourlist[i][k].nn;
+                  const unsigned int nk = cneighbourlist.nn[k];
 
                   // ignore self interaction
                   if(nj != nk){
@@ -98,11 +98,13 @@ namespace internal{
                      const unsigned int kmat = atoms::type_array[nk];
 
                      // get atomic position vector i->k
-                     double eik[3]={cneighbourlist[i][k].vx, cneighbourlist[i][k].vy, cneighbourlist[i][k].vz};
+                     double eik[3];
+                     cneighbourlist.vector(k, i, atoms::x_coord_array, atoms::y_coord_array, atoms::z_coord_array, eik[0], eik[1], eik[2]);
                      const double mod_eik_sq = eik[0]*eik[0] + eik[1]*eik[1] + eik[2]*eik[2];
 
                      // get atomic position vector i->j
-                     double eij[3]={cneighbourlist[i][j].vx, cneighbourlist[i][j].vy, cneighbourlist[i][j].vz};
+                     double eij[3];
+                     cneighbourlist.vector(j, i, atoms::x_coord_array, atoms::y_coord_array, atoms::z_coord_array, eij[0], eij[1], eij[2]);
 
                      // calculate ejk from vector addition eik - eij
                      double ejk[3]={eik[0] - eij[0], eik[1] - eij[1], eik[2] - eij[2]};
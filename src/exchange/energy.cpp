@@ -24,16 +24,17 @@ namespace exchange{
    //---------------------------------------------------------------------------
    // Calculate isotropic exchange energy for a single spin
    //---------------------------------------------------------------------------
-   double spin_exchange_energy_isotropic(const int atom, const double sx, const double sy, const double sz){
+   template <class list_t>
+   double spin_exchange_energy_isotropic(const list_t& neighbours, const int atom, const double sx, const double sy, const double sz){
 
    	// energy
    	double energy=0.0;
 
    	// Loop over neighbouring spins to calculate exchange
-   	for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; ++nn){
+   	for(int nn = neighbours.start(atom); nn < neighbours.end(atom); ++nn){
 
-   		const int natom = atoms::neighbour_list_array[nn];
-   		const double Jij = atoms::i_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij;
+   		const int natom = neighbours.neighbour(atom, nn);
+   		const double Jij = atoms::i_exchange_list[neighbours.interaction(nn)].Jij;
 
          // note: sum over j only (not sum over i for j) leads to a silent factor 1/2 in exchange energy value
          //       - must be normalised in statistics to account for double sum
@@ -48,18 +49,19 @@ namespace exchange{
    //---------------------------------------------------------------------------
    // Calculate vectorial exchange energy for a single spin
    //---------------------------------------------------------------------------
-   double spin_exchange_energy_vectorial(const int atom, const double sx, const double sy, const double sz){
+   template <class list_t>
+   double spin_exchange_energy_vectorial(const list_t& neighbours, const int atom, const double sx, const double sy, const double sz){
 
    	// energy
    	double energy=0.0;
 
       // Loop over neighbouring spins to calculate exchange
-   	for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; ++nn){
+   	for(int nn = neighbours.start(atom); nn < neighbours.end(atom); ++nn){
 
-   		const int natom = atoms::neighbour_list_array[nn];
-   		const double Jij[3]={atoms::v_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[0],
-   									atoms::v_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[1],
-   									atoms::v_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[2]};
+   		const int natom = neighbours.neighbour(atom, nn);
+   		const double Jij[3]={atoms::v_exchange_list[neighbours.interaction(nn)].Jij[0],
+   									atoms::v_exchange_list[neighbours.interaction(nn)].Jij[1],
+   									atoms::v_exchange_list[neighbours.interaction(nn)].Jij[2]};
 
          // note: sum over j only (not sum over i for j) leads to a silent factor 1/2 in exchange energy value
          //       - must be normalised in statistics to account for double sum
@@ -76,26 +78,27 @@ namespace exchange{
    //---------------------------------------------------------------------------
    // Calculate tensorial exchange energy for a single spin
    //---------------------------------------------------------------------------
-   double spin_exchange_energy_tensorial(const int atom, const double sx, const double sy, const double sz){
+   template <class list_t>
+   double spin_exchange_energy_tensorial(const list_t& neighbours, const int atom, const double sx, const double sy, const double sz){
 
    	// energy
    	double energy=0.0;
 
       // Loop over neighbouring spins to calculate exchange
-   	for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; ++nn){
+   	for(int nn = neighbours.start(atom); nn < neighbours.end(atom); ++nn){
 
-   		const int natom = atoms::neighbour_list_array[nn];
-   		const double Jij[3][3]={{atoms::t_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[0][0],
-   										 atoms::t_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[0][1],
-   										 atoms::t_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[0][2]},
+   		const int natom = neighbours.neighbour(atom, nn);
+   		const double Jij[3][3]={{atoms::t_exchange_list[neighbours.interaction(nn)].Jij[0][0],
+   										 atoms::t_exchange_list[neighbours.interaction(nn)].Jij[0][1],
+   										 atoms::t_exchange_list[neighbours.interaction(nn)].Jij[0][2]},
 
-   										{atoms::t_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[1][0],
-   										 atoms::t_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[1][1],
-   										 atoms::t_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[1][2]},
+   										{atoms::t_exchange_list[neighbours.interaction(nn)].Jij[1][0],
+   										 atoms::t_exchange_list[neighbours.interaction(nn)].Jij[1][1],
+   										 atoms::t_exchange_list[neighbours.interaction(nn)].Jij[1][2]},
 
-   										{atoms::t_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[2][0],
-   										 atoms::t_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[2][1],
-   										 atoms::t_exchange_list[atoms::neighbour_interaction_type_array[nn]].Jij[2][2]}};
+   										{atoms::t_exchange_list[neighbours.interaction(nn)].Jij[2][0],
+   										 atoms::t_exchange_list[neighbours.interaction(nn)].Jij[2][1],
+   										 atoms::t_exchange_list[neighbours.interaction(nn)].Jij[2][2]}};
 
    		const double S[3]={atoms::x_spin_array[natom],atoms::y_spin_array[natom],atoms::z_spin_array[natom]};
 
@@ -112,25 +115,26 @@ namespace exchange{
    }
 
    //---------------------------------------------------------------------------
-   // Calculate  exchange energy for single spin selecting the correct type
+   // Calculate exchange energy for single spin selecting the correct type
    //---------------------------------------------------------------------------
-   double single_spin_energy(const int atom, const double sx, const double sy, const double sz){
+   template <class list_t>
+   double spin_exchange_energy(const list_t& neighbours, const int atom, const double sx, const double sy, const double sz){
 
       // select calculation based on exchange type
       switch(internal::exchange_type){
 
    		case exchange::isotropic:
-            return spin_exchange_energy_isotropic(atom, sx, sy, sz);
+            return spin_exchange_energy_isotropic(neighbours, atom, sx, sy, sz);
             break;
 
 
          case exchange::vectorial:
-            return spin_exchange_energy_vectorial(atom, sx, sy, sz);
+            return spin_exchange_energy_vectorial(neighbours, atom, sx, sy, sz);
             break;
 
 
          case exchange::tensorial:
-            return spin_exchange_energy_tensorial(atom, sx, sy, sz);
+            return spin_exchange_energy_tensorial(neighbours, atom, sx, sy, sz);
             break;
 
    	}
@@ -139,4 +143,91 @@ namespace exchange{
 
    }
 
+   //---------------------------------------------------------------------------
+   // Calculate exchange field h_i acting on a single spin in a single pass over
+   // the neighbours, so that the exchange energy is -S_i . h_i
+   //---------------------------------------------------------------------------
+   template <class list_t>
+   void spin_exchange_field(const list_t& neighbours, const int atom, double& hx, double& hy, double& hz){
+
+      hx = 0.0;
+      hy = 0.0;
+      hz = 0.0;
+
+      switch(internal::exchange_type){
+
+         case exchange::isotropic:
+            for(int nn = neighbours.start(atom); nn < neighbours.end(atom); ++nn){
+               const int natom = neighbours.neighbour(atom, nn);
+               const double Jij = atoms::i_exchange_list[neighbours.interaction(nn)].Jij;
+               hx += Jij * atoms::x_spin_array[natom];
+               hy += Jij * atoms::y_spin_array[natom];
+               hz += Jij * atoms::z_spin_array[natom];
+            }
+            break;
+
+         case exchange::vectorial:
+            for(int nn = neighbours.start(atom); nn < neighbours.end(atom); ++nn){
+               const int natom = neighbours.neighbour(atom, nn);
+               const double* Jij = atoms::v_exchange_list[neighbours.interaction(nn)].Jij;
+               hx += Jij[0] * atoms::x_spin_array[natom];
+               hy += Jij[1] * atoms::y_spin_array[natom];
+               hz += Jij[2] * atoms::z_spin_array[natom];
+            }
+            break;
+
+         case exchange::tensorial:
+            for(int nn = neighbours.start(atom); nn < neighbours.end(atom); ++nn){
+               const int natom = neighbours.neighbour(atom, nn);
+               const zten_t& J = atoms::t_exchange_list[neighbours.interaction(nn)];
+               const double S[3] = { atoms::x_spin_array[natom], atoms::y_spin_array[natom], atoms::z_spin_array[natom] };
+               hx += J.Jij[0][0] * S[0] + J.Jij[0][1] * S[1] + J.Jij[0][2] * S[2];
+               hy += J.Jij[1][0] * S[0] + J.Jij[1][1] * S[1] + J.Jij[1][2] * S[2];
+               hz += J.Jij[2][0] * S[0] + J.Jij[2][1] * S[1] + J.Jij[2][2] * S[2];
+            }
+            break;
+
+      }
+
+      return;
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Calculate change in exchange energy of a single spin from old to new
+   // direction. Since the energy is linear in S_i, dE = -(S_new - S_old) . h_i
+   // with the exchange field h_i calculated only once.
+   //---------------------------------------------------------------------------
+   double single_spin_energy_difference(const int atom, const double old_spin[3], const double new_spin[3]){
+
+      double hx, hy, hz;
+
+      if(internal::compressed_neighbour_list){
+         spin_exchange_field(internal::compressed_list_t(), atom, hx, hy, hz);
+      }
+      else{
+         spin_exchange_field(internal::standard_list_t(atoms::neighbour_list_start_index, atoms::neighbour_list_end_index,
+                                                       atoms::neighbour_list_array, atoms::neighbour_interaction_type_array),
+                             atom, hx, hy, hz);
+      }
+
+      return -((new_spin[0] - old_spin[0]) * hx + (new_spin[1] - old_spin[1]) * hy + (new_spin[2] - old_spin[2]) * hz);
+
+   }
+
+   //---------------------------------------------------------------------------
+   // Calculate  exchange energy for single spin selecting the neighbour list
+   //---------------------------------------------------------------------------
+   double single_spin_energy(const int atom, const double sx, const double sy, const double sz){
+
+      if(internal::compressed_neighbour_list){
+         return spin_exchange_energy(internal::compressed_list_t(), atom, sx, sy, sz);
+      }
+
+      return spin_exchange_energy(internal::standard_list_t(atoms::neighbour_list_start_index, atoms::neighbour_list_end_index,
+                                                            atoms::neighbour_list_array, atoms::neighbour_interaction_type_array),
+                                  atom, sx, sy, sz);
+
+   }
+
 } // end of exchange namespace
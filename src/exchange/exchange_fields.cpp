@@ -24,24 +24,21 @@ namespace exchange{
 namespace internal{
 
    //-----------------------------------------------------------------------------
-   // Function to calculate exchange fields for spins between start and end index
+   // Exchange field kernel for a given neighbour list format
    //-----------------------------------------------------------------------------
-   void exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
-                        const int end_index, // last +1 atom to be calculated
-                        const std::vector<int>& neighbour_list_start_index,
-                        const std::vector<int>& neighbour_list_end_index,
-                        const std::vector<int>& type_array, // type for atom
-                        const std::vector<int>& neighbour_list_array, // list of interactions between atoms
-                        const std::vector<int>& neighbour_interaction_type_array, // list of interaction type for each pair of atoms with value given in exchange list
-                        const std::vector <zval_t>& i_exchange_list, // list of isotropic exchange constants
-                        const std::vector <zvec_t>& v_exchange_list, // list of vectorial exchange constants
-                        const std::vector <zten_t>& t_exchange_list, // list of tensorial exchange constants
-                        const std::vector<double>& spin_array_x, // spin vectors for atoms
-                        const std::vector<double>& spin_array_y,
-                        const std::vector<double>& spin_array_z,
-                        std::vector<double>& field_array_x, // field vectors for atoms
-                        std::vector<double>& field_array_y,
-                        std::vector<double>& field_array_z){
+   template <class list_t>
+   void exchange_fields_kernel(const int start_index, // first atom for exchange interactions to be calculated
+                               const int end_index, // last +1 atom to be calculated
+                               const list_t& neighbours, // list of interactions between atoms
+                               const std::vector <zval_t>& i_exchange_list, // list of isotropic exchange constants
+                               const std::vector <zvec_t>& v_exchange_list, // list of vectorial exchange constants
+                               const std::vector <zten_t>& t_exchange_list, // list of tensorial exchange constants
+                               const std::vector<double>& spin_array_x, // spin vectors for atoms
+                               const std::vector<double>& spin_array_y,
+                               const std::vector<double>& spin_array_z,
+                               std::vector<double>& field_array_x, // field vectors for atoms
+                               std::vector<double>& field_array_y,
+                               std::vector<double>& field_array_z){
 
    	// Use appropriate function for exchange calculation
    	switch(internal::exchange_type){
@@ -57,14 +54,14 @@ namespace internal{
    				double hz = 0.0;
 
                // temporray constants for loop start and end indices
-   				const int start = neighbour_list_start_index[atom];
-   				const int end   = neighbour_list_end_index[atom]+1;
+   				const int start = neighbours.start(atom);
+   				const int end   = neighbours.end(atom);
 
                // loop over all neighbours
    				for(int nn = start; nn < end; ++nn){
 
-   					const int natom = neighbour_list_array[nn]; // get neighbouring atom number
-   					const double Jij = i_exchange_list[ neighbour_interaction_type_array[nn] ].Jij; // get exchange constant between atoms
+   					const int natom = neighbours.neighbour(atom, nn); // get neighbouring atom number
+   					const double Jij = i_exchange_list[ neighbours.interaction(nn) ].Jij; // get exchange constant between atoms
 
    					hx += Jij * spin_array_x[natom]; // add exchange fields
    					hy += Jij * spin_array_y[natom];
@@ -90,14 +87,14 @@ namespace internal{
                double hz = 0.0;
 
                // temporray constants for loop start and end indices
-               const int start = neighbour_list_start_index[atom];
-               const int end   = neighbour_list_end_index[atom]+1;
+               const int start = neighbours.start(atom);
+               const int end   = neighbours.end(atom);
 
                // loop over all neighbours
                for(int nn = start; nn < end; ++nn){
 
-                  const int natom = neighbour_list_array[nn]; // get neighbouring atom number
-                  const int iid = neighbour_interaction_type_array[nn]; // interaction id
+                  const int natom = neighbours.neighbour(atom, nn); // get neighbouring atom number
+                  const int iid = neighbours.interaction(nn); // interaction id
 
    					const double Jij[3]={v_exchange_list[iid].Jij[0],
    												v_exchange_list[iid].Jij[1],
@@ -127,14 +124,14 @@ namespace internal{
                double hz = 0.0;
 
                // temporray constants for loop start and end indices
-               const int start = neighbour_list_start_index[atom];
-               const int end   = neighbour_list_end_index[atom]+1;
+               const int start = neighbours.start(atom);
+               const int end   = neighbours.end(atom);
 
                // loop over all neighbours
                for(int nn = start; nn < end; ++nn){
 
-                  const int natom = neighbour_list_array[nn]; // get neighbouring atom number
-                  const int iid = neighbour_interaction_type_array[nn]; // interaction id
+                  const int natom = neighbours.neighbour(atom, nn); // get neighbouring atom number
+                  const int iid = neighbours.interaction(nn); // interaction id
 
    					const double Jij[3][3]={ {t_exchange_list[iid].Jij[0][0],
    													  t_exchange_list[iid].Jij[0][1],
@@ -168,6 +165,55 @@ namespace internal{
 
    	}
 
+   //-----------------------------------------------------------------------------
+   // Function to calculate exchange fields for spins between start and end index
+   //-----------------------------------------------------------------------------
+   void exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
+                        const int end_index, // last +1 atom to be calculated
+                        const std::vector<int>& neighbour_list_start_index,
+                        const std::vector<int>& neighbour_list_end_index,
+                        const std::vector<int>& type_array, // type for atom
+                        const std::vector<int>& neighbour_list_array, // list of interactions between atoms
+                        const std::vector<int>& neighbour_interaction_type_array, // list of interaction type for each pair of atoms with value given in exchange list
+                        const std::vector <zval_t>& i_exchange_list, // list of isotropic exchange constants
+                        const std::vector <zvec_t>& v_exchange_list, // list of vectorial exchange constants
+                        const std::vector <zten_t>& t_exchange_list, // list of tensorial exchange constants
+                        const std::vector<double>& spin_array_x, // spin vectors for atoms
+                        const std::vector<double>& spin_array_y,
+                        const std::vector<double>& spin_array_z,
+                        std::vector<double>& field_array_x, // field vectors for atoms
+                        std::vector<double>& field_array_y,
+                        std::vector<double>& field_array_z){
+
+      // nothing to do for empty range
+      if(end_index <= start_index) return;
+
+      // use vectorised kernel for isotropic exchange if selected
+      if(internal::exchange_type == exchange::isotropic && (internal::simd_kernel == simd_avx2 || internal::simd_kernel == simd_avx512)){
+         simd_isotropic_exchange_fields(start_index, end_index,
+                                        &spin_array_x[0], &spin_array_y[0], &spin_array_z[0],
+                                        field_array_x, field_array_y, field_array_z);
+         return;
+      }
+
+      // read neighbours from compressed stencils if available
+      if(internal::compressed_neighbour_list){
+         exchange_fields_kernel(start_index, end_index, compressed_list_t(), i_exchange_list, v_exchange_list, t_exchange_list,
+                                spin_array_x, spin_array_y, spin_array_z,
+                                field_array_x, field_array_y, field_array_z);
+      }
+      else{
+         exchange_fields_kernel(start_index, end_index,
+                                standard_list_t(neighbour_list_start_index, neighbour_list_end_index, neighbour_list_array, neighbour_interaction_type_array),
+                                i_exchange_list, v_exchange_list, t_exchange_list,
+                                spin_array_x, spin_array_y, spin_array_z,
+                                field_array_x, field_array_y, field_array_z);
+      }
+
+      return;
+
+   }
+
 } // end of internal namespace
 
 } // end of exchange namespace
@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+
+// Vampire headers
+#include "atoms.hpp"
+#include "exchange.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+namespace exchange{
+
+   //------------------------------------------------------------------------------
+   // Function to return the atoms interacting with atom by bilinear or
+   // biquadratic exchange, for either neighbour list format
+   //------------------------------------------------------------------------------
+   void get_neighbours(const int atom, std::vector<int>& neighbours){
+
+      neighbours.resize(0);
+
+      // bilinear exchange
+      if(internal::compressed_neighbour_list){
+         const internal::compressed_list_t list;
+         for(int nn = list.start(atom); nn < list.end(atom); nn++) neighbours.push_back(list.neighbour(atom, nn));
+      }
+      else{
+         for(int nn = atoms::neighbour_list_start_index[atom]; nn <= atoms::neighbour_list_end_index[atom]; nn++){
+            neighbours.push_back(atoms::neighbour_list_array[nn]);
+         }
+      }
+
+      // biquadratic exchange
+      if(exchange::biquadratic){
+         for(int nn = internal::biquadratic_neighbour_list_start_index[atom]; nn <= internal::biquadratic_neighbour_list_end_index[atom]; nn++){
+            neighbours.push_back(internal::biquadratic_neighbour_list_array[nn]);
+         }
+      }
+
+      return;
+
+   }
+
+} // end of exchange namespace
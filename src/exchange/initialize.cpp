@@ -26,8 +26,8 @@ namespace exchange{
    //----------------------------------------------------------------------------
    // Function to initialize exchange module
    //----------------------------------------------------------------------------
-   void initialize(std::vector<std::vector <neighbours::neighbour_t> >& bilinear,
-                   std::vector<std::vector <neighbours::neighbour_t> >& biquadratic){
+   void initialize(neighbours::list_t& bilinear,
+                   neighbours::list_t& biquadratic){
 
       zlog << zTs() << "Initialising data structures for exchange calculation." << std::endl;
 
@@ -67,13 +67,7 @@ namespace exchange{
       //-------------------------------------------------
    	//	Calculate total number of neighbours
    	//-------------------------------------------------
-   	uint64_t counter = 0; // number of exchange interactions
-
-   	for(uint64_t atom = 0; atom < atoms::num_atoms; atom++){
-   		counter += bilinear[atom].size();
-   	}
-
-   	atoms::total_num_neighbours = counter;
+   	atoms::total_num_neighbours = bilinear.start_index[atoms::num_atoms];
 
    	atoms::neighbour_list_array.resize(atoms::total_num_neighbours,0);
    	atoms::neighbour_interaction_type_array.resize(atoms::total_num_neighbours,0);
@@ -83,35 +77,31 @@ namespace exchange{
    	atoms::neighbour_list_end_index.resize(atoms::num_atoms,0);
 
    	//	Populate 1D neighbourlist and index arrays
-   	counter = 0;
+   	uint64_t counter = 0;
    	for(uint64_t atom=0; atom < atoms::num_atoms; atom++){
-   		//std::cout << atom << ": ";
    		// Set start index
    		atoms::neighbour_list_start_index[atom]=counter;
-   		for(unsigned int nn=0;nn<bilinear[atom].size();nn++){
+   		for(uint64_t nn = bilinear.start_index[atom]; nn < bilinear.start_index[atom+1]; nn++){
 
             // save atom number to 1D interaction list
-   			atoms::neighbour_list_array[counter] = bilinear[atom][nn].nn;
+   			atoms::neighbour_list_array[counter] = bilinear.nn[nn];
 
-   			if(bilinear[atom][nn].nn >= atoms::num_atoms){
+   			if(bilinear.nn[nn] >= atoms::num_atoms){
    				terminaltextcolor(RED);
-   				std::cerr << "Fatal Error - neighbour atom " << bilinear[atom][nn].nn <<" is out of valid range 0-"
+   				std::cerr << "Fatal Error - neighbour atom " << bilinear.nn[nn] <<" is out of valid range 0-"
    				<< atoms::num_atoms-1 << " on rank " << vmpi::my_rank << std::endl;
                std::cerr << "\tAtom number      : " << atom << std::endl;
-               std::cerr << "\tNeighbour number : " << nn << std::endl;
+               std::cerr << "\tNeighbour number : " << nn - bilinear.start_index[atom] << std::endl;
                std::cerr << "\tNeighbour atom   : " << atoms::neighbour_list_array[counter] << std::endl;
-   				//std::cerr << "Atom " << atom << " of MPI type " << catom_array[atom].mpi_type << std::endl;
    				terminaltextcolor(WHITE);
    				err::vexit();
    			}
 
             // save interaction type to 1D array
-   			atoms::neighbour_interaction_type_array[counter] = bilinear[atom][nn].i;
+   			atoms::neighbour_interaction_type_array[counter] = bilinear.i[nn];
 
-   			//std::cout << bilinear[atom][nn] << " ";
    			counter++;
    		}
-   		//std::cout << std::endl;
    		// Set end index
    		atoms::neighbour_list_end_index[atom]=counter-1;
    	}
@@ -122,10 +112,7 @@ namespace exchange{
       if(exchange::biquadratic){
 
          // determine total number of biquadratic exchange interactions
-         counter = 0;
-         for(uint64_t atom = 0; atom < atoms::num_atoms; atom++){
-      		counter += biquadratic[atom].size();
-      	}
+         counter = biquadratic.start_index[atoms::num_atoms];
 
          // save type of interaction template and if material file constants are used
          exchange::internal::biquadratic_exchange_type = cs::unit_cell.biquadratic.exchange_type;
@@ -143,14 +130,14 @@ namespace exchange{
       		//std::cout << atom << ": ";
       		// Set start index
       		exchange::internal::biquadratic_neighbour_list_start_index[atom]=counter;
-      		for(unsigned int nn=0; nn < biquadratic[atom].size(); nn++){
+      		for(uint64_t nn = biquadratic.start_index[atom]; nn < biquadratic.start_index[atom+1]; nn++){
 
                // save atom number to 1D interaction list
-      			exchange::internal::biquadratic_neighbour_list_array[counter] = biquadratic[atom][nn].nn;
+      			exchange::internal::biquadratic_neighbour_list_array[counter] = biquadratic.nn[nn];
 
-      			if(biquadratic[atom][nn].nn >= atoms::num_atoms){
+      			if(biquadratic.nn[nn] >= atoms::num_atoms){
       				terminaltextcolor(RED);
-      				std::cerr << "Fatal Error - biquadratic neighbour " << biquadratic[atom][nn].nn <<" is out of valid range 0-"
+      				std::cerr << "Fatal Error - biquadratic neighbour " << biquadratic.nn[nn] <<" is out of valid range 0-"
       				<< atoms::num_atoms << " on rank " << vmpi::my_rank << std::endl;
       				//std::cerr << "Atom " << atom << " of MPI type " << catom_array[atom].mpi_type << std::endl;
       				terminaltextcolor(WHITE);
@@ -158,9 +145,8 @@ namespace exchange{
       			}
 
                // save interaction type to 1D array
-      			exchange::internal::biquadratic_neighbour_interaction_type_array[counter] = biquadratic[atom][nn].i;
+      			exchange::internal::biquadratic_neighbour_interaction_type_array[counter] = biquadratic.i[nn];
 
-      			//std::cout << biquadratic[atom][nn] << " ";
       			counter++;
 
       		}
@@ -179,6 +165,12 @@ namespace exchange{
       // Calculate Dzyaloshinskii-Moriya interactions (must be done after exchange unrolling)
       exchange::internal::calculate_dmi(bilinear);
 
+      // Optionally compress neighbour list (must be done after dmi calculation)
+      exchange::internal::compress_neighbour_list();
+
+      // Select kernel for exchange field calculation (must be done after dmi calculation)
+      exchange::internal::initialize_simd_exchange();
+
       return;
 
    }
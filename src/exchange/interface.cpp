@@ -42,6 +42,60 @@ namespace exchange{
           return true;
       }
       //--------------------------------------------------------------------
+      test="simd";
+      if(word==test){
+         test="auto";
+         if(value==test){
+            internal::simd_kernel = internal::simd_auto;
+            return true;
+         }
+         test="scalar";
+         if(value==test){
+            internal::simd_kernel = internal::simd_scalar;
+            return true;
+         }
+         test="avx2";
+         if(value==test){
+            internal::simd_kernel = internal::simd_avx2;
+            return true;
+         }
+         test="avx512";
+         if(value==test){
+            internal::simd_kernel = internal::simd_avx512;
+            return true;
+         }
+         terminaltextcolor(RED);
+         std::cerr << "Error - value for \'exchange:" << word << "\' must be one of:" << std::endl;
+         std::cerr << "\t\"auto\"" << std::endl;
+         std::cerr << "\t\"scalar\"" << std::endl;
+         std::cerr << "\t\"avx2\"" << std::endl;
+         std::cerr << "\t\"avx512\"" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error - value for \'exchange:" << word << "\' must be one of auto, scalar, avx2 or avx512" << std::endl;
+         err::vexit();
+      }
+      //--------------------------------------------------------------------
+      test="neighbour-list-format";
+      if(word==test){
+         test="standard";
+         if(value==test){
+            internal::compressed_neighbour_list = false;
+            return true;
+         }
+         test="compressed";
+         if(value==test){
+            internal::compressed_neighbour_list = true;
+            return true;
+         }
+         terminaltextcolor(RED);
+         std::cerr << "Error - value for \'exchange:" << word << "\' must be one of:" << std::endl;
+         std::cerr << "\t\"standard\"" << std::endl;
+         std::cerr << "\t\"compressed\"" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error - value for \'exchange:" << word << "\' must be one of standard or compressed" << std::endl;
+         err::vexit();
+      }
+      //--------------------------------------------------------------------
       // Keyword not found
       //--------------------------------------------------------------------
       return false;
@@ -72,6 +72,20 @@ namespace exchange{
 
       extern exchange_t minimum_needed_exchange_type; // minimum support required for bilinear exchange type (for vectorial constants and DMI)
 
+      // kernels for isotropic exchange field calculation
+      enum simd_t { simd_auto = 0, simd_scalar = 1, simd_avx2 = 2, simd_avx512 = 3 };
+
+      extern simd_t simd_kernel; // kernel used for isotropic exchange field calculation
+      extern std::vector <int> simd_slice_start; // first slot in sliced neighbour list for each slice of atoms
+      extern std::vector <int> simd_neighbour_array; // neighbour list interleaved between atoms in each slice
+      extern std::vector <double> simd_jij_array; // isotropic exchange constant for each slot in sliced neighbour list
+
+      extern bool compressed_neighbour_list; // flag to store neighbour list as shared stencils of relative neighbour offsets
+      extern std::vector <int> neighbour_stencil_id; // stencil of neighbour offsets for each atom
+      extern std::vector <int> stencil_start_index; // first entry of each stencil (last +1 is start of next stencil)
+      extern std::vector <int> stencil_offset_array; // neighbour atom number relative to atom for each stencil entry
+      extern std::vector <int> stencil_type_array; // interaction type for each stencil entry
+
       extern bool use_material_exchange_constants; // flag to enable material exchange parameters
       extern bool use_material_biquadratic_exchange_constants; // flag to enable material exchange parameters
 
@@ -130,10 +144,56 @@ namespace exchange{
       extern std::vector <exchange::internal::vector_t> bq_v_exchange_list; // list of vectorial biquadratic exchange constants
       extern std::vector <exchange::internal::tensor_t> bq_t_exchange_list; // list of tensorial biquadratic exchange constants
 
+      //-----------------------------------------------------------------------------
+      // Accessors for neighbour lists stored explicitly for each atom or as shared
+      // stencils of neighbour offsets relative to the atom number. Neighbours are
+      // given in the same order by both, so that fields are summed identically.
+      //-----------------------------------------------------------------------------
+      class standard_list_t{
+
+         private:
+            const int* start_index;
+            const int* end_index;
+            const int* list;
+            const int* type;
+
+         public:
+            standard_list_t(const std::vector<int>& neighbour_list_start_index, const std::vector<int>& neighbour_list_end_index,
+                            const std::vector<int>& neighbour_list_array, const std::vector<int>& neighbour_interaction_type_array):
+               start_index(&neighbour_list_start_index[0]), end_index(&neighbour_list_end_index[0]),
+               list(&neighbour_list_array[0]), type(&neighbour_interaction_type_array[0]){}
+
+            inline int start(const int atom) const { return start_index[atom]; }
+            inline int end(const int atom) const { return end_index[atom]+1; }
+            inline int neighbour(const int /*atom*/, const int nn) const { return list[nn]; }
+            inline int interaction(const int nn) const { return type[nn]; }
+
+      };
+
+      class compressed_list_t{
+
+         private:
+            const int* stencil_id;
+            const int* start_index;
+            const int* offset;
+            const int* type;
+
+         public:
+            compressed_list_t():
+               stencil_id(&neighbour_stencil_id[0]), start_index(&stencil_start_index[0]),
+               offset(&stencil_offset_array[0]), type(&stencil_type_array[0]){}
+
+            inline int start(const int atom) const { return start_index[stencil_id[atom]]; }
+            inline int end(const int atom) const { return start_index[stencil_id[atom]+1]; }
+            inline int neighbour(const int atom, const int nn) const { return atom + offset[nn]; }
+            inline int interaction(const int nn) const { return type[nn]; }
+
+      };
+
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
-      void calculate_dmi(std::vector<std::vector <neighbours::neighbour_t> >& cneighbourlist);
+      void calculate_dmi(neighbours::list_t& cneighbourlist);
       void unroll_exchange_interactions();
       void unroll_normalised_exchange_interactions();
       void unroll_normalised_biquadratic_exchange_interactions();
@@ -173,6 +233,17 @@ namespace exchange{
 
       void initialize_biquadratic_exchange();
 
+      void initialize_simd_exchange();
+      void compress_neighbour_list();
+      void simd_isotropic_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
+                                          const int end_index, // last +1 atom to be calculated
+                                          const double* spin_x, // spin vectors for atoms
+                                          const double* spin_y,
+                                          const double* spin_z,
+                                          std::vector<double>& field_array_x, // field vectors for atoms
+                                          std::vector<double>& field_array_y,
+                                          std::vector<double>& field_array_z);
+
    } // end of internal namespace
 
 } // end of exchange namespace
@@ -0,0 +1,434 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <cstring>
+#include <iostream>
+
+// Vampire headers
+#include "atoms.hpp"
+#include "errors.hpp"
+#include "exchange.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// exchange module headers
+#include "internal.hpp"
+
+// SIMD kernels are available for x86 processors with GNU compatible compilers
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+   #define VAMPIRE_X86_SIMD
+   #include <immintrin.h>
+   // Multiplies and adds must not be fused into FMA instructions, so that
+   // every lane performs exactly the same operations as the scalar code
+   #pragma GCC optimize ("fp-contract=off")
+#endif
+
+namespace exchange{
+
+namespace internal{
+
+   //-----------------------------------------------------------------------------
+   // Function to calculate isotropic exchange fields for atoms between start and
+   // end index from the sliced neighbour list, one atom at a time. Padding slots
+   // have zero exchange and add nothing to the field.
+   //-----------------------------------------------------------------------------
+   inline void sliced_isotropic_exchange_fields(const int start_index, const int end_index, const int width,
+                                                const int* slice_start, const int* neighbour, const double* jij,
+                                                const double* spin_x, const double* spin_y, const double* spin_z,
+                                                double* field_x, double* field_y, double* field_z){
+
+      for(int atom = start_index; atom < end_index; atom++){
+
+         const int slice = atom / width;
+         const int lane  = atom - slice*width;
+         const int start = slice_start[slice] + lane;
+         const int end   = slice_start[slice+1];
+
+         double hx = 0.0;
+         double hy = 0.0;
+         double hz = 0.0;
+
+         for(int nn = start; nn < end; nn += width){
+            const int natom = neighbour[nn];
+            hx += jij[nn] * spin_x[natom];
+            hy += jij[nn] * spin_y[natom];
+            hz += jij[nn] * spin_z[natom];
+         }
+
+         field_x[atom] += hx;
+         field_y[atom] += hy;
+         field_z[atom] += hz;
+
+      }
+
+      return;
+
+   }
+
+#ifdef VAMPIRE_X86_SIMD
+
+   //-----------------------------------------------------------------------------
+   // AVX2 isotropic exchange kernel. Each slice of four atoms is processed at
+   // once, with each lane summing the neighbours of one atom in the same order
+   // as the scalar code. Neighbour numbers and exchange constants of a slice are
+   // interleaved, so only the neighbouring spins need to be gathered.
+   //-----------------------------------------------------------------------------
+   __attribute__((target("avx2")))
+   void avx2_isotropic_exchange_fields(const int start_index, const int end_index,
+                                       const int* slice_start, const int* neighbour, const double* jij,
+                                       const double* spin_x, const double* spin_y, const double* spin_z,
+                                       double* field_x, double* field_y, double* field_z){
+
+      const int width = 4;
+      const int first_slice = (start_index + width - 1)/width;
+      const int last_slice  = end_index/width;
+
+      // atoms in incomplete slices are calculated individually
+      if(first_slice >= last_slice){
+         sliced_isotropic_exchange_fields(start_index, end_index, width, slice_start, neighbour, jij,
+                                          spin_x, spin_y, spin_z, field_x, field_y, field_z);
+         return;
+      }
+      sliced_isotropic_exchange_fields(start_index, first_slice*width, width, slice_start, neighbour, jij,
+                                       spin_x, spin_y, spin_z, field_x, field_y, field_z);
+
+      const __m256d zero = _mm256_setzero_pd();
+      const __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+      for(int slice = first_slice; slice < last_slice; slice++){
+
+         __m256d hx = _mm256_setzero_pd();
+         __m256d hy = _mm256_setzero_pd();
+         __m256d hz = _mm256_setzero_pd();
+
+         for(int nn = slice_start[slice]; nn < slice_start[slice+1]; nn += width){
+
+            // load neighbour atoms and exchange constants for all lanes
+            const __m128i natom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&neighbour[nn]));
+            const __m256d J = _mm256_loadu_pd(&jij[nn]);
+
+            // gather neighbouring spins (masked form with zero source avoids an undefined register)
+            const __m256d sx = _mm256_mask_i32gather_pd(zero, spin_x, natom, all_lanes, 8);
+            const __m256d sy = _mm256_mask_i32gather_pd(zero, spin_y, natom, all_lanes, 8);
+            const __m256d sz = _mm256_mask_i32gather_pd(zero, spin_z, natom, all_lanes, 8);
+
+            // add exchange fields
+            hx = _mm256_add_pd(hx, _mm256_mul_pd(J, sx));
+            hy = _mm256_add_pd(hy, _mm256_mul_pd(J, sy));
+            hz = _mm256_add_pd(hz, _mm256_mul_pd(J, sz));
+
+         }
+
+         // save total field to field array
+         const int atom = slice*width;
+         _mm256_storeu_pd(&field_x[atom], _mm256_add_pd(_mm256_loadu_pd(&field_x[atom]), hx));
+         _mm256_storeu_pd(&field_y[atom], _mm256_add_pd(_mm256_loadu_pd(&field_y[atom]), hy));
+         _mm256_storeu_pd(&field_z[atom], _mm256_add_pd(_mm256_loadu_pd(&field_z[atom]), hz));
+
+      }
+
+      sliced_isotropic_exchange_fields(last_slice*width, end_index, width, slice_start, neighbour, jij,
+                                       spin_x, spin_y, spin_z, field_x, field_y, field_z);
+
+      return;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // AVX-512 isotropic exchange kernel, processing slices of eight atoms
+   //-----------------------------------------------------------------------------
+   __attribute__((target("avx2,avx512f")))
+   void avx512_isotropic_exchange_fields(const int start_index, const int end_index,
+                                         const int* slice_start, const int* neighbour, const double* jij,
+                                         const double* spin_x, const double* spin_y, const double* spin_z,
+                                         double* field_x, double* field_y, double* field_z){
+
+      const int width = 8;
+      const int first_slice = (start_index + width - 1)/width;
+      const int last_slice  = end_index/width;
+
+      // atoms in incomplete slices are calculated individually
+      if(first_slice >= last_slice){
+         sliced_isotropic_exchange_fields(start_index, end_index, width, slice_start, neighbour, jij,
+                                          spin_x, spin_y, spin_z, field_x, field_y, field_z);
+         return;
+      }
+      sliced_isotropic_exchange_fields(start_index, first_slice*width, width, slice_start, neighbour, jij,
+                                       spin_x, spin_y, spin_z, field_x, field_y, field_z);
+
+      const __m512d zero = _mm512_setzero_pd();
+
+      for(int slice = first_slice; slice < last_slice; slice++){
+
+         __m512d hx = _mm512_setzero_pd();
+         __m512d hy = _mm512_setzero_pd();
+         __m512d hz = _mm512_setzero_pd();
+
+         for(int nn = slice_start[slice]; nn < slice_start[slice+1]; nn += width){
+
+            // load neighbour atoms and exchange constants for all lanes
+            const __m256i natom = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&neighbour[nn]));
+            const __m512d J = _mm512_loadu_pd(&jij[nn]);
+
+            // gather neighbouring spins (masked form with zero source avoids an undefined register)
+            const __m512d sx = _mm512_mask_i32gather_pd(zero, 0xFF, natom, spin_x, 8);
+            const __m512d sy = _mm512_mask_i32gather_pd(zero, 0xFF, natom, spin_y, 8);
+            const __m512d sz = _mm512_mask_i32gather_pd(zero, 0xFF, natom, spin_z, 8);
+
+            // add exchange fields
+            hx = _mm512_add_pd(hx, _mm512_mul_pd(J, sx));
+            hy = _mm512_add_pd(hy, _mm512_mul_pd(J, sy));
+            hz = _mm512_add_pd(hz, _mm512_mul_pd(J, sz));
+
+         }
+
+         // save total field to field array
+         const int atom = slice*width;
+         _mm512_storeu_pd(&field_x[atom], _mm512_add_pd(_mm512_loadu_pd(&field_x[atom]), hx));
+         _mm512_storeu_pd(&field_y[atom], _mm512_add_pd(_mm512_loadu_pd(&field_y[atom]), hy));
+         _mm512_storeu_pd(&field_z[atom], _mm512_add_pd(_mm512_loadu_pd(&field_z[atom]), hz));
+
+      }
+
+      sliced_isotropic_exchange_fields(last_slice*width, end_index, width, slice_start, neighbour, jij,
+                                       spin_x, spin_y, spin_z, field_x, field_y, field_z);
+
+      return;
+
+   }
+
+#endif
+
+   //-----------------------------------------------------------------------------
+   // Function to calculate isotropic exchange fields with the selected SIMD
+   // kernel
+   //-----------------------------------------------------------------------------
+   void simd_isotropic_exchange_fields(const int start_index, // first atom for exchange interactions to be calculated
+                                       const int end_index, // last +1 atom to be calculated
+                                       const double* spin_x, // spin vectors for atoms
+                                       const double* spin_y,
+                                       const double* spin_z,
+                                       std::vector<double>& field_array_x, // field vectors for atoms
+                                       std::vector<double>& field_array_y,
+                                       std::vector<double>& field_array_z){
+
+      #ifdef VAMPIRE_X86_SIMD
+
+         if(internal::simd_kernel == internal::simd_avx512){
+            avx512_isotropic_exchange_fields(start_index, end_index,
+                                             &internal::simd_slice_start[0], &internal::simd_neighbour_array[0], &internal::simd_jij_array[0],
+                                             spin_x, spin_y, spin_z,
+                                             &field_array_x[0], &field_array_y[0], &field_array_z[0]);
+            return;
+         }
+         if(internal::simd_kernel == internal::simd_avx2){
+            avx2_isotropic_exchange_fields(start_index, end_index,
+                                           &internal::simd_slice_start[0], &internal::simd_neighbour_array[0], &internal::simd_jij_array[0],
+                                           spin_x, spin_y, spin_z,
+                                           &field_array_x[0], &field_array_y[0], &field_array_z[0]);
+            return;
+         }
+
+      #endif
+
+      // this function should only be called with a SIMD kernel selected
+      terminaltextcolor(RED);
+      std::cerr << "Programmer error - SIMD exchange kernel called without a valid kernel selected" << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Programmer error - SIMD exchange kernel called without a valid kernel selected" << std::endl;
+      err::vexit();
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to build the sliced neighbour list used by the SIMD kernels. Atoms
+   // are grouped into slices of width atoms, and the k-th neighbours of all atoms
+   // in a slice are stored next to each other along with the exchange constant.
+   // Atoms with fewer neighbours than others in the slice are padded with zero
+   // exchange to themselves, which leaves the field sum unchanged.
+   //-----------------------------------------------------------------------------
+   void build_sliced_neighbour_list(const int width){
+
+      const int num_atoms = atoms::num_atoms;
+      const int num_slices = (num_atoms + width - 1)/width;
+
+      // determine start of each slice
+      internal::simd_slice_start.resize(num_slices+1);
+      int slots = 0;
+      for(int slice = 0; slice < num_slices; slice++){
+         internal::simd_slice_start[slice] = slots;
+         int max_count = 0;
+         for(int atom = slice*width; atom < (slice+1)*width && atom < num_atoms; atom++){
+            const int count = atoms::neighbour_list_end_index[atom] - atoms::neighbour_list_start_index[atom] + 1;
+            if(count > max_count) max_count = count;
+         }
+         slots += max_count*width;
+      }
+      internal::simd_slice_start[num_slices] = slots;
+
+      // populate interleaved neighbour list and exchange constants
+      internal::simd_neighbour_array.assign(slots, 0);
+      internal::simd_jij_array.assign(slots, 0.0);
+      for(int slice = 0; slice < num_slices; slice++){
+         for(int lane = 0; lane < width; lane++){
+            const int atom = slice*width + lane;
+            if(atom >= num_atoms) break;
+            const int start = atoms::neighbour_list_start_index[atom];
+            const int end   = atoms::neighbour_list_end_index[atom] + 1;
+            int k = 0;
+            for(int nn = internal::simd_slice_start[slice] + lane; nn < internal::simd_slice_start[slice+1]; nn += width){
+               if(start + k < end){
+                  internal::simd_neighbour_array[nn] = atoms::neighbour_list_array[start+k];
+                  internal::simd_jij_array[nn] = atoms::i_exchange_list[ atoms::neighbour_interaction_type_array[start+k] ].Jij;
+               }
+               else{
+                  internal::simd_neighbour_array[nn] = atom;
+                  internal::simd_jij_array[nn] = 0.0;
+               }
+               k++;
+            }
+         }
+      }
+
+      // report memory used in addition to standard neighbour list
+      const double padding = atoms::neighbour_list_array.size() > 0 ? 100.0*(double(slots)/double(atoms::neighbour_list_array.size()) - 1.0) : 0.0;
+      const double memory = 1.0e-6*double(internal::simd_slice_start.size()*sizeof(int) + slots*(sizeof(int) + sizeof(double)));
+      if(vmpi::my_rank == 0){
+         std::cout << "Sliced neighbour list for SIMD exchange uses an additional " << memory << " MB of memory" << std::endl;
+      }
+      zlog << zTs() << "Sliced neighbour list for SIMD exchange generated with " << slots << " slots (" << padding << "% padding) using an additional " << memory << " MB of memory" << std::endl;
+
+      return;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to check that the SIMD kernel reproduces the scalar exchange field
+   // bit for bit for the system
+   //-----------------------------------------------------------------------------
+   bool verify_simd_exchange(const simd_t kernel){
+
+      const int num_atoms = atoms::num_atoms;
+      if(num_atoms == 0) return true;
+
+      // generate reproducible random spins without changing the global generator
+      std::vector<double> sx(num_atoms), sy(num_atoms), sz(num_atoms);
+      uint64_t state = 88172645463325252ULL;
+      for(int atom = 0; atom < num_atoms; atom++){
+         double s[3];
+         for(int i = 0; i < 3; i++){
+            state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+            s[i] = double(state >> 11)*(2.0/9007199254740992.0) - 1.0;
+         }
+         sx[atom] = s[0];
+         sy[atom] = s[1];
+         sz[atom] = s[2];
+      }
+
+      // reference fields from scalar code
+      std::vector<double> rx(num_atoms, 0.0), ry(num_atoms, 0.0), rz(num_atoms, 0.0);
+      const simd_t selected_kernel = internal::simd_kernel;
+      internal::simd_kernel = simd_scalar;
+      internal::exchange_fields(0, num_atoms, atoms::neighbour_list_start_index, atoms::neighbour_list_end_index,
+                                atoms::type_array, atoms::neighbour_list_array, atoms::neighbour_interaction_type_array,
+                                atoms::i_exchange_list, atoms::v_exchange_list, atoms::t_exchange_list,
+                                sx, sy, sz, rx, ry, rz);
+
+      // fields from SIMD kernel
+      internal::simd_kernel = kernel;
+      std::vector<double> hx(num_atoms, 0.0), hy(num_atoms, 0.0), hz(num_atoms, 0.0);
+      // split range part way through a slice, as for threaded and parallel calculations
+      const int split = (num_atoms/3) | 1;
+      const int range[3] = {0, split < num_atoms ? split : num_atoms, num_atoms};
+      for(int r = 0; r < 2; r++){
+         internal::exchange_fields(range[r], range[r+1], atoms::neighbour_list_start_index, atoms::neighbour_list_end_index,
+                                   atoms::type_array, atoms::neighbour_list_array, atoms::neighbour_interaction_type_array,
+                                   atoms::i_exchange_list, atoms::v_exchange_list, atoms::t_exchange_list,
+                                   sx, sy, sz, hx, hy, hz);
+      }
+      const size_t bytes = num_atoms*sizeof(double);
+      const bool identical = memcmp(&hx[0], &rx[0], bytes) == 0 && memcmp(&hy[0], &ry[0], bytes) == 0 && memcmp(&hz[0], &rz[0], bytes) == 0;
+      internal::simd_kernel = selected_kernel;
+
+      return identical;
+
+   }
+
+   //-----------------------------------------------------------------------------
+   // Function to initialise SIMD exchange calculation. The widest kernel
+   // supported by the processor is selected and the sliced neighbour list for
+   // it is generated.
+   //-----------------------------------------------------------------------------
+   void initialize_simd_exchange(){
+
+      // only isotropic exchange with the standard neighbour list is vectorised
+      if(internal::exchange_type != exchange::isotropic || internal::compressed_neighbour_list || internal::simd_kernel == simd_scalar){
+         internal::simd_kernel = simd_scalar;
+         zlog << zTs() << "Using scalar kernel for exchange field calculation" << std::endl;
+         return;
+      }
+
+      // determine kernels supported by processor
+      bool avx2_supported = false;
+      bool avx512_supported = false;
+      #ifdef VAMPIRE_X86_SIMD
+         __builtin_cpu_init();
+         avx2_supported = __builtin_cpu_supports("avx2");
+         avx512_supported = avx2_supported && __builtin_cpu_supports("avx512f");
+      #endif
+
+      // select kernel
+      simd_t kernel = internal::simd_kernel;
+      if(kernel == simd_auto){
+         if(avx512_supported) kernel = simd_avx512;
+         else if(avx2_supported) kernel = simd_avx2;
+         else kernel = simd_scalar;
+      }
+      else if( (kernel == simd_avx512 && !avx512_supported) || (kernel == simd_avx2 && !avx2_supported) ){
+         terminaltextcolor(YELLOW);
+         std::cout << "Warning: Requested SIMD exchange kernel is not supported by this processor, using scalar kernel" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Warning: Requested SIMD exchange kernel is not supported by this processor, using scalar kernel" << std::endl;
+         kernel = simd_scalar;
+      }
+
+      if(kernel == simd_scalar){
+         internal::simd_kernel = simd_scalar;
+         zlog << zTs() << "Using scalar kernel for exchange field calculation" << std::endl;
+         return;
+      }
+
+      // generate neighbour list for SIMD kernel
+      build_sliced_neighbour_list(kernel == simd_avx512 ? 8 : 4);
+
+      // check that kernel agrees exactly with scalar code
+      if(verify_simd_exchange(kernel) == false){
+         terminaltextcolor(YELLOW);
+         std::cout << "Warning: SIMD exchange kernel does not reproduce scalar exchange fields, using scalar kernel" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Warning: SIMD exchange kernel does not reproduce scalar exchange fields, using scalar kernel" << std::endl;
+         internal::simd_kernel = simd_scalar;
+         std::vector<int>().swap(internal::simd_slice_start);
+         std::vector<int>().swap(internal::simd_neighbour_array);
+         std::vector<double>().swap(internal::simd_jij_array);
+         return;
+      }
+
+      internal::simd_kernel = kernel;
+      zlog << zTs() << "Using " << (kernel == simd_avx512 ? "AVX-512" : "AVX2") << " kernel for exchange field calculation (verified bit identical to scalar kernel)" << std::endl;
+
+      return;
+
+   }
+
+} // end of internal namespace
+
+} // end of exchange namespace
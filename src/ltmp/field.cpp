@@ -33,9 +33,9 @@ namespace ltmp{
       const int num_local_atoms = ltmp::internal::num_local_atoms;
 
       // Initialise thermal field random numbers
-      generate (ltmp::internal::x_field_array.begin(),ltmp::internal::x_field_array.begin()+num_local_atoms, mtrandom::gaussian);
-      generate (ltmp::internal::y_field_array.begin(),ltmp::internal::y_field_array.begin()+num_local_atoms, mtrandom::gaussian);
-      generate (ltmp::internal::z_field_array.begin(),ltmp::internal::z_field_array.begin()+num_local_atoms, mtrandom::gaussian);
+      mtrandom::gaussian_fill(ltmp::internal::x_field_array, 0, num_local_atoms);
+      mtrandom::gaussian_fill(ltmp::internal::y_field_array, 0, num_local_atoms);
+      mtrandom::gaussian_fill(ltmp::internal::z_field_array, 0, num_local_atoms);
 
       // check for temperature rescaling
       if(ltmp::internal::temperature_rescaling){
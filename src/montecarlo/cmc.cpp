@@ -296,9 +296,6 @@ int cmc_step(){
 	double delta_energy2;
 	double delta_energy21;
 
-	double Eold;
-	double Enew;
-
 	std::vector<double> spin1_initial(3);
 	std::vector<double> spin1_final(3);
 	double spin2_initial[3];
@@ -384,20 +381,14 @@ int cmc_step(){
 		// Calculate Energy Difference 1
 		//call calc_one_spin_energy(delta_energy1,spin1_final,atom_number1)
 
-		// Calculate current energy
-		Eold = sim::calculate_spin_energy(atom_number1);
+		// Calculate difference in Joules/mu_B
+		delta_energy1 = sim::calculate_spin_energy_difference(atom_number1, &spin1_initial[0], &spin1_final[0])*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 		// Copy new spin position (provisionally accept move)
 		atoms::x_spin_array[atom_number1] = spin1_final[0];
 		atoms::y_spin_array[atom_number1] = spin1_final[1];
 		atoms::z_spin_array[atom_number1] = spin1_final[2];
 
-		// Calculate new energy
-		Enew = sim::calculate_spin_energy(atom_number1);
-
-		// Calculate difference in Joules/mu_B
-		delta_energy1 = (Enew-Eold)*mp::material[imat1].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 		// Compute second move
 
 		// Randomly select spin number 2 (i/=j)
@@ -434,20 +425,14 @@ int cmc_step(){
 			//atomic_spin_array(:,atom_number1) = spin1_final(:)
 
 			//Calculate Energy Difference 2
-			// Calculate current energy
-			Eold = sim::calculate_spin_energy(atom_number2);
+			// Calculate difference in Joules/mu_B
+			delta_energy2 = sim::calculate_spin_energy_difference(atom_number2, spin2_initial, spin2_final)*mp::material[imat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
 
 			// Copy new spin position (provisionally accept move)
 			atoms::x_spin_array[atom_number2] = spin2_final[0];
 			atoms::y_spin_array[atom_number2] = spin2_final[1];
 			atoms::z_spin_array[atom_number2] = spin2_final[2];
 
-			// Calculate new energy
-			Enew = sim::calculate_spin_energy(atom_number2);
-
-			// Calculate difference in Joules/mu_B
-			delta_energy2 = (Enew-Eold)*mp::material[imat2].mu_s_SI*1.07828231e23; //1/9.27400915e-24
-
 			// Calculate Delta E for both spins
 			delta_energy21 = delta_energy1*rescaled_material_kBTBohr[imat1] + delta_energy2*rescaled_material_kBTBohr[imat2];
 
@@ -51,6 +51,10 @@ namespace montecarlo{
       std::vector<std::vector<int> > c_octants; //Core atoms of each octant
       std::vector<std::vector<int> > b_octants; //Boundary atoms of each octant
 
+      //Graph coloured MC variables
+      bool coloured_mc_initialized = false; // flag to indicate atoms have been coloured
+      std::vector<std::vector<std::vector<int> > > colour_sets; // atoms of each colour for each set of atoms
+
 
    } // end of internal namespace
 
@@ -20,6 +20,7 @@
 //---------------------------------------------------------------------
 
 // C++ standard library headers
+#include <stdint.h>
 #include <vector>
 
 // Vampire headers
@@ -59,6 +60,10 @@ namespace montecarlo{
       //MC-MPI variables
       extern std::vector<std::vector<int> > c_octants; //Core atoms of each octant
       extern std::vector<std::vector<int> > b_octants; //Boundary atoms of each octant
+
+      //Graph coloured MC variables
+      extern bool coloured_mc_initialized; // flag to indicate atoms have been coloured
+      extern std::vector<std::vector<std::vector<int> > > colour_sets; // atoms of each colour for each set of atoms
       //-------------------------------------------------------------------------
       // Internal function declarations
       //-------------------------------------------------------------------------
@@ -16,6 +16,8 @@
 #include <vector>
 
 // Vampire Header files
+#include "cells.hpp"
+#include "dipole.hpp"
 #include "errors.hpp"
 #include "random.hpp"
 #include "sim.hpp"
@@ -119,8 +121,6 @@ void mc_step_parallel(std::vector<double> &x_spin_array,
 
    // Temporaries
    int atom=0;
-   double Eold=0.0;
-   double Enew=0.0;
    double DE=0.0;
 
    // Material dependent temperature rescaling
@@ -137,6 +137,10 @@ void mc_step_parallel(std::vector<double> &x_spin_array,
    double statistics_moves = 0.0;
    double statistics_reject = 0.0;
 
+   // update cell magnetisation incrementally for dipole field calculation
+   const bool dipole_enabled = dipole::activated;
+   if(dipole_enabled) cells::start_tracking_spin_changes();
+
 	// loop over all octants
    for(int octant = 0; octant < 8; octant++) {
 
@@ -169,35 +173,19 @@ void mc_step_parallel(std::vector<double> &x_spin_array,
          // Make Monte Carlo move
          internal::mc_move(internal::Sold, internal::Snew);
 
-      	// Calculate current energy
-      	Eold = sim::calculate_spin_energy(atom);
-
-      	// Copy new spin position
-      	x_spin_array[atom] = internal::Snew[0];
-      	y_spin_array[atom] = internal::Snew[1];
-      	z_spin_array[atom] = internal::Snew[2];
-
-      	// Calculate new energy
-      	Enew = sim::calculate_spin_energy(atom);
-
-      	// Calculate difference in Joules/mu_B
-      	DE = (Enew-Eold)*internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
-
-      	// Check for lower energy state and accept unconditionally
-      	if(DE<0) continue;
-      	// Otherwise evaluate probability for move
-      	else{
-      		if(exp(-DE*rescaled_material_kBTBohr[imaterial]) >= mtrandom::grnd()) continue;
-      		// If rejected reset spin coordinates and continue
-      		else{
-      			x_spin_array[atom] = internal::Sold[0];
-      			y_spin_array[atom] = internal::Sold[1];
-      			z_spin_array[atom] = internal::Sold[2];
-               // add one to rejection counter
-               statistics_reject += 1.0;
-      			continue;
-      		}
+      	// Calculate energy difference in Joules/mu_B
+      	DE = sim::calculate_spin_energy_difference(atom, &internal::Sold[0], &internal::Snew[0])*internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
+
+      	// Check for lower energy state or evaluate probability for move
+      	if(DE<0 || exp(-DE*rescaled_material_kBTBohr[imaterial]) >= mtrandom::grnd()){
+      	   // Copy new spin position
+      	   x_spin_array[atom] = internal::Snew[0];
+      	   y_spin_array[atom] = internal::Snew[1];
+      	   z_spin_array[atom] = internal::Snew[2];
+      	   if(dipole_enabled) cells::add_spin_change(atom, &internal::Sold[0], &internal::Snew[0]);
       	}
+      	// If rejected add one to rejection counter
+      	else statistics_reject += 1.0;
       }
 
       // Finish non-blocking data send/receive
@@ -229,35 +217,19 @@ void mc_step_parallel(std::vector<double> &x_spin_array,
          // Make Monte Carlo move
          internal::mc_move(internal::Sold, internal::Snew);
 
-   		// Calculate current energy
-   		Eold = sim::calculate_spin_energy(atom);
-
-   		// Copy new spin position
-   		x_spin_array[atom] = internal::Snew[0];
-   		y_spin_array[atom] = internal::Snew[1];
-   		z_spin_array[atom] = internal::Snew[2];
-
-   		// Calculate new energy
-   		Enew = sim::calculate_spin_energy(atom);
-
-   		// Calculate difference in Joules/mu_B
-   		DE = (Enew-Eold)*internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
-
-   		// Check for lower energy state and accept unconditionally
-   		if(DE<0) continue;
-   		// Otherwise evaluate probability for move
-   		else{
-   			if(exp(-DE*rescaled_material_kBTBohr[imaterial]) >= mtrandom::grnd()) continue;
-   			// If rejected reset spin coordinates and continue
-   			else{
-   				x_spin_array[atom] = internal::Sold[0];
-   				y_spin_array[atom] = internal::Sold[1];
-   				z_spin_array[atom] = internal::Sold[2];
-               // add one to rejection counter
-               statistics_reject += 1.0;
-   				continue;
-   			}
+   		// Calculate energy difference in Joules/mu_B
+   		DE = sim::calculate_spin_energy_difference(atom, &internal::Sold[0], &internal::Snew[0])*internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
+
+   		// Check for lower energy state or evaluate probability for move
+   		if(DE<0 || exp(-DE*rescaled_material_kBTBohr[imaterial]) >= mtrandom::grnd()){
+   		   // Copy new spin position
+   		   x_spin_array[atom] = internal::Snew[0];
+   		   y_spin_array[atom] = internal::Snew[1];
+   		   z_spin_array[atom] = internal::Snew[2];
+   		   if(dipole_enabled) cells::add_spin_change(atom, &internal::Sold[0], &internal::Snew[0]);
    		}
+   		// If rejected add one to rejection counter
+   		else statistics_reject += 1.0;
    	}
 
       // Swap timers compute -> wait
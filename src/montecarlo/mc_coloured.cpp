@@ -0,0 +1,369 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// Standard Libraries
+#include <cmath>
+#include <vector>
+
+// Vampire Header files
+#include "atoms.hpp"
+#include "create.hpp"
+#include "exchange.hpp"
+#include "random.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+// Internal header
+#include "internal.hpp"
+
+namespace montecarlo{
+
+namespace internal{
+
+   //------------------------------------------------------------------------------
+   // Function to check that no two interacting local atoms have the same colour
+   //------------------------------------------------------------------------------
+   bool valid_colouring(const std::vector<int>& colour, const std::vector<int>& start, const std::vector<int>& neighbours){
+
+      const int num_local = colour.size();
+      for(int atom = 0; atom < num_local; atom++){
+         for(int nn = start[atom]; nn < start[atom+1]; nn++){
+            const int natom = neighbours[nn];
+            if(natom < num_local && natom != atom && colour[natom] == colour[atom]) return false;
+         }
+      }
+
+      return true;
+
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to colour the exchange graph of the local atoms so that atoms of
+   // the same colour do not interact and can be updated simultaneously. Simple
+   // sublattice colourings from the unit cell position of each atom are tried
+   // first, which are optimal for most crystals, with greedy colouring used for
+   // anything else. Returns the number of colours.
+   //------------------------------------------------------------------------------
+   int colour_atoms(const int num_local, std::vector<int>& colour){
+
+      // compressed list of local exchange neighbours
+      std::vector<int> start(1, 0);
+      std::vector<int> neighbours;
+      std::vector<int> atom_neighbours;
+      for(int atom = 0; atom < num_local; atom++){
+         exchange::get_neighbours(atom, atom_neighbours);
+         neighbours.insert(neighbours.end(), atom_neighbours.begin(), atom_neighbours.end());
+         start.push_back(neighbours.size());
+      }
+
+      colour.resize(num_local);
+
+      // sublattice colourings from unit cell atom and parity of unit cell position
+      const uint64_t ncx = cs::total_num_unit_cells[0];
+      const uint64_t ncy = cs::total_num_unit_cells[1];
+      const uint64_t nuca = cs::unit_cell.atom.size();
+      const int num_candidates = 3;
+      const int candidate_colours[num_candidates] = { int(nuca), 2*int(nuca), 8*int(nuca) };
+
+      for(int candidate = 0; candidate < num_candidates; candidate++){
+         for(int atom = 0; atom < num_local; atom++){
+            const uint64_t id = atoms::global_id_array[atom];
+            const uint64_t cell = id/nuca;
+            const int uc = id%nuca;
+            const int scx = cell%ncx;
+            const int scy = (cell/ncx)%ncy;
+            const int scz = cell/(ncx*ncy);
+            switch(candidate){
+               case 0: colour[atom] = uc; break;
+               case 1: colour[atom] = 2*uc + ((scx + scy + scz) & 1); break;
+               case 2: colour[atom] = 8*uc + (scx & 1) + 2*(scy & 1) + 4*(scz & 1); break;
+            }
+         }
+         if(valid_colouring(colour, start, neighbours)){
+            zlog << zTs() << "Atoms coloured by sublattice for parallel Monte Carlo with " << candidate_colours[candidate] << " colours" << std::endl;
+            return candidate_colours[candidate];
+         }
+      }
+
+      // otherwise give each atom the lowest colour not used by its neighbours
+      int num_colours = 0;
+      std::vector<int> last_used; // last atom for which each colour was used by a neighbour
+      for(int atom = 0; atom < num_local; atom++){
+         for(int nn = start[atom]; nn < start[atom+1]; nn++){
+            const int natom = neighbours[nn];
+            if(natom < atom) last_used[colour[natom]] = atom;
+         }
+         int c = 0;
+         while(c < num_colours && last_used[c] == atom) c++;
+         if(c == num_colours){
+            num_colours++;
+            last_used.push_back(-1);
+         }
+         colour[atom] = c;
+      }
+
+      zlog << zTs() << "Atoms coloured by greedy algorithm for parallel Monte Carlo with " << num_colours << " colours" << std::endl;
+
+      return num_colours;
+
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to sort atoms into lists for each colour
+   //------------------------------------------------------------------------------
+   void group_by_colour(const std::vector<int>& atom_list, const std::vector<int>& colour, const int num_colours,
+                        std::vector<std::vector<int> >& colour_lists){
+
+      colour_lists.assign(num_colours, std::vector<int>(0));
+      for(unsigned int i = 0; i < atom_list.size(); i++) colour_lists[colour[atom_list[i]]].push_back(atom_list[i]);
+
+      // remove unused colours
+      std::vector<std::vector<int> > used_lists;
+      for(int c = 0; c < num_colours; c++){
+         if(colour_lists[c].size() > 0) used_lists.push_back(colour_lists[c]);
+      }
+      colour_lists.swap(used_lists);
+
+      return;
+
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to colour atoms and form lists for each set of atoms updated
+   // together (all atoms in serial, or core and boundary atoms of each octant
+   // in parallel)
+   //------------------------------------------------------------------------------
+   void coloured_mc_init(){
+
+      #ifdef MPICF
+         const int num_local = vmpi::num_core_atoms + vmpi::num_bdry_atoms;
+      #else
+         const int num_local = atoms::num_atoms;
+      #endif
+
+      std::vector<int> colour;
+      const int num_colours = colour_atoms(num_local, colour);
+
+      #ifdef MPICF
+         internal::colour_sets.resize(16);
+         for(int octant = 0; octant < 8; octant++){
+            group_by_colour(internal::c_octants[octant], colour, num_colours, internal::colour_sets[2*octant]);
+            group_by_colour(internal::b_octants[octant], colour, num_colours, internal::colour_sets[2*octant+1]);
+         }
+      #else
+         std::vector<int> atom_list(num_local);
+         for(int atom = 0; atom < num_local; atom++) atom_list[atom] = atom;
+         internal::colour_sets.resize(1);
+         group_by_colour(atom_list, colour, num_colours, internal::colour_sets[0]);
+      #endif
+
+      internal::coloured_mc_initialized = true;
+
+      zlog << zTs() << "Coloured Monte Carlo sweeps each atom once per step in colour order instead of selecting atoms at random. "
+           << "The equilibrium distribution is unchanged but the sequence of states differs from the monte-carlo integrator." << std::endl;
+
+      return;
+
+   }
+
+   //------------------------------------------------------------------------------
+   // Function to update all atoms in a set, one colour at a time. Atoms of the
+   // same colour are updated in parallel by all threads. Random numbers for each
+   // trial move come from the counter based generator with the atom id and total
+   // step count as the counter, so that results do not depend on the number of
+   // threads and a run continued from a checkpoint does not repeat earlier steps.
+   //------------------------------------------------------------------------------
+   void coloured_sweep(const std::vector<std::vector<int> >& colour_lists,
+                       const std::vector<double>& rescaled_material_kBTBohr,
+                       const std::vector<double>& sigma_array,
+                       double& statistics_moves,
+                       double& statistics_reject){
+
+      const uint64_t step = sim::total_steps;
+      const uint32_t seed = mtrandom::integration_seed;
+
+      for(unsigned int c = 0; c < colour_lists.size(); c++){
+
+         const int* const list = &colour_lists[c][0];
+         const int nmoves = colour_lists[c].size();
+
+         double moves = 0.0;
+         double reject = 0.0;
+
+         #pragma omp parallel for schedule(static) reduction(+:moves,reject)
+         for(int i = 0; i < nmoves; i++){
+
+            moves += 1.0;
+
+            const int atom = list[i];
+            const int imaterial = atoms::type_array[atom];
+
+            // random numbers for move (three gaussian) and acceptance (uniform)
+            double g[3];
+            double u;
+            mtrandom::philox_numbers(atoms::global_id_array[atom], step, seed, 1, g, u);
+
+            // Save old spin position
+            const double Sold[3] = { atoms::x_spin_array[atom], atoms::y_spin_array[atom], atoms::z_spin_array[atom] };
+
+            // Select move type
+            algorithm_t move = internal::algorithm;
+            if(move == hinzke_nowak){
+               double gm[3];
+               double um;
+               mtrandom::philox_numbers(atoms::global_id_array[atom], step, seed, 2, gm, um);
+               const int pick_move = int(3.0*um);
+               move = pick_move == 0 ? spin_flip : pick_move == 1 ? uniform : angle;
+            }
+
+            // Make Monte Carlo move
+            double Snew[3];
+            switch(move){
+               case spin_flip:
+                  Snew[0] = -Sold[0];
+                  Snew[1] = -Sold[1];
+                  Snew[2] = -Sold[2];
+                  break;
+               case uniform:
+                  Snew[0] = g[0];
+                  Snew[1] = g[1];
+                  Snew[2] = g[2];
+                  break;
+               default:{
+                  const double width = move == adaptive ? internal::adaptive_sigma : sigma_array[imaterial];
+                  Snew[0] = Sold[0] + g[0]*width;
+                  Snew[1] = Sold[1] + g[1]*width;
+                  Snew[2] = Sold[2] + g[2]*width;
+                  break;
+               }
+            }
+            if(move != spin_flip){
+               const double r = 1.0/sqrt(Snew[0]*Snew[0] + Snew[1]*Snew[1] + Snew[2]*Snew[2]);
+               Snew[0] *= r;
+               Snew[1] *= r;
+               Snew[2] *= r;
+            }
+
+            // Calculate energy difference in Joules/mu_B
+            const double DE = sim::calculate_spin_energy_difference(atom, Sold, Snew)*internal::mu_s_SI[imaterial]*1.07828231e23; //1/9.27400915e-24
+
+            // Accept lower energy states unconditionally, otherwise evaluate probability for move
+            if(DE < 0 || exp(-DE*rescaled_material_kBTBohr[imaterial]) >= u){
+               atoms::x_spin_array[atom] = Snew[0];
+               atoms::y_spin_array[atom] = Snew[1];
+               atoms::z_spin_array[atom] = Snew[2];
+            }
+            else reject += 1.0;
+
+         }
+
+         statistics_moves += moves;
+         statistics_reject += reject;
+
+      }
+
+      return;
+
+   }
+
+} // end of namespace internal
+
+//------------------------------------------------------------------------------
+// Integrates a Monte Carlo step where atoms are visited in order of their
+// colour in the exchange graph. Since atoms of the same colour do not interact
+// they are updated in parallel using OpenMP threads, with the parallel
+// octant scheme of mc_step_parallel used between processors.
+//
+// Unlike mc_step, which makes num_atoms trial moves at randomly selected
+// atoms, every atom is tried exactly once per step. The sweep samples the same
+// equilibrium distribution (global rather than detailed balance) but gives a
+// different Markov chain, so the two integrators are not interchangeable for
+// step dependent quantities.
+//------------------------------------------------------------------------------
+void mc_step_coloured(){
+
+   if(!internal::coloured_mc_initialized) internal::coloured_mc_init();
+
+   // Material dependent temperature rescaling
+   std::vector<double> rescaled_material_kBTBohr(internal::num_materials);
+   std::vector<double> sigma_array(internal::num_materials); // range for tuned gaussian random move
+   for(int m=0; m<internal::num_materials; ++m){
+      double alpha = internal::temperature_rescaling_alpha[m];
+      double Tc = internal::temperature_rescaling_Tc[m];
+      double rescaled_temperature = sim::temperature < Tc ? Tc*pow(sim::temperature/Tc,alpha) : sim::temperature;
+      rescaled_material_kBTBohr[m] = 9.27400915e-24/(rescaled_temperature*1.3806503e-23);
+      sigma_array[m] = rescaled_temperature < 1.0 ? 0.02 : pow(1.0/rescaled_material_kBTBohr[m],0.2)*0.08;
+   }
+
+   double statistics_moves = 0.0;
+   double statistics_reject = 0.0;
+
+   #ifdef MPICF
+
+      // loop over all octants
+      for(int octant = 0; octant < 8; octant++) {
+
+         //Initialise non-blocking send
+         vmpi::mpi_init_halo_swap();
+
+         // Integrate core region
+         internal::coloured_sweep(internal::colour_sets[2*octant], rescaled_material_kBTBohr, sigma_array, statistics_moves, statistics_reject);
+
+         // Finish non-blocking data send/receive
+         vmpi::mpi_complete_halo_swap();
+
+         // Integrate boundary region
+         internal::coloured_sweep(internal::colour_sets[2*octant+1], rescaled_material_kBTBohr, sigma_array, statistics_moves, statistics_reject);
+
+         // Swap timers compute -> wait
+         vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
+
+         // Wait for other processors
+         vmpi::barrier();
+
+         // Swap timers wait -> compute
+         vmpi::TotalWaitTime += vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
+
+      }
+
+      //Collect statistics from all processors
+      double global_statistics_moves = 0.0;
+      double global_statistics_reject = 0.0;
+      MPI_Allreduce(&statistics_moves, &global_statistics_moves, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      MPI_Allreduce(&statistics_reject, &global_statistics_reject, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+   #else
+
+      internal::coloured_sweep(internal::colour_sets[0], rescaled_material_kBTBohr, sigma_array, statistics_moves, statistics_reject);
+
+      const double global_statistics_moves = statistics_moves;
+      const double global_statistics_reject = statistics_reject;
+
+   #endif
+
+   // calculate new adaptive step sigma angle (on per-processor basis using local, not global stats)
+   if(montecarlo::internal::algorithm == montecarlo::internal::adaptive && statistics_moves > 0.0){
+      const double last_rejection_rate = statistics_reject / statistics_moves;
+      const double factor = 0.5 / last_rejection_rate;
+      montecarlo::internal::adaptive_sigma *= factor;
+      // check for excessive range (too small angle takes too long to grow, too large does not improve performance) and truncate
+      if (montecarlo::internal::adaptive_sigma > 60.0 || montecarlo::internal::adaptive_sigma < 1e-5) montecarlo::internal::adaptive_sigma = 60.0;
+   }
+
+   // Save statistics to sim namespace variable
+   sim::mc_statistics_moves += global_statistics_moves;
+   sim::mc_statistics_reject += global_statistics_reject;
+
+   return;
+
+}
+
+} // End of namespace montecarlo
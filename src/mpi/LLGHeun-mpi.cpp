@@ -63,25 +63,11 @@ int LLG_Heun_mpi(){
 	const int post_comm_si = vmpi::num_core_atoms;
 	const int post_comm_ei = vmpi::num_core_atoms+vmpi::num_bdry_atoms;
 
-	double xyz[3];		/// Local Delta Spin Components
-	double S_new[3];	/// New Local Spin Moment
-	double mod_S;		/// magnitude of spin moment
-
 		//----------------------------------------
 		// Initiate halo swap
 		//----------------------------------------
 		vmpi::mpi_init_halo_swap();
 
-		//----------------------------------------
-		// Store initial spin positions (all)
-		//----------------------------------------
-
-		for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
-			x_initial_spin_array[atom] = atoms::x_spin_array[atom];
-			y_initial_spin_array[atom] = atoms::y_spin_array[atom];
-			z_initial_spin_array[atom] = atoms::z_spin_array[atom];
-			}
-
 		//----------------------------------------
 		// Calculate fields (core)
 		//----------------------------------------
@@ -89,50 +75,6 @@ int LLG_Heun_mpi(){
 		calculate_spin_fields(pre_comm_si,pre_comm_ei);
 		calculate_external_fields(pre_comm_si,pre_comm_ei);
 
-		//----------------------------------------
-		// Calculate Euler Step (Core)
-		//----------------------------------------
-
-		for(int atom=pre_comm_si;atom<pre_comm_ei;atom++){
-
-			const int imaterial=atoms::type_array[atom];
-			const double one_oneplusalpha_sq = material_parameters::material[imaterial].one_oneplusalpha_sq;
-			const double alpha_oneplusalpha_sq = material_parameters::material[imaterial].alpha_oneplusalpha_sq;
-
-			// Store local spin in Sand local field in H
-			const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
-			const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
-										atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
-										atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
-
-			// Calculate Delta S
-			xyz[0]=(one_oneplusalpha_sq)*(S[1]*H[2]-S[2]*H[1]) + (alpha_oneplusalpha_sq)*(S[1]*(S[0]*H[1]-S[1]*H[0])-S[2]*(S[2]*H[0]-S[0]*H[2]));
-			xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
-			xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
-
-			// Store dS in euler array
-			x_euler_array[atom]=xyz[0];
-			y_euler_array[atom]=xyz[1];
-			z_euler_array[atom]=xyz[2];
-
-			// Calculate Euler Step
-			S_new[0]=S[0]+xyz[0]*material_parameters::dt;
-			S_new[1]=S[1]+xyz[1]*material_parameters::dt;
-			S_new[2]=S[2]+xyz[2]*material_parameters::dt;
-
-			// Normalise Spin Length
-			mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
-
-			S_new[0]=S_new[0]*mod_S;
-			S_new[1]=S_new[1]*mod_S;
-			S_new[2]=S_new[2]*mod_S;
-
-			//Writing of Spin Values to Storage Array
-			x_spin_storage_array[atom]=S_new[0];
-			y_spin_storage_array[atom]=S_new[1];
-			z_spin_storage_array[atom]=S_new[2];
-		}
-
 		//----------------------------------------
 		// Complete halo swap
 		//----------------------------------------
@@ -146,10 +88,17 @@ int LLG_Heun_mpi(){
 		calculate_external_fields(post_comm_si,post_comm_ei);
 
 		//----------------------------------------
-		// Calculate Euler Step (boundary)
+		// Calculate Euler Step (all)
 		//----------------------------------------
+		// Spins are updated in place, and so the step is only taken once the
+		// boundary fields have used the initial core spins. Halo data are
+		// packed when the swap is initiated and are unaffected.
+
+		#pragma omp parallel for schedule(static)
+		for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
 
-		for(int atom=post_comm_si;atom<post_comm_ei;atom++){
+			double xyz[3];		/// Local Delta Spin Components
+			double S_new[3];	/// New Local Spin Moment
 
 			const int imaterial=atoms::type_array[atom];
 			const double one_oneplusalpha_sq = material_parameters::material[imaterial].one_oneplusalpha_sq;
@@ -166,10 +115,10 @@ int LLG_Heun_mpi(){
 			xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
 			xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
 
-			// Store dS in euler array
-			x_euler_array[atom]=xyz[0];
-			y_euler_array[atom]=xyz[1];
-			z_euler_array[atom]=xyz[2];
+			// Store partial Heun step S + dS dt/2 in euler array
+			x_euler_array[atom]=S[0]+xyz[0]*material_parameters::half_dt;
+			y_euler_array[atom]=S[1]+xyz[1]*material_parameters::half_dt;
+			z_euler_array[atom]=S[2]+xyz[2]*material_parameters::half_dt;
 
 			// Calculate Euler Step
 			S_new[0]=S[0]+xyz[0]*material_parameters::dt;
@@ -177,25 +126,12 @@ int LLG_Heun_mpi(){
 			S_new[2]=S[2]+xyz[2]*material_parameters::dt;
 
 			// Normalise Spin Length
-			mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
-
-			S_new[0]=S_new[0]*mod_S;
-			S_new[1]=S_new[1]*mod_S;
-			S_new[2]=S_new[2]*mod_S;
+			const double mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
 
-			//Writing of Spin Values to Storage Array
-			x_spin_storage_array[atom]=S_new[0];
-			y_spin_storage_array[atom]=S_new[1];
-			z_spin_storage_array[atom]=S_new[2];
-		}
-
-		//----------------------------------------
-		// Copy new spins to spin array (all)
-		//----------------------------------------
-		for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
-			atoms::x_spin_array[atom]=x_spin_storage_array[atom];
-			atoms::y_spin_array[atom]=y_spin_storage_array[atom];
-			atoms::z_spin_array[atom]=z_spin_storage_array[atom];
+			// Write predicted spins to spin array
+			atoms::x_spin_array[atom]=S_new[0]*mod_S;
+			atoms::y_spin_array[atom]=S_new[1]*mod_S;
+			atoms::z_spin_array[atom]=S_new[2]*mod_S;
 		}
 
 		//------------------------------------------
@@ -209,33 +145,6 @@ int LLG_Heun_mpi(){
 
 		calculate_spin_fields(pre_comm_si,pre_comm_ei);
 
-		//----------------------------------------
-		// Calculate Heun Gradients (core)
-		//----------------------------------------
-
-		for(int atom=pre_comm_si;atom<pre_comm_ei;atom++){
-
-			const int imaterial=atoms::type_array[atom];;
-			const double one_oneplusalpha_sq = material_parameters::material[imaterial].one_oneplusalpha_sq;
-			const double alpha_oneplusalpha_sq = material_parameters::material[imaterial].alpha_oneplusalpha_sq;
-
-			// Store local spin in Sand local field in H
-			const double S[3] = {atoms::x_spin_array[atom],atoms::y_spin_array[atom],atoms::z_spin_array[atom]};
-			const double H[3] = {atoms::x_total_spin_field_array[atom]+atoms::x_total_external_field_array[atom],
-										atoms::y_total_spin_field_array[atom]+atoms::y_total_external_field_array[atom],
-										atoms::z_total_spin_field_array[atom]+atoms::z_total_external_field_array[atom]};
-
-			// Calculate Delta S
-			xyz[0]=(one_oneplusalpha_sq)*(S[1]*H[2]-S[2]*H[1]) + (alpha_oneplusalpha_sq)*(S[1]*(S[0]*H[1]-S[1]*H[0])-S[2]*(S[2]*H[0]-S[0]*H[2]));
-			xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
-			xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
-
-			// Store dS in heun array
-			x_heun_array[atom]=xyz[0];
-			y_heun_array[atom]=xyz[1];
-			z_heun_array[atom]=xyz[2];
-		}
-
 		//------------------------------------------
 		// Complete second halo swap
 		//------------------------------------------
@@ -248,12 +157,16 @@ int LLG_Heun_mpi(){
 		calculate_spin_fields(post_comm_si,post_comm_ei);
 
 		//----------------------------------------
-		// Calculate Heun Gradients (boundary)
+		// Calculate Heun Step (all)
 		//----------------------------------------
 
-		for(int atom=post_comm_si;atom<post_comm_ei;atom++){
+		#pragma omp parallel for schedule(static)
+		for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
+
+			double xyz[3];		/// Local Delta Spin Components
+			double S_new[3];	/// New Local Spin Moment
 
-			const int imaterial=atoms::type_array[atom];;
+			const int imaterial=atoms::type_array[atom];
 			const double one_oneplusalpha_sq = material_parameters::material[imaterial].one_oneplusalpha_sq;
 			const double alpha_oneplusalpha_sq = material_parameters::material[imaterial].alpha_oneplusalpha_sq;
 
@@ -268,34 +181,20 @@ int LLG_Heun_mpi(){
 			xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
 			xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
 
-			// Store dS in heun array
-			x_heun_array[atom]=xyz[0];
-			y_heun_array[atom]=xyz[1];
-			z_heun_array[atom]=xyz[2];
-		}
-
-		//----------------------------------------
-		// Calculate Heun Step
-		//----------------------------------------
-
-		for(int atom=pre_comm_si;atom<post_comm_ei;atom++){
-			S_new[0]=x_initial_spin_array[atom]+material_parameters::half_dt*(x_euler_array[atom]+x_heun_array[atom]);
-			S_new[1]=y_initial_spin_array[atom]+material_parameters::half_dt*(y_euler_array[atom]+y_heun_array[atom]);
-			S_new[2]=z_initial_spin_array[atom]+material_parameters::half_dt*(z_euler_array[atom]+z_heun_array[atom]);
+			// Complete Heun step
+			S_new[0]=x_euler_array[atom]+xyz[0]*material_parameters::half_dt;
+			S_new[1]=y_euler_array[atom]+xyz[1]*material_parameters::half_dt;
+			S_new[2]=z_euler_array[atom]+xyz[2]*material_parameters::half_dt;
 
 			// Normalise Spin Length
-			mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
-
-			S_new[0]=S_new[0]*mod_S;
-			S_new[1]=S_new[1]*mod_S;
-			S_new[2]=S_new[2]*mod_S;
+			const double mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
 
 			//----------------------------------------
 			// Copy new spins to spin array
 			//----------------------------------------
-			atoms::x_spin_array[atom]=S_new[0];
-			atoms::y_spin_array[atom]=S_new[1];
-			atoms::z_spin_array[atom]=S_new[2];
+			atoms::x_spin_array[atom]=S_new[0]*mod_S;
+			atoms::y_spin_array[atom]=S_new[1]*mod_S;
+			atoms::z_spin_array[atom]=S_new[2]*mod_S;
 		}
 
 	// Swap timers compute -> wait
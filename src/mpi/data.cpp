@@ -21,6 +21,9 @@ namespace vmpi{
 
    int mpi_mode=0;
    unsigned int ppn=1;  ///< Processors per node
+   bool weighted_decomposition=false; ///< Flag to balance geometric decomposition by number of atoms
+   bool single_precision_halo=false; ///< Flag to exchange halo spin data in single precision
+   bool shared_memory_halo=false; ///< Flag to exchange halo spin data on same node through shared memory
    int my_rank=0;
    int num_processors=1;
    int num_core_atoms;
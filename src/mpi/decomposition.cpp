@@ -8,9 +8,12 @@
 //-----------------------------------------------------------------------------
 
 // C++ standard library headers
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 
 // Vampire headers
+#include "errors.hpp"
 #include "vmpi.hpp"
 #include "vio.hpp"
 
@@ -277,4 +280,184 @@ namespace vmpi{
 
    }
 
+   //-----------------------------------------------------------------------------------
+   // Function to decompose system by recursive coordinate bisection weighted by the
+   // number of atoms, so that each process has approximately the same number of atoms.
+   //
+   // The system is recursively divided into two blocks along the longest block
+   // dimension, with each block assigned a contiguous range of processes. Cuts are
+   // made at unit cell boundaries so that the number of atoms on each side is
+   // proportional to the number of processes assigned to it. All blocks on the same
+   // level of the tree are bisected together, requiring a single reduction of atom
+   // histograms per level. Block dimensions are calculated from integer unit cell
+   // numbers and so are identical on all processes.
+   //
+   // Atom coordinates (x,y,z packed) are those generated on each process for the
+   // initial geometric decomposition.
+   //-----------------------------------------------------------------------------------
+   void recursive_bisection_decomposition(double system_size[3], double cell_size[3], int num_cells[3], std::vector<double>& coordinates){
+
+      // local struct for storing block of unit cells and range of processes
+      struct block_t{
+         int min[3]; // first unit cell in block
+         int max[3]; // last unit cell in block + 1
+         int first_rank; // first process assigned to block
+         int num_ranks; // number of processes assigned to block
+         uint64_t num_atoms; // total number of atoms in block
+      };
+
+      const uint64_t num_local_atoms = coordinates.size()/3;
+
+      // determine unit cell coordinates of local atoms
+      std::vector<int> atom_cells(3*num_local_atoms);
+      for(uint64_t atom = 0; atom < num_local_atoms; atom++){
+         for(int d = 0; d < 3; d++){
+            const int c = int(coordinates[3*atom+d]/cell_size[d]);
+            atom_cells[3*atom+d] = std::max(0, std::min(num_cells[d]-1, c));
+         }
+      }
+
+      // block containing each local atom
+      std::vector<int> atom_block(num_local_atoms, 0);
+
+      // initialise single block containing whole system and all processes
+      std::vector<block_t> blocks(1);
+      for(int d = 0; d < 3; d++){
+         blocks[0].min[d] = 0;
+         blocks[0].max[d] = num_cells[d];
+      }
+      blocks[0].first_rank = 0;
+      blocks[0].num_ranks = vmpi::num_processors;
+      blocks[0].num_atoms = vmpi::all_reduce_sum(num_local_atoms);
+
+      // bisect blocks level by level until each block has a single process
+      int num_levels = 0;
+      while(blocks.size() < static_cast<size_t>(vmpi::num_processors)){
+
+         const int num_blocks = blocks.size();
+
+         // choose direction to bisect and offset in histogram for each block
+         std::vector<int> axis(num_blocks, 0);
+         std::vector<int> offset(num_blocks, 0);
+         int histogram_size = 0;
+         for(int b = 0; b < num_blocks; b++){
+            if(blocks[b].num_ranks == 1) continue;
+            double max_length = 0.0;
+            for(int d = 0; d < 3; d++){
+               const double length = double(blocks[b].max[d] - blocks[b].min[d])*cell_size[d];
+               if(blocks[b].max[d] - blocks[b].min[d] > 1 && length > max_length){
+                  max_length = length;
+                  axis[b] = d;
+               }
+            }
+            // check that block can be divided
+            if(max_length == 0.0){
+               terminaltextcolor(RED);
+               std::cerr << "Error - system is too small to be decomposed into " << vmpi::num_processors << " processes. Reduce the number of processes or increase system dimensions." << std::endl;
+               terminaltextcolor(WHITE);
+               zlog << zTs() << "Error - system is too small to be decomposed into " << vmpi::num_processors << " processes. Exiting." << std::endl;
+               err::vexit();
+            }
+            offset[b] = histogram_size;
+            histogram_size += blocks[b].max[axis[b]] - blocks[b].min[axis[b]];
+         }
+
+         // calculate global histogram of atoms along bisection direction for each block
+         std::vector<uint64_t> histogram(histogram_size, 0);
+         for(uint64_t atom = 0; atom < num_local_atoms; atom++){
+            const int b = atom_block[atom];
+            if(blocks[b].num_ranks == 1) continue;
+            const int a = axis[b];
+            histogram[offset[b] + atom_cells[3*atom+a] - blocks[b].min[a]]++;
+         }
+         #ifdef MPICF
+            MPI_Allreduce(MPI_IN_PLACE, &histogram[0], histogram_size, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+         #endif
+
+         // bisect blocks at unit cell closest to target number of atoms
+         std::vector<block_t> new_blocks;
+         std::vector<int> cut(num_blocks, 0);
+         std::vector<int> first_child(num_blocks, 0);
+         for(int b = 0; b < num_blocks; b++){
+
+            first_child[b] = new_blocks.size();
+
+            if(blocks[b].num_ranks == 1){
+               new_blocks.push_back(blocks[b]);
+               continue;
+            }
+
+            const int a = axis[b];
+            const int num_lower_ranks = blocks[b].num_ranks/2;
+            const double target = double(blocks[b].num_atoms)*double(num_lower_ranks)/double(blocks[b].num_ranks);
+
+            // find cut position leaving at least one unit cell on each side
+            uint64_t sum = histogram[offset[b]];
+            uint64_t lower_atoms = sum;
+            cut[b] = blocks[b].min[a] + 1;
+            double best = fabs(double(sum) - target);
+            for(int c = blocks[b].min[a] + 2; c < blocks[b].max[a]; c++){
+               sum += histogram[offset[b] + c - 1 - blocks[b].min[a]];
+               if(fabs(double(sum) - target) < best){
+                  best = fabs(double(sum) - target);
+                  cut[b] = c;
+                  lower_atoms = sum;
+               }
+            }
+
+            block_t lower = blocks[b];
+            block_t upper = blocks[b];
+            lower.max[a] = cut[b];
+            lower.num_ranks = num_lower_ranks;
+            lower.num_atoms = lower_atoms;
+            upper.min[a] = cut[b];
+            upper.first_rank = blocks[b].first_rank + num_lower_ranks;
+            upper.num_ranks = blocks[b].num_ranks - num_lower_ranks;
+            upper.num_atoms = blocks[b].num_atoms - lower_atoms;
+            new_blocks.push_back(lower);
+            new_blocks.push_back(upper);
+
+         }
+
+         // reassign atoms to new blocks
+         for(uint64_t atom = 0; atom < num_local_atoms; atom++){
+            const int b = atom_block[atom];
+            if(blocks[b].num_ranks == 1) atom_block[atom] = first_child[b];
+            else atom_block[atom] = first_child[b] + (atom_cells[3*atom+axis[b]] < cut[b] ? 0 : 1);
+         }
+
+         blocks.swap(new_blocks);
+         num_levels++;
+
+      }
+
+      // determine load imbalance factor (maximum/mean atoms per process)
+      uint64_t max_atoms = 0;
+      uint64_t total_atoms = 0;
+      for(size_t b = 0; b < blocks.size(); b++){
+         max_atoms = std::max(max_atoms, blocks[b].num_atoms);
+         total_atoms += blocks[b].num_atoms;
+      }
+      const double imbalance = total_atoms > 0 ? double(max_atoms)*double(blocks.size())/double(total_atoms) : 1.0;
+
+      // Output informative message to screen and log file
+      if(vmpi::my_rank==0){
+         std::cout << "System decomposed into " << blocks.size() << " processors by atom-weighted recursive bisection" << std::endl;
+         zlog << zTs() << "System decomposed into " << blocks.size() << " processors by atom-weighted recursive bisection in " << num_levels << " levels" << std::endl;
+         zlog << zTs() << "Estimated load imbalance factor (maximum/mean atoms per process): " << imbalance << std::endl;
+      }
+
+      // set namespace variables for partial system generation (top boundary is system size)
+      for(size_t b = 0; b < blocks.size(); b++){
+         if(blocks[b].first_rank != vmpi::my_rank) continue;
+         for(int d = 0; d < 3; d++){
+            vmpi::min_dimensions[d] = double(blocks[b].min[d])*cell_size[d];
+            vmpi::max_dimensions[d] = blocks[b].max[d] == num_cells[d] ? system_size[d] : double(blocks[b].max[d])*cell_size[d];
+         }
+      }
+
+      return;
+
+   }
+
 } // end of namespace vmpi
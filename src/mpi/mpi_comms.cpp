@@ -37,11 +37,244 @@
 //=====================================================================================
 #include "atoms.hpp"
 #include "errors.hpp"
+#include "vio.hpp"
 #include "vmpi.hpp"
 #include <iostream>
+#include <stdint.h>
+#include <thread>
 
 namespace vmpi{
 
+#ifdef MPICF
+namespace{
+
+	//----------------------------------------------------------------------------
+	// Persistent halo swap
+	//
+	// Send and receive requests for the halo swap are created once with
+	// MPI_Send_init/MPI_Recv_init on the packed spin data buffers and restarted
+	// every halo swap with MPI_Startall, avoiding the setup cost of new requests
+	// for every swap. Spin data are optionally exchanged in single precision,
+	// halving the message size.
+	//
+	// Optionally, spins sent to processes on the same node are instead packed
+	// into an MPI-3 shared memory window, from which the receiving process
+	// copies them directly, so that only halos between nodes are sent as
+	// messages. Each window region holds two copies of the send data used on
+	// alternate swaps, so that a process may pack the next swap while its
+	// neighbours are still reading the previous one.
+	//
+	// Only halo neighbours are synchronised. The start of each window region
+	// holds two counters written by its owner: the last swap packed, and the
+	// last swap for which all on-node halos have been read. A process waits
+	// for the packed counter of each process it receives from before reading,
+	// and for the read counter of each process it sends to before overwriting
+	// the copy used two swaps earlier.
+	//----------------------------------------------------------------------------
+	bool halo_swap_initialised = false; // flag set when persistent requests are created
+	std::vector<float> send_spin_data_float; // single precision send buffer
+	std::vector<float> recv_spin_data_float; // single precision receive buffer
+
+	bool shared_halo = false; // flag set when shared memory window is used for on-node halos
+	MPI_Comm node_comm; // communicator for processes on local node
+	MPI_Win shared_window; // shared memory window for on-node halo data
+	double* shared_send_buffer = NULL; // local region of shared window (two copies of send data)
+	std::vector<bool> on_node; // flag for processes on local node
+	std::vector<const double*> peer_send_buffer; // shared window region of on-node processes
+	std::vector<int> peer_buffer_size; // size of single copy of send data for on-node processes
+	std::vector<int> peer_start_index; // start index of data for this process in remote send data
+	int shared_buffer_id = 0; // copy of send data in use for current swap
+
+	const int num_header_doubles = 8; // space reserved for counters at start of window region (one cache line)
+	const int packed_counter = 0; // index of counter of last swap packed by owner
+	const int read_counter = 1; // index of counter of last swap read by owner
+	volatile int64_t* shared_counters = NULL; // counters in local region of shared window
+	std::vector<volatile int64_t*> peer_counters; // counters of on-node processes
+	int64_t shared_swap = 0; // number of current shared memory halo swap
+
+	//----------------------------------------------------------------------------
+	// Function to wait until counter of on-node process reaches value
+	//----------------------------------------------------------------------------
+	void wait_for_counter(volatile int64_t* counters, const int index, const int64_t value){
+		while(counters[index] < value){
+			std::this_thread::yield();
+			MPI_Win_sync(shared_window);
+		}
+		// ensure data written before counter are seen
+		MPI_Win_sync(shared_window);
+		return;
+	}
+
+	//----------------------------------------------------------------------------
+	// Function to create shared memory window for halo swap between processes
+	// on the same node
+	//----------------------------------------------------------------------------
+	void initialise_shared_halo(){
+
+		// create communicator for processes which can share memory
+		MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, vmpi::my_rank, MPI_INFO_NULL, &node_comm);
+
+		int node_size = 0;
+		MPI_Comm_size(node_comm, &node_size);
+
+		// determine node rank of all processes (MPI_UNDEFINED if on a different node)
+		std::vector<int> world_ranks(vmpi::num_processors);
+		std::vector<int> node_ranks(vmpi::num_processors);
+		for(int p=0;p<vmpi::num_processors;p++) world_ranks[p] = p;
+		MPI_Group world_group, node_group;
+		MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+		MPI_Comm_group(node_comm, &node_group);
+		MPI_Group_translate_ranks(world_group, vmpi::num_processors, &world_ranks[0], node_group, &node_ranks[0]);
+		MPI_Group_free(&world_group);
+		MPI_Group_free(&node_group);
+
+		// determine start index of my data in send data of all processes
+		peer_start_index.resize(vmpi::num_processors);
+		MPI_Alltoall(&vmpi::send_start_index_array[0], 1, MPI_INT, &peer_start_index[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+		// allocate counters and two copies of send data in shared window
+		const int buffer_size = vmpi::send_spin_data_array.size();
+		double* window_region = NULL;
+		MPI_Win_allocate_shared(MPI_Aint((num_header_doubles + 2*buffer_size)*sizeof(double)), sizeof(double), MPI_INFO_NULL, node_comm, &window_region, &shared_window);
+		MPI_Win_lock_all(MPI_MODE_NOCHECK, shared_window);
+		shared_counters = reinterpret_cast<volatile int64_t*>(window_region);
+		shared_counters[packed_counter] = 0;
+		shared_counters[read_counter] = 0;
+		shared_send_buffer = window_region + num_header_doubles;
+		shared_swap = 0;
+
+		// get addresses of counters and shared send data for on-node processes
+		on_node.assign(vmpi::num_processors, false);
+		peer_counters.assign(vmpi::num_processors, NULL);
+		peer_send_buffer.assign(vmpi::num_processors, NULL);
+		peer_buffer_size.assign(vmpi::num_processors, 0);
+		for(int p=0;p<vmpi::num_processors;p++){
+			if(node_ranks[p] == MPI_UNDEFINED) continue;
+			on_node[p] = true;
+			MPI_Aint size = 0;
+			int disp_unit = 0;
+			double* buffer = NULL;
+			MPI_Win_shared_query(shared_window, node_ranks[p], &size, &disp_unit, &buffer);
+			peer_counters[p] = reinterpret_cast<volatile int64_t*>(buffer);
+			peer_send_buffer[p] = buffer + num_header_doubles;
+			peer_buffer_size[p] = (size/sizeof(double) - num_header_doubles)/2;
+		}
+
+		// ensure counters are initialised before first swap
+		MPI_Win_sync(shared_window);
+		MPI_Barrier(node_comm);
+		MPI_Win_sync(shared_window);
+
+		shared_halo = true;
+
+		zlog << zTs() << "Initialised shared memory halo swap for " << node_size << " processes on node" << std::endl;
+
+		return;
+
+	}
+
+	//----------------------------------------------------------------------------
+	// Function to create persistent requests for halo swap
+	//----------------------------------------------------------------------------
+	void initialise_halo_swap(){
+
+		// optionally exchange on-node halos through shared memory
+		if(vmpi::shared_memory_halo) initialise_shared_halo();
+		else on_node.assign(vmpi::num_processors, false);
+
+		vmpi::requests.resize(0);
+
+		// select buffers and data type for precision of halo data
+		char* send_buffer = reinterpret_cast<char*>(vmpi::send_spin_data_array.data());
+		char* recv_buffer = reinterpret_cast<char*>(vmpi::recv_spin_data_array.data());
+		MPI_Datatype data_type = MPI_DOUBLE;
+		size_t data_size = sizeof(double);
+
+		if(vmpi::single_precision_halo){
+			send_spin_data_float.resize(vmpi::send_spin_data_array.size());
+			recv_spin_data_float.resize(vmpi::recv_spin_data_array.size());
+			send_buffer = reinterpret_cast<char*>(send_spin_data_float.data());
+			recv_buffer = reinterpret_cast<char*>(recv_spin_data_float.data());
+			data_type = MPI_FLOAT;
+			data_size = sizeof(float);
+		}
+
+		// create requests for processes on other nodes
+		for (int p=0;p<vmpi::num_processors;p++){
+			if(on_node[p]) continue;
+			if(vmpi::send_num_array[p]!=0){
+				int num_pts = 3*vmpi::send_num_array[p];
+				size_t si = 3*vmpi::send_start_index_array[p];
+				vmpi::requests.push_back(MPI_REQUEST_NULL);
+				MPI_Send_init(send_buffer + si*data_size, num_pts, data_type, p, 48, MPI_COMM_WORLD, &vmpi::requests.back());
+			}
+			if(vmpi::recv_num_array[p]!=0){
+				int num_pts = 3*vmpi::recv_num_array[p];
+				size_t si = 3*vmpi::recv_start_index_array[p];
+				vmpi::requests.push_back(MPI_REQUEST_NULL);
+				MPI_Recv_init(recv_buffer + si*data_size, num_pts, data_type, p, 48, MPI_COMM_WORLD, &vmpi::requests.back());
+			}
+		}
+
+		vmpi::stati.resize(vmpi::requests.size());
+
+		halo_swap_initialised = true;
+
+		zlog << zTs() << "Initialised persistent halo swap with " << vmpi::requests.size() << " requests in "
+		     << (vmpi::single_precision_halo ? "single" : "double") << " precision" << std::endl;
+
+		return;
+
+	}
+
+	//----------------------------------------------------------------------------
+	// Function to pack spins of atoms [start, start+num) in send list into buffer
+	//----------------------------------------------------------------------------
+	template <typename T> void pack_spins(T* buffer, const int start, const int num){
+
+		const int* atom_list = vmpi::send_atom_translation_array.data() + start;
+		const double* sx = atoms::x_spin_array.data();
+		const double* sy = atoms::y_spin_array.data();
+		const double* sz = atoms::z_spin_array.data();
+
+		#pragma omp simd
+		for(int i=0;i<num;i++){
+			const int atom = atom_list[i];
+			buffer[3*i+0] = sx[atom];
+			buffer[3*i+1] = sy[atom];
+			buffer[3*i+2] = sz[atom];
+		}
+
+		return;
+
+	}
+
+	//----------------------------------------------------------------------------
+	// Function to unpack spins of atoms [start, start+num) in receive list from
+	// buffer
+	//----------------------------------------------------------------------------
+	template <typename T> void unpack_spins(const T* buffer, const int start, const int num){
+
+		const int* atom_list = vmpi::recv_atom_translation_array.data() + start;
+		double* sx = atoms::x_spin_array.data();
+		double* sy = atoms::y_spin_array.data();
+		double* sz = atoms::z_spin_array.data();
+
+		#pragma omp simd
+		for(int i=0;i<num;i++){
+			const int atom = atom_list[i];
+			sx[atom] = buffer[3*i+0];
+			sy[atom] = buffer[3*i+1];
+			sz[atom] = buffer[3*i+2];
+		}
+
+		return;
+
+	}
+
+} // end of anonymous namespace
+#endif
+
 void mpi_init_halo_swap(){
 	//====================================================================================
 	//
@@ -67,45 +300,47 @@ void mpi_init_halo_swap(){
 		std::cout << vmpi::my_rank << std::endl;
 	}
 
+	// create persistent requests on first call
+	if(!halo_swap_initialised) initialise_halo_swap();
+
 	//----------------------------------------------------------
 	// Pack spins for sending
 	//----------------------------------------------------------
+	if(!shared_halo && vmpi::single_precision_halo){
+		pack_spins(send_spin_data_float.data(), 0, vmpi::send_atom_translation_array.size());
+	}
+	else if(!shared_halo){
+		pack_spins(vmpi::send_spin_data_array.data(), 0, vmpi::send_atom_translation_array.size());
+	}
+	else{
+		shared_swap++;
+		shared_buffer_id = shared_swap % 2;
 
-	//std::cout << "rank: " << vmpi::my_rank << " num_halo_swaps: " << vmpi::send_atom_translation_array.size();
-	//std::cout << "\t" << "num_boundary_swaps: " << vmpi::recv_atom_translation_array.size() << std::endl;
+		// wait for on-node processes to finish reading copy of send data from two swaps ago
+		for(int p=0;p<vmpi::num_processors;p++){
+			if(on_node[p] && vmpi::send_num_array[p] > 0) wait_for_counter(peer_counters[p], read_counter, shared_swap-2);
+		}
 
-	for(unsigned int i=0;i<vmpi::send_atom_translation_array.size();i++){
-		int atom = vmpi::send_atom_translation_array[i];
-		vmpi::send_spin_data_array[3*i+0] = atoms::x_spin_array[atom];
-		vmpi::send_spin_data_array[3*i+1] = atoms::y_spin_array[atom];
-		vmpi::send_spin_data_array[3*i+2] = atoms::z_spin_array[atom];
-		//std::cout << vmpi::my_rank << "\t" << i << "\t";
-		//std::cout << atoms::x_spin_array[vmpi::send_atom_translation_array[i]] << "\t";
-		//std::cout << atoms::y_spin_array[vmpi::send_atom_translation_array[i]] << "\t";
-		//std::cout << atoms::z_spin_array[vmpi::send_atom_translation_array[i]] << std::endl;
+		// pack spins for each process, using shared window for on-node processes
+		const int buffer_size = vmpi::send_spin_data_array.size();
+		for(int p=0;p<vmpi::num_processors;p++){
+			const int num = vmpi::send_num_array[p];
+			if(num==0) continue;
+			const int si = vmpi::send_start_index_array[p];
+			if(on_node[p]) pack_spins(shared_send_buffer + shared_buffer_id*buffer_size + 3*si, si, num);
+			else if(vmpi::single_precision_halo) pack_spins(&send_spin_data_float[3*si], si, num);
+			else pack_spins(&vmpi::send_spin_data_array[3*si], si, num);
+		}
+		// make packed data visible to other processes on node before signalling
+		MPI_Win_sync(shared_window);
+		shared_counters[packed_counter] = shared_swap;
+		MPI_Win_sync(shared_window);
 	}
 
 	//----------------------------------------------------------
-	// Send spin data array and post receives
+	// Start sends and receives of spin data
 	//----------------------------------------------------------
-
-	vmpi::requests.resize(0);
-	MPI_Request req;
-
-	for (int p=0;p<vmpi::num_processors;p++){
-		if(vmpi::send_num_array[p]!=0){
-			int num_pts = 3*vmpi::send_num_array[p];
-			int si = 3*vmpi::send_start_index_array[p];
-			vmpi::requests.push_back(req);
-			MPI_Isend(&vmpi::send_spin_data_array[si],num_pts,MPI_DOUBLE,p,48, MPI_COMM_WORLD, &vmpi::requests.back());
-		}
-		if(vmpi::recv_num_array[p]!=0){
-			int num_pts = 3*vmpi::recv_num_array[p];
-			int si = 3*vmpi::recv_start_index_array[p];
-			vmpi::requests.push_back(req);
-			MPI_Irecv(&vmpi::recv_spin_data_array[si],num_pts,MPI_DOUBLE,p,48, MPI_COMM_WORLD, &vmpi::requests.back());
-		}
-	}
+	if(vmpi::requests.size() > 0) MPI_Startall(vmpi::requests.size(), &vmpi::requests[0]);
 
    #endif
 	//----------------------------------------------------------
@@ -139,21 +374,66 @@ void mpi_complete_halo_swap(){
 	vmpi::TotalComputeTime+=vmpi::SwapTimer(vmpi::ComputeTime, vmpi::WaitTime);
 
 	// Wait for all comms to complete
-	vmpi::stati.resize(vmpi::requests.size());
-	MPI_Waitall(vmpi::requests.size(),&vmpi::requests[0],&vmpi::stati[0]);
+	if(vmpi::requests.size() > 0) MPI_Waitall(vmpi::requests.size(),&vmpi::requests[0],&vmpi::stati[0]);
+
+	// Wait for on-node processes sending halo data to pack it
+	if(shared_halo){
+		for(int p=0;p<vmpi::num_processors;p++){
+			if(on_node[p] && vmpi::recv_num_array[p] > 0) wait_for_counter(peer_counters[p], packed_counter, shared_swap);
+		}
+	}
 
 	// Swap timers wait -> compute
 	vmpi::TotalWaitTime+=vmpi::SwapTimer(vmpi::WaitTime, vmpi::ComputeTime);
 
 	// Unpack received spins
-	for(unsigned int i=0;i<vmpi::recv_atom_translation_array.size();i++){
-		atoms::x_spin_array[vmpi::recv_atom_translation_array[i]] = vmpi::recv_spin_data_array[3*i+0];
-		atoms::y_spin_array[vmpi::recv_atom_translation_array[i]] = vmpi::recv_spin_data_array[3*i+1];
-		atoms::z_spin_array[vmpi::recv_atom_translation_array[i]] = vmpi::recv_spin_data_array[3*i+2];
-		//std::cout << vmpi::my_rank << "\t" << i << "\t" << vmpi::recv_atom_translation_array[i] << "\t";
-		//std::cout << atoms::x_spin_array[vmpi::recv_atom_translation_array[i]] << "\t";
-		//std::cout << atoms::y_spin_array[vmpi::recv_atom_translation_array[i]] << "\t";
-		//std::cout << atoms::z_spin_array[vmpi::recv_atom_translation_array[i]] << std::endl;
+	if(!shared_halo && vmpi::single_precision_halo){
+		unpack_spins(recv_spin_data_float.data(), 0, vmpi::recv_atom_translation_array.size());
+	}
+	else if(!shared_halo){
+		unpack_spins(vmpi::recv_spin_data_array.data(), 0, vmpi::recv_atom_translation_array.size());
+	}
+	else{
+		// unpack spins from each process, reading directly from shared window for on-node processes
+		for(int p=0;p<vmpi::num_processors;p++){
+			const int num = vmpi::recv_num_array[p];
+			if(num==0) continue;
+			const int si = vmpi::recv_start_index_array[p];
+			if(on_node[p]) unpack_spins(peer_send_buffer[p] + shared_buffer_id*peer_buffer_size[p] + 3*peer_start_index[p], si, num);
+			else if(vmpi::single_precision_halo) unpack_spins(&recv_spin_data_float[3*si], si, num);
+			else unpack_spins(&vmpi::recv_spin_data_array[3*si], si, num);
+		}
+		// signal that shared data of this swap have been read
+		MPI_Win_sync(shared_window);
+		shared_counters[read_counter] = shared_swap;
+		MPI_Win_sync(shared_window);
+	}
+
+   #endif
+
+	return;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to free persistent halo swap requests and shared memory window
+// before MPI is finalised
+//------------------------------------------------------------------------------
+void mpi_finalise_halo_swap(){
+
+   #ifdef MPICF
+
+	if(halo_swap_initialised){
+		for(unsigned int r=0; r<vmpi::requests.size(); r++) MPI_Request_free(&vmpi::requests[r]);
+		vmpi::requests.resize(0);
+		halo_swap_initialised = false;
+	}
+
+	if(shared_halo){
+		MPI_Win_unlock_all(shared_window);
+		MPI_Win_free(&shared_window);
+		MPI_Comm_free(&node_comm);
+		shared_halo = false;
 	}
 
    #endif
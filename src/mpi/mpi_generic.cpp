@@ -61,7 +61,16 @@ void initialise(int argc, char *argv[]){
 	int resultlen;
 
 	// Initialise MPI
-	MPI_Init(&argc, &argv);
+	#ifdef _OPENMP
+		// hybrid MPI+threads: all communication is performed by the master thread
+		int thread_support;
+		MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &thread_support);
+		if(thread_support < MPI_THREAD_FUNNELED){
+			std::cerr << "Warning: MPI library does not support MPI_THREAD_FUNNELED, use sim:num-threads = 1" << std::endl;
+		}
+	#else
+		MPI_Init(&argc, &argv);
+	#endif
 
 	// Get number of processors and rank
  	MPI_Comm_rank(MPI_COMM_WORLD, &vmpi::my_rank);
@@ -196,6 +205,9 @@ int finalise(){
 	//	std::cout << "MPI Simulation Time: " << vmpi::end_time-vmpi::start_time << std::endl;
 	//}
 
+	// Free persistent halo swap requests
+	vmpi::mpi_finalise_halo_swap();
+
 	// Finalise MPI
 	MPI_Finalize();
 
@@ -25,11 +25,17 @@ void list_t::clear(){
    // force deallocation by making main object data go out of scope
    // Everybody who loves C++ scoping rules say woo!
 
-   // a simple unallocated array of neighbours
-   std::vector< std::vector <neighbours::neighbour_t> > tmp;
+   // simple unallocated arrays of neighbours
+   std::vector<uint64_t> tmp_start_index;
+   std::vector<int> tmp_nn;
+   std::vector<int> tmp_i;
+   std::vector<uint8_t> tmp_image;
 
    // swap the pointers
-   tmp.swap(list);
+   tmp_start_index.swap(start_index);
+   tmp_nn.swap(nn);
+   tmp_i.swap(i);
+   tmp_image.swap(image);
 
    // leaving unloved memory behind
    return;
@@ -13,11 +13,13 @@
 // C++ standard library headers
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 // Vampire headers
 #include "create_atoms_class.hpp" // class definition for atoms in create module
 #include "errors.hpp"
 #include "neighbours.hpp"
+#include "sim.hpp"
 #include "vio.hpp"
 #include "vmath.hpp"
 #include "vmpi.hpp"
@@ -33,10 +35,81 @@
 
 namespace neighbours{
 
+namespace{
+
+   //-------------------------------------------------------------------------------
+   // Hash table of occupied supercells
+   //
+   // Maps the linear index of each occupied supercell to a contiguous cell id, so
+   // that memory is proportional to the number of atoms rather than the volume of
+   // the bounding box (which may be mostly empty for particles or porous systems).
+   // Uses open addressing with linear probing and a load factor of at most 1/2.
+   //-------------------------------------------------------------------------------
+   class cell_table_t{
+   public:
+
+      // initialise empty table for given maximum number of cells
+      void initialize(const uint64_t max_cells){
+         uint64_t size = 2;
+         bits = 1;
+         while(size < 2*max_cells){
+            size *= 2;
+            bits++;
+         }
+         mask = size - 1;
+         keys.assign(size, -1);
+         ids.assign(size, -1);
+         num_cells = 0;
+      }
+
+      // return cell id for key, adding new cell if not present
+      int insert(const int64_t key){
+         uint64_t slot = hash(key);
+         while(keys[slot] != -1){
+            if(keys[slot] == key) return ids[slot];
+            slot = (slot + 1) & mask;
+         }
+         keys[slot] = key;
+         ids[slot] = num_cells;
+         return num_cells++;
+      }
+
+      // return cell id for key, or -1 if cell is unoccupied
+      int find(const int64_t key) const{
+         uint64_t slot = hash(key);
+         while(keys[slot] != -1){
+            if(keys[slot] == key) return ids[slot];
+            slot = (slot + 1) & mask;
+         }
+         return -1;
+      }
+
+      int num_cells; // number of occupied cells
+
+   private:
+
+      // fibonacci hash of key to table slot
+      inline uint64_t hash(const int64_t key) const{
+         return (uint64_t(key) * 0x9E3779B97F4A7C15ULL) >> (64 - bits);
+      }
+
+      int bits; // log2 of table size
+      uint64_t mask; // table size - 1
+      std::vector<int64_t> keys; // linear supercell index of each slot (-1 if empty)
+      std::vector<int> ids; // cell id of each slot
+
+   };
+
+}
+
 //----------------------------------------------------------------------------------
 // @brief Generate atomic neighbourlist for a generalised exchange template
 //
-// Assigns atoms to unit cells and then calculates all interactions between cells
+// Assigns atoms to unit cells and then calculates all interactions of each atom
+// with atoms in neighbouring cells. Occupied cells are stored in a hash table
+// with a flat array of atom ids for each cell, and the neighbour list is
+// generated directly in compressed sparse row format in two threaded passes,
+// first counting the interactions of each atom and then filling the list.
 //
 // Partial cells can exist so ensure enough cells are generated
 //
@@ -48,7 +121,7 @@ namespace neighbours{
 //----------------------------------------------------------------------------------
 void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atoms (as reference for speed)
                unitcell::exchange_template_t& exchange, // exchange template to calculate neighbour list
-               const int num_atoms_in_unit_cell,        // number of atoms in each cell to estimate interaction numbers
+               const int num_atoms_in_unit_cell,        // number of atoms in each cell
                const double ucdx,                       // unit cell size
                const double ucdy,
                const double ucdz
@@ -57,18 +130,6 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
 	// put number of atoms into temporary variable
 	const int num_atoms = atom_array.size();
 
-	// Reserve space for num_atoms
-	list.reserve(num_atoms);
-
-	// estimate number of interactions per atom
-	const int64_t max_nn = int64_t( 1.1*( double(exchange.interaction.size()) / double(num_atoms_in_unit_cell) ) );
-
-	// Reserve space for each atom in neighbour list according to material type
-	for(int atom=0; atom < num_atoms; atom++){
-		list.push_back(std::vector<neighbour_t>());
-		list[atom].reserve(max_nn);
-	}
-
    // Calculate system dimensions and number of supercells
    const int64_t max_val=1000000000000;
    int64_t min[3] = {max_val,max_val,max_val}; // lowest cell id
@@ -111,69 +172,19 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
                           ( max_cell[1] - offset[1] + 1 ),
                           ( max_cell[2] - offset[2] + 1 )};
 
-	// Declare temporary array for 3D supercell array
-	std::vector<std::vector<std::vector<std::vector<int> > > > supercell_array;
-
-   // calculate total number of neighbours and inform user of memory needed
-   double num_neighbours = double(d[0]) * double(d[1]) * double(d[2]) * double(num_atoms_in_unit_cell);
-   #ifdef MPICF
-      // calculate total interactions for entire system
-      double total_neighbours = 0.0;
-      MPI_Allreduce(&total_neighbours, &num_neighbours, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      if(vmpi::master){
-         zlog << zTs() << "Memory required for neighbourlist calculation (each cpu):" <<
-         8.0*total_neighbours/(vmpi::num_processors * 1.0e6) << " MB" << std::endl;
-         zlog << zTs() << "Memory required for neighbourlist calculation (all cpus):" <<
-         8.0*total_neighbours/1.0e6 << " MB" << std::endl;
-      }
-   #else
-      zlog << zTs() << "Memory required for neighbourlist calculation:" <<
-      8.0*num_neighbours/1.0e6 << " MB" << std::endl;
-   #endif
-
    // Inform user that neighbour list calculation is beginning
-   zlog << zTs() << "Allocating memory for supercell array in neighbourlist calculation" << std::endl;
-
-   // Allocate supercell array to list all atoms
-	supercell_array.resize(d[0]);
-	for(unsigned int i=0; i < d[0] ; i++){
-		supercell_array[i].resize(d[1]);
-		for(unsigned int j=0; j<d[1] ; j++){
-			supercell_array[i][j].resize(d[2]);
-			for(unsigned int k=0; k<d[2] ; k++){
-				supercell_array[i][j][k].resize(num_atoms_in_unit_cell,-1);
-			}
-		}
-	}
-   zlog << zTs() << "\tAllocating memory done"<< std::endl;
-
-	// declare 1D cell array to loop over
-	const int64_t num_cells = d[0]*d[1]*d[2];
-	std::vector< std::vector <int> > cell_coord_array;
-	cell_coord_array.reserve(num_cells);
-	for(int64_t i=0; i < num_cells; i++){
-		cell_coord_array.push_back(std::vector<int>());
-		cell_coord_array[i].resize(3);
-	}
+   zlog << zTs() << "Populating supercell hash table for neighbourlist calculation..."<< std::endl;
 
-	// Initialise cell_array
-	uint64_t cell=0; // cell counter
-	for(unsigned int x=0;x<d[0];x++){
-		for(unsigned int y=0;y<d[1];y++){
-			for(unsigned int z=0;z<d[2];z++){
-				//save cell coordinates
-				cell_coord_array[cell][0]=x;
-				cell_coord_array[cell][1]=y;
-				cell_coord_array[cell][2]=z;
-				cell++;
-			}
-		}
-	}
+   //---------------------------------------------------------------------------
+   // Assign atoms to occupied cells
+   //---------------------------------------------------------------------------
+   cell_table_t cell_table;
+   cell_table.initialize(num_atoms);
 
-   // Inform user of time intensive process
-   zlog << zTs() << "Populating supercell array for neighbourlist calculation..."<< std::endl;
+   std::vector<int> atom_cell(num_atoms); // cell id of each atom
+   std::vector<int> cell_atoms; // atom ids in each cell for each unit cell site (-1 if empty)
+   cell_atoms.reserve(num_atoms);
 
-	// Populate supercell array with atom numbers
 	for(int atom=0; atom < num_atoms; atom++){
 
       // get supercell coordinates
@@ -181,201 +192,184 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
                        atom_array[atom].scy - offset[1],
                        atom_array[atom].scz - offset[2] };
 
-      // get atom real position coordinates
-		double c[3]={atom_array[atom].x, atom_array[atom].y, atom_array[atom].z};
-
-      // check that atom is within valid range of supercell coordinates
-		for(int i=0;i<3;i++){
-			// Always check cell in range
-         if( scc[i] >= d[i] ){
-            terminaltextcolor(RED);
-				std::cerr << "Error - atom out of supercell range in neighbourlist calculation!" << std::endl;
-            terminaltextcolor(WHITE);
-				#ifdef MPICF
-				terminaltextcolor(RED);
-				std::cerr << "\tCPU Rank: " << vmpi::my_rank << std::endl;
-				terminaltextcolor(WHITE);
-				#endif
-				terminaltextcolor(RED);
-				std::cerr << "\tAtom number:      " << atom << std::endl;
-				std::cerr << "\tAtom coordinates: " << c[0] << "\t" << c[1] << "\t" << c[2] << "\t" << std::endl;
-				std::cerr << "\tmin coordinates:  " << min[0] << "\t" << min[1] << "\t" << min[2] << "\t" << std::endl;
-				std::cerr << "\tmax coordinates:  " << max[0] << "\t" << max[1] << "\t" << max[2] << "\t" << std::endl;
-				std::cerr << "\tCell coordinates: " << scc[0] << "\t" << scc[1] << "\t" << scc[2] << "\t" << std::endl;
-				std::cerr << "\tCell maxima:      " << d[0] << "\t" << d[1] << "\t" << d[2] << std::endl;
-				std::cerr << "\tCell offset:      " << offset[0] << "\t" << offset[1] << "\t" << offset[2] << std::endl;
-				std::cerr << "\tCell offest (dp): " << offset[0]*ucdx << "\t" << offset[1]*ucdy << "\t" << offset[2]*ucdz << std::endl;
-				terminaltextcolor(WHITE);
-				err::vexit();
-			}
-		}
 		// Check for atoms greater than max_atoms_per_supercell
-		if(atom_array[atom].uc_id < num_atoms_in_unit_cell){
-			// Add atom to supercell
-			supercell_array[scc[0]][scc[1]][scc[2]][atom_array[atom].uc_id]=atom;
-		}
-		else{
+		if(atom_array[atom].uc_id >= uint64_t(num_atoms_in_unit_cell)){
 			terminaltextcolor(RED);
 			std::cerr << "Error, number of atoms per supercell exceeded" << std::endl;
 			std::cerr << "\tAtom number:      " << atom << std::endl;
-			std::cerr << "\tAtom coordinates: " << c[0] << "\t" << c[1] << "\t" << c[2] << "\t" << std::endl;
+			std::cerr << "\tAtom coordinates: " << atom_array[atom].x << "\t" << atom_array[atom].y << "\t" << atom_array[atom].z << "\t" << std::endl;
 			std::cerr << "\tCell coordinates: " << scc[0] << "\t" << scc[1] << "\t" << scc[2] << "\t" << std::endl;
 			std::cerr << "\tCell maxima:      " << d[0] << "\t" << d[1] << "\t" << d[2] << std::endl;
 			std::cerr << "\tCell offset:      " << offset[0] << "\t" << offset[1] << "\t" << offset[2] << std::endl;
-			std::cerr << "\tAtoms in Current Cell:" << std::endl;
-			for(unsigned int ix=0;ix<supercell_array[scc[0]][scc[1]][scc[2]].size();ix++){
-				const int ixatom=supercell_array[scc[0]][scc[1]][scc[2]][ix];
-				std::cerr << "\t\t [id x y z] "<< ix << "\t" << ixatom << "\t" << atom_array[ixatom].x << "\t" << atom_array[ixatom].y << "\t" << atom_array[ixatom].z << std::endl;
-			}
+			std::cerr << "\tUnit cell id:     " << atom_array[atom].uc_id << std::endl;
 			terminaltextcolor(WHITE);
 			err::vexit();
 		}
+
+      // find or add cell
+      const int cell = cell_table.insert( (scc[0]*d[1] + scc[1])*d[2] + scc[2] );
+      if(uint64_t(cell) == cell_atoms.size()/num_atoms_in_unit_cell) cell_atoms.resize(cell_atoms.size() + num_atoms_in_unit_cell, -1);
+
+      // Add atom to supercell
+      atom_cell[atom] = cell;
+      cell_atoms[int64_t(cell)*num_atoms_in_unit_cell + atom_array[atom].uc_id] = atom;
+
 	}
 
    // Inform user of progress
-   zlog << zTs() << "\tPopulating supercell array completed"<< std::endl;
-
-   // calculate total number of neighbours and inform user of memory needed
-   num_neighbours = double(num_cells)*double(exchange.interaction.size());
-   #ifdef MPICF
-      // calculate total interactions for entire system
-      total_neighbours = 0.0;
-      MPI_Allreduce(&total_neighbours, &num_neighbours, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      if(vmpi::master){
-         zlog << zTs() << "Memory required for neighbour list (each cpu):" <<
-         8.0*total_neighbours/(vmpi::num_processors * 1.0e6) << " MB" << std::endl;
-         zlog << zTs() << "Memory required for neighbour list (all cpus):" <<
-         8.0*total_neighbours/1.0e6 << " MB" << std::endl;
+   zlog << zTs() << "\tPopulating supercell hash table completed for " << cell_table.num_cells << " occupied cells"<< std::endl;
+
+   //---------------------------------------------------------------------------
+   // Sort template interactions by unit cell site of atom i, preserving order
+   //---------------------------------------------------------------------------
+   const int num_interactions = exchange.interaction.size();
+   std::vector<int> site_start(num_atoms_in_unit_cell + 1, 0); // first interaction for each site
+   std::vector<int> site_interactions(num_interactions); // interaction ids sorted by site
+   for(int i = 0; i < num_interactions; i++){
+      const int site = exchange.interaction[i].i;
+      if(site >= 0 && site < num_atoms_in_unit_cell) site_start[site+1]++;
+   }
+   for(int site = 0; site < num_atoms_in_unit_cell; site++) site_start[site+1] += site_start[site];
+   {
+      std::vector<int> counter(site_start.begin(), site_start.end() - 1);
+      for(int i = 0; i < num_interactions; i++){
+         const int site = exchange.interaction[i].i;
+         if(site >= 0 && site < num_atoms_in_unit_cell) site_interactions[counter[site]++] = i;
       }
-   #else
-      zlog << zTs() << "Memory required for neighbour list:" <<
-      8.0*num_neighbours/1.0e6 << " MB" << std::endl;
-   #endif
+   }
 
 	// Generate neighbour list and inform user
 	std::cout <<"Generating neighbour list"<< std::flush;
    zlog << zTs() << "Generating neighbour list..."<< std::endl;
 
-   // temporary neighour to simplify memory management
-	neighbour_t tmp_nt;
+   start_index.assign(num_atoms + 1, 0);
+
+   // save size of periodic images for calculation of separation vectors
+   image_size[0] = d[0]*ucdx;
+   image_size[1] = d[1]*ucdy;
+   image_size[2] = d[2]*ucdz;
+
+   //---------------------------------------------------------------------------
+   // Count interactions for each atom (pass = 0) and then populate list (pass = 1)
+   //---------------------------------------------------------------------------
+   for(int pass = 0; pass < 2; pass++){
+
+      // structure is generated before sim::initialize sets the default number of threads
+      #pragma omp parallel for schedule(static) num_threads(sim::num_threads)
+      for(int atom = 0; atom < num_atoms; atom++){
+
+         const int site = atom_array[atom].uc_id;
+
+         // skip atoms replaced by later atoms on the same site
+         if(cell_atoms[int64_t(atom_cell[atom])*num_atoms_in_unit_cell + site] != atom) continue;
+
+         // get supercell coordinates of atom
+         const int64_t scc[3]={ atom_array[atom].scx - offset[0],
+                                atom_array[atom].scy - offset[1],
+                                atom_array[atom].scz - offset[2] };
+
+         uint64_t index = start_index[atom]; // next interaction for atom (pass 1 only)
+         uint64_t count = 0; // number of interactions for atom
+
+         // Loop over all interactions of site in exchange template
+         for(int s = site_start[site]; s < site_start[site+1]; s++){
+
+            const int id = site_interactions[s];
+            const int natom = exchange.interaction[id].j;
+
+            int64_t nx = exchange.interaction[id].dx + scc[0];
+            int64_t ny = exchange.interaction[id].dy + scc[1];
+            int64_t nz = exchange.interaction[id].dz + scc[2];
+
+            // periodic image of neighbour
+            int ix = 0;
+            int iy = 0;
+            int iz = 0;
+
+            #ifdef MPICF
+              // Parallel periodic boundaries are handled explicitly during the
+              // halo region setup
+            #else
+            // Wrap around for periodic boundaries
+            // Consider virtual atom position for periodic image
+            if(cs::pbc[0]==true){
+               if(nx>=d[0]){
+                  nx=nx-d[0];
+                  ix=1;
+               }
+               else if(nx<0){
+                  nx=nx+d[0];
+                  ix=-1;
+               }
+            }
+            if(cs::pbc[1]==true){
+               if(ny>=d[1]){
+                  ny=ny-d[1];
+                  iy=1;
+               }
+               else if(ny<0){
+                  ny=ny+d[1];
+                  iy=-1;
+               }
+            }
+            if(cs::pbc[2]==true){
+               if(nz>=d[2]){
+                  nz=nz-d[2];
+                  iz=1;
+               }
+               else if(nz<0){
+                  nz=nz+d[2];
+                  iz=-1;
+               }
+            }
+            #endif
 
-   // copy number of interactions to temporary constant
-   const unsigned int num_interactions = exchange.interaction.size();
+            // check for out-of-bounds access
+            if( nx < 0 || nx >= d[0] || ny < 0 || ny >= d[1] || nz < 0 || nz >= d[2] ) continue;
 
-	// Loop over all cells
-	for(uint64_t cell = 0; cell < num_cells; cell++){
+            // check for missing cells and atoms
+            const int ncell = cell_table.find( (nx*d[1] + ny)*d[2] + nz );
+            if(ncell < 0) continue;
+            const int atomj = cell_atoms[int64_t(ncell)*num_atoms_in_unit_cell + natom];
+            if(atomj < 0) continue;
 
-      // Print out progress indicator to user
-		if( cell % ( num_cells / 10 + 1 ) == 0 ){
-			std::cout << "." << std::flush;
-		}
+            count++;
 
-      // get supercell coordinates of cell
-		int scc[3]={ cell_coord_array[cell][0],
-                   cell_coord_array[cell][1],
-                   cell_coord_array[cell][2]};
-
-		// Loop over all interactions in exchange template
-		for(unsigned int i = 0; i < num_interactions; i++){
-
-			const int atom=exchange.interaction[i].i;
-			const int natom=exchange.interaction[i].j;
-
-			int nx = exchange.interaction[i].dx + scc[0];
-			int ny = exchange.interaction[i].dy + scc[1];
-			int nz = exchange.interaction[i].dz + scc[2];
-
-         // vector from i->j
-         double vx=0.0;
-         double vy=0.0;
-         double vz=0.0;
-
-         #ifdef MPICF
-           // Parallel periodic boundaries are handled explicitly during the
-           // halo region setup
-         #else
-         // Wrap around for periodic boundaries
-         // Consider virtual atom position for position vector
-         if(cs::pbc[0]==true){
-            if(nx>=int(d[0])){
-               nx=nx-d[0];
-               vx=vx+d[0]*ucdx;
-            }
-            else if(nx<0){
-               nx=nx+d[0];
-               vx=vx-d[0]*ucdx;
-            }
-         }
-         if(cs::pbc[1]==true){
-            if(ny>=int(d[1])){
-               ny=ny-d[1];
-               vy=vy+d[1]*ucdy;
-            }
-            else if(ny<0){
-               ny=ny+d[1];
-               vy=vy-d[1]*ucdy;
-            }
-         }
-         if(cs::pbc[2]==true){
-            if(nz>=int(d[2])){
-               nz=nz-d[2];
-               vz=vz+d[2]*ucdz;
-            }
-            else if(nz<0){
-               nz=nz+d[2];
-               vz=vz-d[2]*ucdz;
+            // save interaction in second pass
+            if(pass == 1){
+               nn[index] = atomj;                               // atom ID of neighbour
+               i[index] = id;                                   // interaction type
+               image[index] = (ix + 1) + 3 * (iy + 1) + 9 * (iz + 1); // periodic image of neighbour
+               index++;
             }
+
          }
-         #endif
-         // check for out-of-bounds access
-         if( (nx >= 0 && static_cast<int64_t>(nx) < d[0] ) &&
-             (ny >= 0 && static_cast<int64_t>(ny) < d[1] ) &&
-             (nz >= 0 && static_cast<int64_t>(nz) < d[2] ) ){
-            // check for missing atoms
-            if((supercell_array[scc[0]][scc[1]][scc[2]][atom]!=-1) && (supercell_array[nx][ny][nz][natom]!=-1)){
-
-               // need actual atom numbers...
-               int atomi = supercell_array[scc[0]][scc[1]][scc[2]][atom];
-               int atomj = supercell_array[nx][ny][nz][natom];
-
-               //std::cout << "int_id: " << i << "\tatom i: " << atomi << "\tatom j: " << atomj << "\tuc_i: " << atom << "\tuc_j: " << natom << std::endl;
-
-               // Load atom positions
-               double ix = atom_array[atomi].x; // Already in A
-               double iy = atom_array[atomi].y;
-               double iz = atom_array[atomi].z;
-               double jx = atom_array[atomj].x;
-               double jy = atom_array[atomj].y;
-               double jz = atom_array[atomj].z;
-
-               //std::cout << "\tpi:    " << ix << "\t" << iy << "\t" << iz << std::endl;
-               //std::cout << "\tpj:    " << jx << "\t" << jy << "\t" << jz << std::endl;
-               //std::cout << "\tv_uc:  " << vx << "\t" << vy << "\t" << vz << std::endl;
-
-               vx += jx-ix;
-               vy += jy-iy;
-               vz += jz-iz;
-
-               //std::cout << "\tv:     " << jx-ix << "\t" << jy-iy << "\t" << jz-iz << std::endl;
-               //std::cout << "\tv_eff: " << vx << "\t" << vy << "\t" << vz << std::endl;
-
-               // get current index
-               // int index = list[supercell_array[scc[0]][scc[1]][scc[2]][atom]].size(); // unused variable
-
-               // set neighbour data
-               tmp_nt.nn = supercell_array[nx][ny][nz][natom]; // atom ID of neighbour
-               tmp_nt.i = i;                                   // interaction type
-               tmp_nt.vx = vx;                                 // position vector i->j
-               tmp_nt.vy = vy;
-               tmp_nt.vz = vz;
-
-               // push back array of class
-               list[supercell_array[scc[0]][scc[1]][scc[2]][atom]].push_back(tmp_nt);
 
-            }
-			}
-		}
-	}
+         // save number of interactions in first pass
+         if(pass == 0) start_index[atom+1] = count;
+
+      }
+
+      // calculate start index for each atom and allocate memory for neighbour list
+      if(pass == 0){
+
+         for(int atom = 0; atom < num_atoms; atom++) start_index[atom+1] += start_index[atom];
+
+         const uint64_t num_neighbours = start_index[num_atoms];
+
+         // inform user of memory needed
+         zlog << zTs() << "Memory required for neighbour list on rank " << vmpi::my_rank << ": " <<
+                 double(num_neighbours) * (2.0 * sizeof(int) + sizeof(uint8_t)) / 1.0e6 << " MB" << std::endl;
+
+         nn.resize(num_neighbours);
+         i.resize(num_neighbours);
+         image.resize(num_neighbours);
+
+      }
+
+      std::cout << "." << std::flush;
+
+   }
 
    // Inform user neighbour list calculation is complete
 	if(vmpi::my_rank == 0){
@@ -383,22 +377,7 @@ void list_t::generate( std::vector<cs::catom_t>& atom_array,    // array of atom
 		std::cout << "done!" << std::endl;
 		terminaltextcolor(WHITE);
 	}
-   zlog << zTs() << "\tNeighbour list calculation complete"<< std::endl;
-
-	// Deallocate supercell array
-   zlog << zTs() << "Deallocating supercell array for neighbour list calculation" << std::endl;
-	for(unsigned int i=0; i<d[0] ; i++){
-		for(unsigned int j=0; j<d[1] ;j++){
-			for(unsigned int k=0; k<d[2] ;k++){
-				supercell_array[i][j][k].resize(0);
-				}
-				supercell_array[i][j].resize(0);
-			}
-			supercell_array[i].resize(0);
-		}
-	supercell_array.resize(0);
-
-   zlog << zTs() << "\tSupercell array deallocated" << std::endl;
+   zlog << zTs() << "\tNeighbour list calculation complete with " << start_index[num_atoms] << " interactions"<< std::endl;
 
 	return;
 }
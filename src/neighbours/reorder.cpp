@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------------
+//
+//   This file is part of the VAMPIRE open source package under the
+//   Free BSD licence (see licence file for details).
+//
+//   (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//------------------------------------------------------------------------------
+//
+
+// C++ standard library headers
+#include <vector>
+
+// Vampire headers
+#include "neighbours.hpp"
+#include "sim.hpp"
+
+namespace neighbours{
+
+//----------------------------------------------------------------------------------
+// Function to reorder atoms in neighbour list
+//
+// Atom a in the new list is atom old_atom_number[a] in the old list, and neighbour
+// ids are translated with new_atom_number[old id]. Only the first
+// num_atoms_with_interactions atoms keep their interactions (used to drop the
+// interactions of halo atoms in parallel). Interactions of each atom keep their
+// order so that exchange fields are summed identically.
+//----------------------------------------------------------------------------------
+void list_t::reorder(const std::vector<int>& old_atom_number,
+                     const std::vector<int>& new_atom_number,
+                     const uint64_t num_atoms_with_interactions){
+
+   const uint64_t new_num_atoms = old_atom_number.size();
+
+   // calculate start index of each atom in new list
+   std::vector<uint64_t> new_start_index(new_num_atoms + 1, 0);
+   for(uint64_t atom = 0; atom < new_num_atoms; atom++){
+      const uint64_t count = atom < num_atoms_with_interactions ? num_neighbours(old_atom_number[atom]) : 0;
+      new_start_index[atom+1] = new_start_index[atom] + count;
+   }
+
+   const uint64_t num_interactions = new_start_index[new_num_atoms];
+
+   std::vector<int> new_nn(num_interactions);
+   std::vector<int> new_i(num_interactions);
+   std::vector<uint8_t> new_image(num_interactions);
+
+   // copy interactions to new order
+   // called before sim::initialize sets the default number of threads
+   #pragma omp parallel for schedule(static) num_threads(sim::num_threads)
+   for(int64_t atom = 0; atom < int64_t(num_atoms_with_interactions); atom++){
+      uint64_t index = new_start_index[atom];
+      const int old_atom = old_atom_number[atom];
+      for(uint64_t n = start_index[old_atom]; n < start_index[old_atom+1]; n++){
+         new_nn[index] = new_atom_number[nn[n]];
+         new_i[index]  = i[n];
+         // actual neighbours stay the same so simply copy periodic image
+         new_image[index] = image[n];
+         index++;
+      }
+   }
+
+   start_index.swap(new_start_index);
+   nn.swap(new_nn);
+   i.swap(new_i);
+   image.swap(new_image);
+
+   return;
+
+}
+
+} // end of namespace neighbours
@@ -48,11 +48,13 @@
 // Vampire Header files
 #include "atoms.hpp"
 #include "errors.hpp"
+#include "LLG.hpp"
 #include "program.hpp"
 #include "sim.hpp"
 #include "stats.hpp"
 #include "vio.hpp"
 #include "vmpi.hpp"
+#include "vutil.hpp"
 
 namespace program{
 
@@ -60,9 +62,19 @@ int bmark(){
 	// check calling of routine if error checking is activated
 	if(err::check==true){std::cout << "program::bmark has been called" << std::endl;}
 
+	// instantiate timer for integration
+	vutil::vtimer_t timer;
+	double integration_time = 0.0;
+
+	const uint64_t start_time = sim::time;
+
 	// Simulate system
 	while(sim::time<sim::total_time){
+
+		timer.start();
 		sim::integrate(sim::partial_time);
+		timer.stop();
+		integration_time += timer.elapsed_time();
 
 		// Calculate mag_m, mag after sim::partial_time steps
         stats::mag_m();
@@ -71,6 +83,42 @@ int bmark(){
 
 	} // end of time loop
 
+	//------------------------------------------------------------------------
+	// Output measured integration time per atom per step
+	//------------------------------------------------------------------------
+	#ifdef MPICF
+		const uint64_t total_atoms = vmpi::reduce_sum(uint64_t(vmpi::num_core_atoms+vmpi::num_bdry_atoms));
+		MPI_Allreduce(MPI_IN_PLACE, &integration_time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+	#else
+		const uint64_t total_atoms = atoms::num_atoms;
+	#endif
+	const uint64_t steps = sim::time - start_time;
+
+	if(steps > 0 && total_atoms > 0 && vmpi::my_rank == 0){
+
+		const double ns_per_atom_step = 1.0e9*integration_time/(double(total_atoms)*double(steps));
+
+		std::cout << "Integration time: " << integration_time << " s (" << ns_per_atom_step << " ns/atom/step)" << std::endl;
+		zlog << zTs() << "Integration time: " << integration_time << " s (" << ns_per_atom_step << " ns/atom/step)" << std::endl;
+
+		// Memory traffic of the Heun integrator and bandwidth achieved in the measured time
+		if(sim::integrator == 0){
+
+			const double bytes_per_step = double(LLG_arrays::heun_bytes_per_atom)*double(total_atoms);
+			const double reduction = 100.0*(1.0 - double(LLG_arrays::heun_bytes_per_atom)/double(LLG_arrays::unfused_heun_bytes_per_atom));
+			const double bandwidth = integration_time > 0.0 ? 1.0e-9*bytes_per_step*double(steps)/integration_time : 0.0;
+
+			std::cout << "Integrator memory traffic: " << bytes_per_step << " bytes/step (" << LLG_arrays::heun_bytes_per_atom << " bytes/atom/step, "
+			          << reduction << "% less than unfused Heun)" << std::endl;
+			std::cout << "Integrator memory bandwidth: " << bandwidth << " GB/s" << std::endl;
+			zlog << zTs() << "Integrator memory traffic: " << bytes_per_step << " bytes/step (" << LLG_arrays::heun_bytes_per_atom << " bytes/atom/step, "
+			     << reduction << "% less than unfused Heun)" << std::endl;
+			zlog << zTs() << "Integrator memory bandwidth: " << bandwidth << " GB/s" << std::endl;
+
+		}
+
+	}
+
 	return EXIT_SUCCESS;
 }
 
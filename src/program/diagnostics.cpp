@@ -43,6 +43,7 @@
 ///
 
 // Standard Libraries
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -53,10 +54,12 @@
 #include "errors.hpp"
 #include "material.hpp"
 #include "program.hpp"
+#include "random.hpp"
 #include "sim.hpp"
 #include "stats.hpp"
 #include "vio.hpp"
 #include "vmath.hpp"
+#include "vutil.hpp"
 
 
 namespace program{
@@ -162,4 +165,69 @@ namespace program{
 
    }
 
+   //---------------------------------------------------------------------------
+   // Microbenchmark of gaussian random number generation for thermal fields.
+   // Three arrays of length num_atoms are filled sim:total-time-steps times
+   // with each generator, and the time per random number is reported.
+   //---------------------------------------------------------------------------
+   void gaussian_benchmark(){
+
+      // check calling of routine if error checking is activated
+      if(err::check==true) std::cout << "program::gaussian_benchmark has been called" << std::endl;
+
+      const int num_atoms = atoms::num_atoms;
+      const uint64_t repeats = sim::total_time;
+      const double num_numbers = 3.0*double(num_atoms)*double(repeats);
+
+      std::vector<double> x(num_atoms);
+      std::vector<double> y(num_atoms);
+      std::vector<double> z(num_atoms);
+
+      vutil::vtimer_t timer;
+
+      // single numbers from gaussian()
+      mtrandom::grnd.seed(mtrandom::integration_seed);
+      timer.start();
+      for(uint64_t r = 0; r < repeats; r++){
+         std::generate(x.begin(), x.end(), mtrandom::gaussian);
+         std::generate(y.begin(), y.end(), mtrandom::gaussian);
+         std::generate(z.begin(), z.end(), mtrandom::gaussian);
+      }
+      timer.stop();
+      const double single_time = timer.elapsed_time();
+      const std::vector<double> last_x = x;
+
+      // blocks of numbers from gaussian_fill()
+      mtrandom::grnd.seed(mtrandom::integration_seed);
+      timer.start();
+      for(uint64_t r = 0; r < repeats; r++){
+         mtrandom::gaussian_fill(x, 0, num_atoms);
+         mtrandom::gaussian_fill(y, 0, num_atoms);
+         mtrandom::gaussian_fill(z, 0, num_atoms);
+      }
+      timer.stop();
+      const double block_time = timer.elapsed_time();
+      const bool identical = (x == last_x);
+
+      // counter based generator
+      timer.start();
+      for(uint64_t r = 0; r < repeats; r++){
+         mtrandom::philox_gaussian(atoms::global_id_array, r, mtrandom::integration_seed, 0, 0, num_atoms, x, y, z);
+      }
+      timer.stop();
+      const double philox_time = timer.elapsed_time();
+
+      std::cout << "Gaussian random number generation [ns per number]:" << std::endl;
+      std::cout << "   gaussian()        " << 1.0e9*single_time/num_numbers << std::endl;
+      std::cout << "   gaussian_fill()   " << 1.0e9*block_time/num_numbers << " (identical numbers: " << identical << ")" << std::endl;
+      std::cout << "   philox_gaussian() " << 1.0e9*philox_time/num_numbers << std::endl;
+      zlog << zTs() << "Gaussian random number generation [ns per number]:" << std::endl;
+      zlog << zTs() << "   gaussian()        " << 1.0e9*single_time/num_numbers << std::endl;
+      zlog << zTs() << "   gaussian_fill()   " << 1.0e9*block_time/num_numbers << " (identical numbers: " << identical << ")" << std::endl;
+      zlog << zTs() << "   philox_gaussian() " << 1.0e9*philox_time/num_numbers << std::endl;
+
+      return;
+
+   }
+
 }//end of namespace program
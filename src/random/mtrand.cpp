@@ -47,6 +47,24 @@ void MTRand_int32::gen_state() { // generate new state vector
   p = 0; // reset position
 }
 
+void MTRand_int32::fill(uint32_t* array, int size) { // same numbers as rand_int32()
+  while (size > 0) {
+    if (p == n) gen_state(); // new state vector needed
+    const int count = (n - p < size) ? n - p : size;
+// tempering of a contiguous part of the state vector, which can be vectorised
+    for (int i = 0; i < count; ++i) {
+      uint32_t x = state[p + i];
+      x ^= (x >> 11);
+      x ^= (x << 7) & 0x9D2C5680UL;
+      x ^= (x << 15) & 0xEFC60000UL;
+      array[i] = x ^ (x >> 18);
+    }
+    p += count;
+    array += count;
+    size -= count;
+  }
+}
+
 void MTRand_int32::seed(uint32_t s) {  // init by 32 bit seed
   state[0] = s & 0xFFFFFFFFUL; // for > 32 bit machines
   for (int i = 1; i < n; ++i) {
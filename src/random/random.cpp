@@ -23,8 +23,15 @@
 // ----------------------------------------------------------------------------
 //
 #include "random.hpp"
+#include <algorithm>
 #include <cmath>
 
+// vector Ziggurat fast path is available for x86 processors with GNU compatible compilers
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+   #define VAMPIRE_X86_SIMD
+   #include <immintrin.h>
+#endif
+
 using std::log;
 using std::sqrt;
 
@@ -36,6 +43,7 @@ namespace mtrandom
 
 	int voronoi_seed=1951218893;
 	int integration_seed=2137082040;
+	bool philox_thermal_noise=false; // use counter based generator for thermal fields
 
 	double x1,x2,w;
 	double number1;
@@ -271,5 +279,287 @@ double gaussianc(MTRand& grnd){
   return  sign ? x : -x;
 }
 
+//------------------------------------------------------------------------------
+// Ziggurat fast path for n random integers, giving the sample for each integer
+// and whether it is accepted. Returns the number of rejected samples, which
+// must be completed with the full rejection loop.
+//------------------------------------------------------------------------------
+static int ziggurat_fast_path_scalar(const uint32_t* buffer, double* value, int* accept, const int n){
+
+  int rejected = 0;
+  for(int k = 0; k < n; k++){
+    const uint32_t U = buffer[k];
+    const int i = U & 0x0000007F;
+    const int j = U>>8; // 24 bits so signed conversion is exact
+    const double v = double(j)*wtab[i];
+    value[k] = (U & 0x00000080) ? v : -v;
+    accept[k] = j < int(ktab[i]);
+    rejected += 1 - accept[k];
+  }
+  return rejected;
+
+}
+
+#ifdef VAMPIRE_X86_SIMD
+/// Fast path for four samples at once using AVX2 gathers from the tables,
+/// giving exactly the same samples as the scalar version
+__attribute__((target("avx2")))
+static int ziggurat_fast_path_avx2(const uint32_t* buffer, double* value, int* accept, const int n){
+
+  const __m128i mask_i = _mm_set1_epi32(0x0000007F);
+  const __m128i mask_sign = _mm_set1_epi32(0x00000080);
+  const __m256d sign_bit = _mm256_set1_pd(-0.0);
+
+  int rejected = 0;
+  int k = 0;
+  for(; k + 4 <= n; k += 4){
+    const __m128i U = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&buffer[k]));
+    const __m128i i = _mm_and_si128(U, mask_i);
+    const __m128i j = _mm_srli_epi32(U, 8);
+    const __m256d v = _mm256_mul_pd(_mm256_cvtepi32_pd(j), _mm256_i32gather_pd(wtab, i, 8));
+    // negate samples with sign bit not set
+    const __m256i negative = _mm256_cvtepi32_epi64(_mm_cmpeq_epi32(_mm_and_si128(U, mask_sign), _mm_setzero_si128()));
+    _mm256_storeu_pd(&value[k], _mm256_xor_pd(v, _mm256_and_pd(_mm256_castsi256_pd(negative), sign_bit)));
+    // accept if j < ktab[i]
+    const __m256i kt = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(ktab), i, 8);
+    const int bits = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(kt, _mm256_cvtepi32_epi64(j))));
+    accept[k]   = bits & 1;
+    accept[k+1] = (bits >> 1) & 1;
+    accept[k+2] = (bits >> 2) & 1;
+    accept[k+3] = (bits >> 3) & 1;
+    rejected += 4 - __builtin_popcount(bits);
+  }
+  return rejected + ziggurat_fast_path_scalar(&buffer[k], &value[k], &accept[k], n - k);
+
+}
+#endif
+
+static int ziggurat_fast_path(const uint32_t* buffer, double* value, int* accept, const int n){
+
+  #ifdef VAMPIRE_X86_SIMD
+    static const bool avx2_supported = __builtin_cpu_supports("avx2");
+    if(avx2_supported) return ziggurat_fast_path_avx2(buffer, value, accept, n);
+  #endif
+  return ziggurat_fast_path_scalar(buffer, value, accept, n);
+
+}
+
+/// Ziggurat rejection loop for a sample which was not accepted in the fast
+/// path, taking further random numbers from the buffer until it is used up
+/// and then from the generator, in the same order as gaussian()
+static double gaussian_slow(uint32_t U, const uint32_t* buffer, int& k, const int n){
+
+  const double scale = 1.0/4294967296.0; // 2^-32
+
+  while (1) {
+    const unsigned long i = U & 0x0000007F;
+    const unsigned long sign = U & 0x00000080;
+    const unsigned long j = U>>8;
+
+    double x = j*wtab[i];
+    if (j < ktab[i]) return sign ? x : -x;
+
+    double y;
+    if (i<127) {
+      const double u = static_cast<double>(k < n ? buffer[k++] : mtrandom::grnd.i32())*scale;
+      y = ytab[i+1]+(ytab[i]-ytab[i+1])*u;
+    } else {
+      const double u1 = static_cast<double>(k < n ? buffer[k++] : mtrandom::grnd.i32())*scale;
+      x = PARAM_R - log(1.0-u1)/PARAM_R;
+      const double u2 = static_cast<double>(k < n ? buffer[k++] : mtrandom::grnd.i32())*scale;
+      y = exp(-PARAM_R*(x-0.5*PARAM_R))*u2;
+    }
+    if (y < exp(-0.5*x*x)) return sign ? x : -x;
+
+    U = k < n ? buffer[k++] : mtrandom::grnd.i32();
+  }
+
+}
+
+//------------------------------------------------------------------------------
+// Function to fill array elements start-end with gaussian random numbers,
+// giving exactly the same numbers as calling gaussian() for each element.
+// Random integers are drawn from the generator in blocks, and the Ziggurat
+// fast path is evaluated for the whole block in a loop the compiler can
+// vectorise. Since every sample needs at least one random integer, a block is
+// never larger than the number of samples still needed, so that no random
+// numbers are drawn in advance of the sequential algorithm.
+//------------------------------------------------------------------------------
+void gaussian_fill(std::vector<double>& array, const int start, const int end){
+
+  const int block_size = 256;
+
+  uint32_t buffer[block_size];
+  double value[block_size];
+  int accept[block_size];
+
+  int index = start;
+
+  while(index < end){
+
+    const int n = end - index < block_size ? end - index : block_size;
+
+    // draw random integers
+    mtrandom::grnd.fill(buffer, n);
+
+    // Ziggurat fast path
+    const int rejected = ziggurat_fast_path(buffer, &array[index], accept, n);
+    if(rejected == 0){
+      index += n;
+      continue;
+    }
+
+    // otherwise continue the rejection loop from the first rejected sample,
+    // moving later accepted samples down to keep them in order
+    int k = 0;
+    while(accept[k]) k++;
+    index += k;
+    std::copy(&array[index], &array[index] + n - k, value);
+    const int offset = k;
+    while(k < n){
+      if(accept[k]){
+        array[index] = value[k-offset];
+        k++;
+      }
+      else{
+        const uint32_t U = buffer[k];
+        k++;
+        array[index] = gaussian_slow(U, buffer, k, n);
+      }
+      index++;
+    }
+  }
+
+}
+
+//------------------------------------------------------------------------------
+// Counter based random number generator (Philox4x32-10) from J. K. Salmon et
+// al, Proc. SC11, 16 (2011). Each set of random numbers is a pure function of
+// a key and a counter, so that the numbers for an atom depend only on the seed,
+// atom id and time step and not on how atoms are distributed between
+// processors or threads. No generator state needs to be saved in checkpoints.
+//------------------------------------------------------------------------------
+static inline void philox4x32(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint32_t k0, uint32_t k1){
+
+  for(int round = 0; round < 10; round++){
+    const uint64_t p0 = uint64_t(0xD2511F53)*uint64_t(c0);
+    const uint64_t p1 = uint64_t(0xCD9E8D57)*uint64_t(c2);
+    const uint32_t n0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+    const uint32_t n1 = uint32_t(p1);
+    const uint32_t n2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+    const uint32_t n3 = uint32_t(p0);
+    c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+    k0 += 0x9E3779B9; // key schedule (golden ratio and sqrt(3)-1)
+    k1 += 0xBB67AE85;
+  }
+
+}
+
+/// Ziggurat rejection loop for a counter based sample which was not accepted
+/// in the fast path. Further random numbers are taken from extra Philox
+/// streams (stream + 65536*n) so that the result is still a pure function of
+/// the counter.
+static double philox_gaussian_slow(uint32_t U, const uint64_t id, const uint64_t step, const uint32_t seed, const uint32_t stream, const int component){
+
+  const double scale = 1.0/4294967296.0; // 2^-32
+  uint32_t extra_stream = stream + 65536*(1+component);
+
+  while (1) {
+    const unsigned long i = U & 0x0000007F;
+    const unsigned long sign = U & 0x00000080;
+    const unsigned long j = U>>8;
+
+    double x = j*wtab[i];
+    if (j < ktab[i]) return sign ? x : -x;
+
+    // three further random numbers
+    uint32_t c0 = uint32_t(id), c1 = uint32_t(id >> 32), c2 = uint32_t(step), c3 = uint32_t(step >> 32);
+    philox4x32(c0, c1, c2, c3, seed, extra_stream);
+    extra_stream += 65536*3;
+
+    double y;
+    if (i<127) {
+      y = ytab[i+1]+(ytab[i]-ytab[i+1])*(c0*scale);
+    } else {
+      x = PARAM_R - log(1.0-c0*scale)/PARAM_R;
+      y = exp(-PARAM_R*(x-0.5*PARAM_R))*(c1*scale);
+    }
+    if (y < exp(-0.5*x*x)) return sign ? x : -x;
+
+    U = c2;
+  }
+
+}
+
+//------------------------------------------------------------------------------
+// Function to generate three gaussian random numbers for each atom in the
+// range start-end from the counter based generator. The counter is (atom id,
+// time step) and the key is (seed, stream), so that different uses of the
+// generator can select different streams (< 65536). Each Philox call gives
+// four 32 bit numbers, three of which are transformed with the Ziggurat
+// method. Integer generation and the Ziggurat fast path are done in separate
+// loops over blocks of atoms so that both can be vectorised.
+//------------------------------------------------------------------------------
+void philox_gaussian(const std::vector<uint64_t>& id, const uint64_t step, const uint32_t seed, const uint32_t stream,
+                     const int start, const int end, std::vector<double>& x, std::vector<double>& y, std::vector<double>& z){
+
+  const int block_size = 64;
+  const uint32_t step_lo = uint32_t(step);
+  const uint32_t step_hi = uint32_t(step >> 32);
+
+  uint32_t r[3][block_size];
+  int accept[block_size];
+  double* const g[3] = { &x[0], &y[0], &z[0] };
+
+  for(int block = start; block < end; block += block_size){
+
+    const int n = end - block < block_size ? end - block : block_size;
+
+    // generate random integers for each atom
+    for(int a = 0; a < n; a++){
+      uint32_t c0 = uint32_t(id[block+a]);
+      uint32_t c1 = uint32_t(id[block+a] >> 32);
+      uint32_t c2 = step_lo;
+      uint32_t c3 = step_hi;
+      philox4x32(c0, c1, c2, c3, seed, stream);
+      r[0][a] = c0; r[1][a] = c1; r[2][a] = c2;
+    }
+
+    // Ziggurat fast path, with rejected samples recalculated afterwards
+    for(int c = 0; c < 3; c++){
+      if(ziggurat_fast_path(r[c], &g[c][block], accept, n) > 0){
+        for(int a = 0; a < n; a++){
+          const uint32_t U = r[c][a];
+          if(!accept[a]) g[c][block+a] = philox_gaussian_slow(U, id[block+a], step, seed, stream, c);
+        }
+      }
+    }
+
+  }
+
+}
+
+//------------------------------------------------------------------------------
+// Function to generate three gaussian and one uniform random number (0,1) for
+// a single atom from the counter based generator, for algorithms such as
+// Monte Carlo where atoms are not processed in contiguous blocks
+//------------------------------------------------------------------------------
+void philox_numbers(const uint64_t id, const uint64_t step, const uint32_t seed, const uint32_t stream,
+                    double gaussian[3], double& uniform){
+
+  uint32_t r[4] = { uint32_t(id), uint32_t(id >> 32), uint32_t(step), uint32_t(step >> 32) };
+  philox4x32(r[0], r[1], r[2], r[3], seed, stream);
+
+  int accept[3];
+  if(ziggurat_fast_path_scalar(r, gaussian, accept, 3) > 0){
+    for(int c = 0; c < 3; c++){
+      if(!accept[c]) gaussian[c] = philox_gaussian_slow(r[c], id, step, seed, stream, c);
+    }
+  }
+
+  uniform = (double(r[3]) + 0.5)*(1.0/4294967296.0);
+
+}
+
 } // end of namespace random
 
@@ -184,12 +184,12 @@ int LLB_serial_heun(const int num_steps){
 	std::vector <double> Htz_para(atoms::x_spin_array.size());
 	
 	// precalculate thermal fields
-	generate (Htx_perp.begin(),Htx_perp.end(), mtrandom::gaussian);
-	generate (Hty_perp.begin(),Hty_perp.end(), mtrandom::gaussian);
-	generate (Htz_perp.begin(),Htz_perp.end(), mtrandom::gaussian);
-	generate (Htx_para.begin(),Htx_para.end(), mtrandom::gaussian);
-	generate (Hty_para.begin(),Hty_para.end(), mtrandom::gaussian);
-	generate (Htz_para.begin(),Htz_para.end(), mtrandom::gaussian);
+	mtrandom::gaussian_fill(Htx_perp, 0, Htx_perp.size());
+	mtrandom::gaussian_fill(Hty_perp, 0, Hty_perp.size());
+	mtrandom::gaussian_fill(Htz_perp, 0, Htz_perp.size());
+	mtrandom::gaussian_fill(Htx_para, 0, Htx_para.size());
+	mtrandom::gaussian_fill(Hty_para, 0, Hty_para.size());
+	mtrandom::gaussian_fill(Htz_para, 0, Htz_para.size());
 
 	for(unsigned int atom=0;atom<atoms::x_spin_array.size();atom++){
 		Htx_perp[atom] *= sigma_perp;
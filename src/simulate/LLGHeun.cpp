@@ -56,6 +56,7 @@
 #include "errors.hpp"
 #include "LLG.hpp"
 #include "material.hpp"
+#include "sim.hpp"
 
 //Function prototypes
 int calculate_spin_fields(const int,const int);
@@ -64,21 +65,21 @@ int calculate_external_fields(const int,const int);
 namespace LLG_arrays{
 
 	// Local arrays for LLG integration
-	std::vector <double> x_euler_array;
-	std::vector <double> y_euler_array;
-	std::vector <double> z_euler_array;
+	llg_array_t x_euler_array;
+	llg_array_t y_euler_array;
+	llg_array_t z_euler_array;
 
-	std::vector <double> x_heun_array;
-	std::vector <double> y_heun_array;
-	std::vector <double> z_heun_array;
+	llg_array_t x_heun_array;
+	llg_array_t y_heun_array;
+	llg_array_t z_heun_array;
 
-	std::vector <double> x_spin_storage_array;
-	std::vector <double> y_spin_storage_array;
-	std::vector <double> z_spin_storage_array;
+	llg_array_t x_spin_storage_array;
+	llg_array_t y_spin_storage_array;
+	llg_array_t z_spin_storage_array;
 
-	std::vector <double> x_initial_spin_array;
-	std::vector <double> y_initial_spin_array;
-	std::vector <double> z_initial_spin_array;
+	llg_array_t x_initial_spin_array;
+	llg_array_t y_initial_spin_array;
+	llg_array_t z_initial_spin_array;
 
 	bool LLG_set=false; ///< Flag to define state of LLG arrays (initialised/uninitialised)
 
@@ -113,21 +114,42 @@ int LLGinit(){
 
 	using namespace LLG_arrays;
 
-	x_spin_storage_array.resize(atoms::num_atoms,0.0);
-	y_spin_storage_array.resize(atoms::num_atoms,0.0);
-	z_spin_storage_array.resize(atoms::num_atoms,0.0);
+	const int num_atoms=atoms::num_atoms;
+
+	// Allocate arrays without initialisation
+	x_spin_storage_array.resize(num_atoms);
+	y_spin_storage_array.resize(num_atoms);
+	z_spin_storage_array.resize(num_atoms);
+
+	x_initial_spin_array.resize(num_atoms);
+	y_initial_spin_array.resize(num_atoms);
+	z_initial_spin_array.resize(num_atoms);
 
-	x_initial_spin_array.resize(atoms::num_atoms,0.0);
-	y_initial_spin_array.resize(atoms::num_atoms,0.0);
-	z_initial_spin_array.resize(atoms::num_atoms,0.0);
+	x_euler_array.resize(num_atoms);
+	y_euler_array.resize(num_atoms);
+	z_euler_array.resize(num_atoms);
 
-	x_euler_array.resize(atoms::num_atoms,0.0);
-	y_euler_array.resize(atoms::num_atoms,0.0);
-	z_euler_array.resize(atoms::num_atoms,0.0);
+	x_heun_array.resize(num_atoms);
+	y_heun_array.resize(num_atoms);
+	z_heun_array.resize(num_atoms);
 
-	x_heun_array.resize(atoms::num_atoms,0.0);
-	y_heun_array.resize(atoms::num_atoms,0.0);
-	z_heun_array.resize(atoms::num_atoms,0.0);
+	// Initialise arrays with the same static partition used for integration
+	// so that each page is first touched by the thread which works on it
+	#pragma omp parallel for schedule(static)
+	for(int atom=0;atom<num_atoms;atom++){
+		x_spin_storage_array[atom]=0.0;
+		y_spin_storage_array[atom]=0.0;
+		z_spin_storage_array[atom]=0.0;
+		x_initial_spin_array[atom]=0.0;
+		y_initial_spin_array[atom]=0.0;
+		z_initial_spin_array[atom]=0.0;
+		x_euler_array[atom]=0.0;
+		y_euler_array[atom]=0.0;
+		z_euler_array[atom]=0.0;
+		x_heun_array[atom]=0.0;
+		y_heun_array[atom]=0.0;
+		z_heun_array[atom]=0.0;
+	}
 
 	LLG_set=true;
 
@@ -169,24 +191,18 @@ int LLG_Heun(){
 
 	// Local variables for system integration
 	const int num_atoms=atoms::num_atoms;
-	double xyz[3];		// Local Delta Spin Components
-	double S_new[3];	// New Local Spin Moment
-	double mod_S;		// magnitude of spin moment
-
-	// Store initial spin positions
-	for(int atom=0;atom<num_atoms;atom++){
-		x_initial_spin_array[atom] = atoms::x_spin_array[atom];
-		y_initial_spin_array[atom] = atoms::y_spin_array[atom];
-		z_initial_spin_array[atom] = atoms::z_spin_array[atom];
-	}
 
 	// Calculate fields
 	calculate_spin_fields(0,num_atoms);
 	calculate_external_fields(0,num_atoms);
 
-	// Calculate Euler Step
+	// Calculate Euler (predictor) step, updating spins in place
+	#pragma omp parallel for schedule(static)
 	for(int atom=0;atom<num_atoms;atom++){
 
+		double xyz[3];		// Local Delta Spin Components
+		double S_new[3];	// New Local Spin Moment
+
 		const int imaterial=atoms::type_array[atom];
 		const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq; // material specific alpha and gamma
 		const double alpha_oneplusalpha_sq = mp::material[imaterial].alpha_oneplusalpha_sq;
@@ -202,10 +218,10 @@ int LLG_Heun(){
 		xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
 		xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
 
-		// Store dS in euler array
-		x_euler_array[atom]=xyz[0];
-		y_euler_array[atom]=xyz[1];
-		z_euler_array[atom]=xyz[2];
+		// Store partial Heun step S + dS dt/2 in euler array
+		x_euler_array[atom]=S[0]+xyz[0]*mp::half_dt;
+		y_euler_array[atom]=S[1]+xyz[1]*mp::half_dt;
+		z_euler_array[atom]=S[2]+xyz[2]*mp::half_dt;
 
 		// Calculate Euler Step
 		S_new[0]=S[0]+xyz[0]*mp::dt;
@@ -213,32 +229,25 @@ int LLG_Heun(){
 		S_new[2]=S[2]+xyz[2]*mp::dt;
 
 		// Normalise Spin Length
-		mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
-
-		S_new[0]=S_new[0]*mod_S;
-		S_new[1]=S_new[1]*mod_S;
-		S_new[2]=S_new[2]*mod_S;
+		const double mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
 
-		//Writing of Spin Values to Storage Array
-		x_spin_storage_array[atom]=S_new[0];
-		y_spin_storage_array[atom]=S_new[1];
-		z_spin_storage_array[atom]=S_new[2];
+		// Write predicted spins to spin array
+		atoms::x_spin_array[atom]=S_new[0]*mod_S;
+		atoms::y_spin_array[atom]=S_new[1]*mod_S;
+		atoms::z_spin_array[atom]=S_new[2]*mod_S;
  	}
 
-	// Copy new spins to spin array
-	for(int atom=0;atom<num_atoms;atom++){
-		atoms::x_spin_array[atom]=x_spin_storage_array[atom];
-		atoms::y_spin_array[atom]=y_spin_storage_array[atom];
-		atoms::z_spin_array[atom]=z_spin_storage_array[atom];
-	}
-
 	// Recalculate spin dependent fields
 	calculate_spin_fields(0,num_atoms);
 
-	// Calculate Heun Gradients
+	// Calculate Heun (corrector) step, updating spins in place
+	#pragma omp parallel for schedule(static)
 	for(int atom=0;atom<num_atoms;atom++){
 
-		const int imaterial=atoms::type_array[atom];;
+		double xyz[3];		// Local Delta Spin Components
+		double S_new[3];	// New Local Spin Moment
+
+		const int imaterial=atoms::type_array[atom];
 		const double one_oneplusalpha_sq = mp::material[imaterial].one_oneplusalpha_sq;
 		const double alpha_oneplusalpha_sq = mp::material[imaterial].alpha_oneplusalpha_sq;
 
@@ -253,29 +262,18 @@ int LLG_Heun(){
 		xyz[1]=(one_oneplusalpha_sq)*(S[2]*H[0]-S[0]*H[2]) + (alpha_oneplusalpha_sq)*(S[2]*(S[1]*H[2]-S[2]*H[1])-S[0]*(S[0]*H[1]-S[1]*H[0]));
 		xyz[2]=(one_oneplusalpha_sq)*(S[0]*H[1]-S[1]*H[0]) + (alpha_oneplusalpha_sq)*(S[0]*(S[2]*H[0]-S[0]*H[2])-S[1]*(S[1]*H[2]-S[2]*H[1]));
 
-		// Store dS in heun array
-		x_heun_array[atom]=xyz[0];
-		y_heun_array[atom]=xyz[1];
-		z_heun_array[atom]=xyz[2];
-	}
-
-	// Calculate Heun Step
-	for(int atom=0;atom<num_atoms;atom++){
-		S_new[0]=x_initial_spin_array[atom]+mp::half_dt*(x_euler_array[atom]+x_heun_array[atom]);
-		S_new[1]=y_initial_spin_array[atom]+mp::half_dt*(y_euler_array[atom]+y_heun_array[atom]);
-		S_new[2]=z_initial_spin_array[atom]+mp::half_dt*(z_euler_array[atom]+z_heun_array[atom]);
+		// Complete Heun step
+		S_new[0]=x_euler_array[atom]+xyz[0]*mp::half_dt;
+		S_new[1]=y_euler_array[atom]+xyz[1]*mp::half_dt;
+		S_new[2]=z_euler_array[atom]+xyz[2]*mp::half_dt;
 
 		// Normalise Spin Length
-		mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
-
-		S_new[0]=S_new[0]*mod_S;
-		S_new[1]=S_new[1]*mod_S;
-		S_new[2]=S_new[2]*mod_S;
+		const double mod_S = 1.0/sqrt(S_new[0]*S_new[0] + S_new[1]*S_new[1] + S_new[2]*S_new[2]);
 
 		// Copy new spins to spin array
-		atoms::x_spin_array[atom]=S_new[0];
-		atoms::y_spin_array[atom]=S_new[1];
-		atoms::z_spin_array[atom]=S_new[2];
+		atoms::x_spin_array[atom]=S_new[0]*mod_S;
+		atoms::y_spin_array[atom]=S_new[1]*mod_S;
+		atoms::z_spin_array[atom]=S_new[2]*mod_S;
 	}
 
 	return EXIT_SUCCESS;
@@ -23,11 +23,14 @@ namespace sim{
    int num_monte_carlo_preconditioning_steps(0);
 
    uint64_t time         = 0; // time step counter
+   uint64_t total_steps  = 0; // integration steps since start of simulation, not reset between program stages
    uint64_t total_time   = 10000; // total time steps (non-loop code)
    uint64_t loop_time    = 10000; // loop time steps (hysteresis/temperature loops)
    uint64_t partial_time = 1000; // same as time-step-increment
    uint64_t equilibration_time = 0; // equilibration time steps
 
+   int num_threads = 1; // number of shared memory threads per process
+
    namespace internal{
       //----------------------------------------------------------------------------
       // Shared variables used within sim module
@@ -121,6 +121,8 @@ double spin_applied_field_energy(const double Sx, const double Sy, const double
 ///=====================================================================================
 ///
 double spin_magnetostatic_energy(const int atom, const double Sx, const double Sy, const double Sz){
+   // with per move dipole updates only the cell fields are current
+   if(dipole::per_move_update) return dipole::spin_magnetostatic_energy(atom, Sx, Sy, Sz);
    //return -1.0*(dipole::atom_dipolar_field_array_x[atom]*Sx+dipole::atom_dipolar_field_array_y[atom]*Sy+dipole::atom_dipolar_field_array_z[atom]*Sz);
    return -1.0*(dipole::atom_mu0demag_field_array_x[atom]*Sx+dipole::atom_mu0demag_field_array_y[atom]*Sy+dipole::atom_mu0demag_field_array_z[atom]*Sz);
 }
@@ -173,4 +175,33 @@ double calculate_spin_energy(const int atom){
 	return energy; // Tesla
 }
 
+//------------------------------------------------------------------------------
+// Function to calculate the change in energy of a single spin moved from old to
+// new direction without changing the spin arrays. Terms linear in the spin
+// are evaluated once from the difference in spin direction, and the exchange
+// field is calculated in a single pass over the neighbours.
+//------------------------------------------------------------------------------
+double calculate_spin_energy_difference(const int atom, const double old_spin[3], const double new_spin[3]){
+
+	const int imaterial=atoms::type_array[atom];
+
+	const double dSx = new_spin[0] - old_spin[0];
+	const double dSy = new_spin[1] - old_spin[1];
+	const double dSz = new_spin[2] - old_spin[2];
+
+	// exchange
+	double energy = exchange::single_spin_energy_difference(atom, old_spin, new_spin);
+	if(exchange::biquadratic) energy += exchange::single_spin_biquadratic_energy_difference(atom, old_spin, new_spin);
+
+	// anisotropy
+	energy += anisotropy::single_spin_energy_difference(atom, imaterial, old_spin, new_spin, sim::temperature);
+
+	// applied and magnetostatic fields
+	energy += spin_applied_field_energy(dSx, dSy, dSz);
+	energy += spin_magnetostatic_energy(atom, dSx, dSy, dSz);
+
+	return energy; // Tesla
+
+}
+
 } // end of namespace sim
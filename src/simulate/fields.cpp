@@ -43,6 +43,7 @@
 #include "spintorque.hpp"
 #include "stats.hpp"
 #include "vmpi.hpp"
+#include "vutil.hpp"
 
 // sim module header
 #include "internal.hpp"
@@ -63,6 +64,8 @@ void calculate_hamr_fields(const int,const int);
 void calculate_fmr_fields(const int,const int);
 void calculate_lagrange_fields(const int,const int);
 void calculate_full_spin_fields(const int start_index,const int end_index);
+void calculate_thread_spin_fields(const int start_index,const int end_index);
+void calculate_thread_external_fields(const int start_index,const int end_index);
 
 int calculate_spin_fields(const int start_index,const int end_index){
 
@@ -70,11 +73,29 @@ int calculate_spin_fields(const int start_index,const int end_index){
 	/// 		Subroutine to calculate spin dependent fields
 	///
 	///			Version 1.0 R Evans 20/10/2008
+	///			Version 1.1 threaded calculation 2026
 	///======================================================
 
 	// check calling of routine if error checking is activated
 	if(err::check==true){std::cout << "calculate_spin_fields has been called" << std::endl;}
 
+	// Each thread calculates the fields for a fixed block of atoms
+	#pragma omp parallel
+	{
+		int thread_start_index, thread_end_index;
+		vutil::thread_partition(start_index, end_index, thread_start_index, thread_end_index);
+		calculate_thread_spin_fields(thread_start_index, thread_end_index);
+	}
+
+	return 0;
+
+}
+
+//------------------------------------------------------------------------------
+// Function to calculate spin dependent fields for a single thread
+//------------------------------------------------------------------------------
+void calculate_thread_spin_fields(const int start_index,const int end_index){
+
 	// Initialise Total Spin Fields to zero
 	fill (atoms::x_total_spin_field_array.begin()+start_index,atoms::x_total_spin_field_array.begin()+end_index,0.0);
 	fill (atoms::y_total_spin_field_array.begin()+start_index,atoms::y_total_spin_field_array.begin()+end_index,0.0);
@@ -113,7 +134,7 @@ int calculate_spin_fields(const int start_index,const int end_index){
 	// Add spin torque fields
 	if(sim::internal::enable_spin_torque_fields == true) calculate_full_spin_fields(start_index,end_index);
 
-	return 0;
+	return;
 
 }
 
@@ -130,10 +151,48 @@ int calculate_external_fields(const int start_index,const int end_index){
 	//----------------------------------------------------------
 	if(err::check==true){std::cout << "calculate_external_fields has been called" << std::endl;}
 
-	// Initialise Total External Fields to zero
-	fill (atoms::x_total_external_field_array.begin()+start_index,atoms::x_total_external_field_array.begin()+end_index,0.0);
-	fill (atoms::y_total_external_field_array.begin()+start_index,atoms::y_total_external_field_array.begin()+end_index,0.0);
-	fill (atoms::z_total_external_field_array.begin()+start_index,atoms::z_total_external_field_array.begin()+end_index,0.0);
+	// Thermal fields are drawn serially from the global random number generator
+	// so that the noise sequence is independent of the number of threads. The
+	// counter based generator is instead evaluated by each thread below.
+	const bool thermal_fields = (sim::program == 7) || (sim::program != 13 && sim::hamiltonian_simulation_flags[3] == 1);
+
+	if(thermal_fields && !mtrandom::philox_thermal_noise){
+		mtrandom::gaussian_fill(atoms::x_total_external_field_array, start_index, end_index);
+		mtrandom::gaussian_fill(atoms::y_total_external_field_array, start_index, end_index);
+		mtrandom::gaussian_fill(atoms::z_total_external_field_array, start_index, end_index);
+	}
+
+	// Each thread calculates the fields for a fixed block of atoms
+	#pragma omp parallel
+	{
+		int thread_start_index, thread_end_index;
+		vutil::thread_partition(start_index, end_index, thread_start_index, thread_end_index);
+
+		// Generate thermal noise from atom id and step, independent of decomposition.
+		// sim::time is reset between program stages, so the total step count is used.
+		if(thermal_fields && mtrandom::philox_thermal_noise){
+			mtrandom::philox_gaussian(atoms::global_id_array, sim::total_steps, mtrandom::integration_seed, 0, thread_start_index, thread_end_index,
+			                          atoms::x_total_external_field_array, atoms::y_total_external_field_array, atoms::z_total_external_field_array);
+		}
+
+		// Initialise Total External Fields to zero
+		if(!thermal_fields){
+			fill (atoms::x_total_external_field_array.begin()+thread_start_index,atoms::x_total_external_field_array.begin()+thread_end_index,0.0);
+			fill (atoms::y_total_external_field_array.begin()+thread_start_index,atoms::y_total_external_field_array.begin()+thread_end_index,0.0);
+			fill (atoms::z_total_external_field_array.begin()+thread_start_index,atoms::z_total_external_field_array.begin()+thread_end_index,0.0);
+		}
+
+		calculate_thread_external_fields(thread_start_index, thread_end_index);
+	}
+
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+// Function to calculate external fields for a single thread. Thermal field
+// arrays must already contain gaussian random numbers on entry.
+//------------------------------------------------------------------------------
+void calculate_thread_external_fields(const int start_index,const int end_index){
 
 	if(sim::program==7) calculate_hamr_fields(start_index,end_index);
    else if(sim::program==13){
@@ -165,7 +224,7 @@ int calculate_external_fields(const int start_index,const int end_index){
 	// Dipolar Fields
 	calculate_dipolar_fields(start_index,end_index);
 
-	return 0;
+	return;
 }
 
 int calculate_applied_fields(const int start_index,const int end_index){
@@ -271,9 +330,7 @@ int calculate_thermal_fields(const int start_index,const int end_index){
       sigma_prefactor.push_back(sqrt_T*mp::material[mat].H_th_sigma);
    }
 
-   generate (atoms::x_total_external_field_array.begin()+start_index,atoms::x_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-   generate (atoms::y_total_external_field_array.begin()+start_index,atoms::y_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-   generate (atoms::z_total_external_field_array.begin()+start_index,atoms::z_total_external_field_array.begin()+end_index, mtrandom::gaussian);
+   // scale gaussian random numbers (generated in calculate_external_fields) by thermal prefactor
 
    for(int atom=start_index;atom<end_index;atom++){
 
@@ -339,11 +396,7 @@ void calculate_hamr_fields(const int start_index,const int end_index){
 	const double Hvecy=sim::H_vec[1];
 	const double Hvecz=sim::H_vec[2];
 
-	// Add localised thermal field
-	generate (atoms::x_total_external_field_array.begin()+start_index,atoms::x_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-	generate (atoms::y_total_external_field_array.begin()+start_index,atoms::y_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-	generate (atoms::z_total_external_field_array.begin()+start_index,atoms::z_total_external_field_array.begin()+end_index, mtrandom::gaussian);
-
+	// Localised thermal field (gaussian random numbers generated in calculate_external_fields)
 	if(sim::head_laser_on){
 		for(int atom=start_index;atom<end_index;atom++){
 			const int imaterial=atoms::type_array[atom];
@@ -403,6 +456,7 @@ void calculate_fmr_fields(const int start_index,const int end_index){
 	const double Hz = Hfmrz * Hsinwt;
 
 	// Save fmr field strength for possible output
+	#pragma omp master
 	sim::fmr_field = Hsinwt;
 
 	if(sim::local_fmr_field==true){
@@ -12,6 +12,8 @@
 
 // Vampire headers
 #include "sim.hpp"
+#include "vio.hpp"
+#include "vutil.hpp"
 #include "internal.hpp"
 
 namespace sim{
@@ -38,6 +40,16 @@ namespace sim{
          if(sim::internal::mp[m].sot_pj.is_set()) sim::internal::sot_pj[m] = sim::internal::mp[m].sot_pj.get();
       }
 
+      // set number of threads used for shared memory parallel loops
+      #ifdef _OPENMP
+         omp_set_num_threads(sim::num_threads);
+         zlog << zTs() << "Using " << sim::num_threads << " OpenMP thread(s) per process for integration" << std::endl;
+      #else
+         if(sim::num_threads > 1){
+            zlog << zTs() << "Warning: sim:num-threads = " << sim::num_threads << " ignored as code was compiled without OpenMP support" << std::endl;
+         }
+      #endif
+
       return;
    }
 
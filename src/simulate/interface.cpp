@@ -12,6 +12,7 @@
 
 // Vampire headers
 #include "errors.hpp"
+#include "random.hpp"
 #include "sim.hpp"
 #include "vio.hpp"
 
@@ -107,6 +108,37 @@ namespace sim{
          return true;
       }
       //--------------------------------------------------------------------
+      test="num-threads";
+      if(word==test){
+         int nt = atoi(value.c_str());
+         vin::check_for_valid_int(nt, word, line, prefix, 1, 1024,"input","1 - 1024");
+         sim::num_threads = nt;
+         return true;
+      }
+      //--------------------------------------------------------------------
+      test="thermal-noise-generator";
+      if(word==test){
+         test="mersenne-twister";
+         if(value==test){
+            mtrandom::philox_thermal_noise = false;
+            return true;
+         }
+         test="philox";
+         if(value==test){
+            mtrandom::philox_thermal_noise = true;
+            return true;
+         }
+         terminaltextcolor(RED);
+         std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
+         std::cerr << "\t\"mersenne-twister\"" << std::endl;
+         std::cerr << "\t\"philox\"" << std::endl;
+         terminaltextcolor(WHITE);
+         zlog << zTs() << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
+         zlog << zTs() << "\t\"mersenne-twister\"" << std::endl;
+         zlog << zTs() << "\t\"philox\"" << std::endl;
+         err::vexit();
+      }
+      //--------------------------------------------------------------------
       // input parameter not found here
       return false;
    }
@@ -48,6 +48,7 @@
 #include "atoms.hpp"
 #include "program.hpp"
 #include "cells.hpp"
+#include "config.hpp"
 #include "dipole.hpp"
 #include "errors.hpp"
 #include "gpu.hpp"
@@ -146,7 +147,7 @@ namespace sim{
 
 	int system_simulation_flags;
 	int hamiltonian_simulation_flags[10];
-	int integrator=0; /// 0 = LLG Heun; 1= MC; 2 = LLG Midpoint; 3 = CMC
+	int integrator=0; /// 0 = LLG Heun; 1= MC; 2 = LLG Midpoint; 3 = CMC; 4 = hybrid CMC; 5 = coloured MC
 	int program=0;
 
 
@@ -161,6 +162,8 @@ namespace sim{
    bool save_checkpoint_flag=false; // Save checkpoint
    bool save_checkpoint_continuous_flag=false; // save checkpoints during simulations
    int save_checkpoint_rate=1; // Default increment between checkpoints
+   bool checkpoint_shared_file=false; // save and load single checkpoint file shared by all processes
+   bool asynchronous_checkpoint=false; // write checkpoints to disk in the background
 
    // Local function declarations
    void integrate_serial(uint64_t);
@@ -194,6 +197,7 @@ namespace sim{
       sim::checkpoint_loaded_flag=false;
 
 		sim::time++;
+		sim::total_steps++;
 		sim::head_position[0]+=sim::head_speed*mp::dt_SI*1.0e10;
 
       // Update dipole fields
@@ -471,6 +475,14 @@ int run(){
 			program::boltzmann_dist();
 			break;
 
+		case 52:
+			if(vmpi::my_rank==0){
+				std::cout << "Diagnostic-Gaussian-Benchmark..." << std::endl;
+				zlog << "Diagnostic-Gaussian-Benchmark..." << std::endl;
+			}
+			program::gaussian_benchmark();
+			break;
+
 	    case 51:
 		  	if(vmpi::my_rank==0){
 		       std::cout << "Setting..." << std::endl;
@@ -492,7 +504,7 @@ int run(){
    //------------------------------------------------
    // Output Monte Carlo statistics if applicable
    //------------------------------------------------
-   if(sim::integrator==1){
+   if(sim::integrator==1 || sim::integrator==5){
       std::cout << "Monte Carlo statistics:" << std::endl;
       std::cout << "\tTotal moves: " << long(sim::mc_statistics_moves) << std::endl;
       std::cout << "\t" << ((sim::mc_statistics_moves - sim::mc_statistics_reject)/sim::mc_statistics_moves)*100.0 << "% Accepted" << std::endl;
@@ -520,9 +532,18 @@ int run(){
    // De-initialize GPU
    if(gpu::acceleration) gpu::finalize();
 
+   // Complete outstanding dipole communication
+   if(dipole::activated) dipole::finalize();
+
+   // Complete outstanding configuration output
+   config::finalize();
+
    // optionally save checkpoint file
    if(sim::save_checkpoint_flag && !sim::save_checkpoint_continuous_flag) save_checkpoint();
 
+   // Complete outstanding checkpoint output
+   if(sim::save_checkpoint_flag) finalize_checkpoint();
+
 	return EXIT_SUCCESS;
 }
 
@@ -554,6 +575,10 @@ int integrate(uint64_t n_steps){
 	// Check for calling of function
 	if(err::check==true) std::cout << "sim::integrate has been called" << std::endl;
 
+	// Spins may have been changed since last call, and so cell magnetisation
+	// is recalculated before being tracked by Monte Carlo integrators
+	cells::stop_tracking_spin_changes();
+
 	// Call serial or parallell depending at compile time
 	#ifdef MPICF
 		sim::integrate_mpi(n_steps);
@@ -637,6 +662,14 @@ void integrate_serial(uint64_t n_steps){
 			}
 			break;
 
+		case 5: // Graph coloured Monte Carlo
+			for(uint64_t ti=0;ti<n_steps;ti++){
+				montecarlo::mc_step_coloured();
+				// increment time
+				increment_time();
+			}
+			break;
+
 		default:{
 			std::cerr << "Unknown integrator type "<< sim::integrator << " requested, exiting" << std::endl;
          err::vexit();
@@ -734,6 +767,21 @@ int integrate_mpi(uint64_t n_steps){
 			}
 			break;
 
+		case 5: // Graph coloured Monte Carlo
+			for(uint64_t ti=0;ti<n_steps;ti++){
+				#ifdef MPICF
+               if(montecarlo::mc_parallel_initialized == false) {
+                  montecarlo::mc_parallel_init(atoms::x_coord_array, atoms::y_coord_array, atoms::z_coord_array,
+                                               vmpi::min_dimensions, vmpi::max_dimensions);
+               }
+               montecarlo::mc_step_coloured();
+            #endif
+
+				// increment time
+				increment_time();
+			}
+			break;
+
 		default:{
 			terminaltextcolor(RED);
 			std::cerr << "Unknown integrator type "<< sim::integrator << " requested, exiting" << std::endl;
@@ -228,6 +228,17 @@ void energy_statistic_t::calculate(const std::vector<double>& sx,  // spin unit
       MPI_Allreduce(MPI_IN_PLACE,         &total_energy[0], mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
    #endif
 
+   accumulate_mean_energy();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to add reduced energies to mean energies
+//------------------------------------------------------------------------------------------------------
+void energy_statistic_t::accumulate_mean_energy(){
+
    //---------------------------------------------------------------------------
    // Add energies to mean energies
    //---------------------------------------------------------------------------
@@ -153,6 +153,17 @@ void magnetization_statistic_t::calculate_magnetization(const std::vector<double
       MPI_Allreduce(MPI_IN_PLACE, &magnetization[0], 4*mask_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
    #endif
 
+   normalize_magnetization();
+
+   return;
+
+}
+
+//------------------------------------------------------------------------------------------------------
+// Function to normalize reduced magnetization sums and add to mean
+//------------------------------------------------------------------------------------------------------
+void magnetization_statistic_t::normalize_magnetization(){
+
    // Calculate magnetisation length and normalize
    for(int mask_id=0; mask_id<mask_size; ++mask_id){
       double msat = magnetization[4*mask_id + 3];
@@ -13,8 +13,12 @@
 #include <sstream>
 
 // Vampire headers
+#include "anisotropy.hpp"
+#include "dipole.hpp"
 #include "errors.hpp"
+#include "exchange.hpp"
 #include "gpu.hpp"
+#include "sim.hpp"
 #include "stats.hpp"
 #include "vmpi.hpp"
 
@@ -36,15 +40,8 @@ namespace stats{
          gpu::stats::update();
       }
       else{
-         // update energy statistics
-         if(stats::calculate_system_energy)                 stats::system_energy.calculate(sx, sy, sz, mm, mat, temperature);
-         if(stats::calculate_material_energy)               stats::material_energy.calculate(sx, sy, sz, mm, mat, temperature);
-
-         // update magnetization statistics
-         if(stats::calculate_system_magnetization)          stats::system_magnetization.calculate_magnetization(sx,sy,sz,mm);
-         if(stats::calculate_material_magnetization)        stats::material_magnetization.calculate_magnetization(sx,sy,sz,mm);
-         if(stats::calculate_height_magnetization)          stats::height_magnetization.calculate_magnetization(sx,sy,sz,mm);
-         if(stats::calculate_material_height_magnetization) stats::material_height_magnetization.calculate_magnetization(sx,sy,sz,mm);
+         // update energy and magnetization statistics in a single pass over all atoms
+         stats::update_fused(sx, sy, sz, mm, mat, temperature);
 
          // update specific heat statistics
          if(stats::calculate_system_specific_heat)         stats::system_specific_heat.calculate(stats::system_energy.get_total_energy());
@@ -62,6 +59,154 @@ namespace stats{
 
    }
 
+   //------------------------------------------------------------------------------------------------------
+   // Function to calculate all required energy and magnetization statistics in a single pass
+   //
+   // The energy terms and moment of each atom are calculated once and added to all active statistics,
+   // with the sums for all statistics stored in a single packed buffer
+   //
+   //    buffer | magnetization 1 | ... | magnetization n | energy 1 | ... | energy m |
+   //
+   // where each magnetization statistic stores | mx my mz m | for each mask id (as in the magnetization
+   // array) and each energy statistic stores | exchange | anisotropy | applied field | magnetostatic |
+   // arrays with one value per mask id. The buffer is then reduced with a single MPI_Allreduce and
+   // the results are copied back to each statistic.
+   //------------------------------------------------------------------------------------------------------
+   void update_fused(const std::vector<double>& sx, // spin unit vector
+                     const std::vector<double>& sy,
+                     const std::vector<double>& sz,
+                     const std::vector<double>& mm,
+                     const std::vector<int>& mat,
+                     const double temperature
+                  ){
+
+      // list active statistics
+      std::vector<magnetization_statistic_t*> mag_stats;
+      std::vector<energy_statistic_t*> energy_stats;
+
+      if(stats::calculate_system_energy)                 energy_stats.push_back(&stats::system_energy);
+      if(stats::calculate_material_energy)               energy_stats.push_back(&stats::material_energy);
+      if(stats::calculate_system_magnetization)          mag_stats.push_back(&stats::system_magnetization);
+      if(stats::calculate_material_magnetization)        mag_stats.push_back(&stats::material_magnetization);
+      if(stats::calculate_height_magnetization)          mag_stats.push_back(&stats::height_magnetization);
+      if(stats::calculate_material_height_magnetization) mag_stats.push_back(&stats::material_height_magnetization);
+
+      const int num_mag_stats = mag_stats.size();
+      const int num_energy_stats = energy_stats.size();
+
+      if(num_mag_stats + num_energy_stats == 0) return;
+
+      // determine offsets of each statistic in packed buffer and number of atoms
+      std::vector<int> mag_offsets(num_mag_stats);
+      std::vector<int> energy_offsets(num_energy_stats);
+      int buffer_size = 0;
+      int num_atoms = 0;
+
+      for(int s = 0; s < num_mag_stats; ++s){
+         mag_offsets[s] = buffer_size;
+         buffer_size += mag_stats[s]->magnetization.size();
+         num_atoms = mag_stats[s]->num_atoms;
+      }
+      for(int s = 0; s < num_energy_stats; ++s){
+         energy_offsets[s] = buffer_size;
+         buffer_size += 4 * energy_stats[s]->total_energy.size();
+         num_atoms = energy_stats[s]->num_atoms;
+      }
+
+      // packed buffer for all statistics
+      static std::vector<double> buffer;
+      buffer.assign(buffer_size, 0.0);
+
+      // pointers to mask arrays for each statistic
+      std::vector<const int*> mag_masks(num_mag_stats);
+      std::vector<const int*> energy_masks(num_energy_stats);
+      std::vector<int> energy_strides(num_energy_stats);
+      for(int s = 0; s < num_mag_stats; ++s) mag_masks[s] = mag_stats[s]->mask.data();
+      for(int s = 0; s < num_energy_stats; ++s){
+         energy_masks[s] = energy_stats[s]->mask.data();
+         energy_strides[s] = energy_stats[s]->total_energy.size();
+      }
+
+      double* const buf = buffer.data();
+
+      //---------------------------------------------------------------------------
+      // Calculate contributions of each atom to all statistics
+      //---------------------------------------------------------------------------
+      for(int atom = 0; atom < num_atoms; ++atom){
+
+         const double m = mm[atom];
+         const double mx = sx[atom] * m;
+         const double my = sy[atom] * m;
+         const double mz = sz[atom] * m;
+
+         for(int s = 0; s < num_mag_stats; ++s){
+            double* const data = buf + mag_offsets[s] + 4 * mag_masks[s][atom];
+            data[0] += mx;
+            data[1] += my;
+            data[2] += mz;
+            data[3] += m;
+         }
+
+         if(num_energy_stats > 0){
+
+            // calculate energies of spin once for all energy statistics (in Tesla)
+            double exchange_energy = exchange::single_spin_energy(atom, sx[atom], sy[atom], sz[atom]) * m;
+            if(exchange::biquadratic) exchange_energy += exchange::single_spin_biquadratic_energy(atom, sx[atom], sy[atom], sz[atom]) * m;
+            const double anisotropy_energy = anisotropy::single_spin_energy(atom, mat[atom], sx[atom], sy[atom], sz[atom], temperature) * m;
+            const double applied_field_energy = sim::spin_applied_field_energy(sx[atom], sy[atom], sz[atom]) * m;
+            const double magnetostatic_energy = dipole::spin_magnetostatic_energy(atom, sx[atom], sy[atom], sz[atom]) * m;
+
+            for(int s = 0; s < num_energy_stats; ++s){
+               const int stride = energy_strides[s];
+               double* const data = buf + energy_offsets[s] + energy_masks[s][atom];
+               data[0]          += exchange_energy;
+               data[stride]     += anisotropy_energy;
+               data[2 * stride] += applied_field_energy;
+               data[3 * stride] += magnetostatic_energy;
+            }
+
+         }
+
+      }
+
+      //---------------------------------------------------------------------------
+      // Reduce all statistics on all CPUS
+      //---------------------------------------------------------------------------
+      #ifdef MPICF
+         MPI_Allreduce(MPI_IN_PLACE, buf, buffer_size, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      #endif
+
+      //---------------------------------------------------------------------------
+      // Copy results to each statistic
+      //---------------------------------------------------------------------------
+      for(int s = 0; s < num_mag_stats; ++s){
+         magnetization_statistic_t& stat = *mag_stats[s];
+         std::copy(buf + mag_offsets[s], buf + mag_offsets[s] + stat.magnetization.size(), stat.magnetization.begin());
+         stat.normalize_magnetization();
+      }
+
+      for(int s = 0; s < num_energy_stats; ++s){
+         energy_statistic_t& stat = *energy_stats[s];
+         const int stride = energy_strides[s];
+         const double* const data = buf + energy_offsets[s];
+         for(int mask_id = 0; mask_id < stat.mask_size; ++mask_id){
+            // account for factor 1/2 in double summation of exchange and magnetostatic energies
+            stat.exchange_energy[mask_id]      = 0.5 * data[mask_id];
+            stat.anisotropy_energy[mask_id]    = data[stride + mask_id];
+            stat.applied_field_energy[mask_id] = data[2 * stride + mask_id];
+            stat.magnetostatic_energy[mask_id] = 0.5 * data[3 * stride + mask_id];
+            stat.total_energy[mask_id] = stat.exchange_energy[mask_id] +
+                                         stat.anisotropy_energy[mask_id] +
+                                         stat.applied_field_energy[mask_id] +
+                                         stat.magnetostatic_energy[mask_id];
+         }
+         stat.accumulate_mean_energy();
+      }
+
+      return;
+
+   }
+
    //------------------------------------------------------------------------------------------------------
    // Function to reset required statistics classes
    //------------------------------------------------------------------------------------------------------
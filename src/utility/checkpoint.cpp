@@ -21,14 +21,156 @@
 #include "vio.hpp"
 #include "program.hpp"
 
+//-----------------------------------------------------------------------------
+//
+// Checkpoints for each process are saved alternately to two generations of
+// files, vampire<rank>.chk.0 and vampire<rank>.chk.1, labelled by a checkpoint
+// sequence number in the file header. A crash while writing can leave at most
+// one generation incomplete or out of step between processes, and so the
+// newest generation which is complete on all processes is loaded. Each file
+// starts with a format version number. Single checkpoint files vampire<rank>.chk
+// written by earlier versions of the code (format version 1, without version,
+// sequence number or total step count) are loaded if no newer checkpoint exists.
+//
+//-----------------------------------------------------------------------------
+
+namespace{
+
+   const int num_checkpoint_generations = 2; // number of alternating checkpoint files
+   const uint64_t checkpoint_format_version = 2; // version of file-per-process checkpoint format
+   uint64_t next_checkpoint_sequence = 0; // sequence number of next checkpoint saved
+
+   //--------------------------------------------------------------------------
+   // Function to determine checkpoint file name for a generation
+   //--------------------------------------------------------------------------
+   std::string checkpoint_filename(const int generation){
+      std::stringstream chkfilenamess;
+      chkfilenamess << "vampire" << vmpi::my_rank << ".chk." << generation;
+      return chkfilenamess.str();
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to determine legacy (format version 1) checkpoint file name
+   //--------------------------------------------------------------------------
+   std::string legacy_checkpoint_filename(){
+      std::stringstream chkfilenamess;
+      chkfilenamess << "vampire" << vmpi::my_rank << ".chk";
+      return chkfilenamess.str();
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to compute total size of checkpoint file in bytes
+   //--------------------------------------------------------------------------
+   uint64_t checkpoint_file_size(const uint64_t natoms64, const uint64_t num_rng_states){
+      return 4*sizeof(uint64_t) + 7*sizeof(int64_t) + 3*sizeof(double) + 2*sizeof(bool)
+             + sizeof(int32_t) + sizeof(uint32_t)*num_rng_states + 3*sizeof(double)*natoms64;
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to compute total size of legacy checkpoint file in bytes
+   //--------------------------------------------------------------------------
+   uint64_t legacy_checkpoint_file_size(const uint64_t natoms64, const uint64_t num_rng_states){
+      return sizeof(uint64_t) + 7*sizeof(int64_t) + 3*sizeof(double) + 2*sizeof(bool)
+             + sizeof(int32_t) + sizeof(uint32_t)*num_rng_states + 3*sizeof(double)*natoms64;
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to read sequence number of complete checkpoint file, returning
+   // -1 if the file does not exist, is incomplete or has wrong number of atoms
+   //--------------------------------------------------------------------------
+   int64_t read_checkpoint_sequence(const std::string filename, const uint64_t natoms64, const uint64_t num_rng_states){
+
+      std::ifstream chkfile(filename.c_str(), std::ios::binary | std::ios::ate);
+      if(!chkfile.is_open()) return -1;
+
+      const uint64_t file_size = chkfile.tellg();
+      chkfile.seekg(0);
+
+      uint64_t version64 = 0;
+      uint64_t file_natoms64 = 0;
+      uint64_t sequence64 = 0;
+      chkfile.read((char*)&version64,sizeof(uint64_t));
+      chkfile.read((char*)&file_natoms64,sizeof(uint64_t));
+      chkfile.read((char*)&sequence64,sizeof(uint64_t));
+
+      if(chkfile && version64 != checkpoint_format_version){
+         zlog << zTs() << "Warning: Ignoring checkpoint file " << filename << " with unsupported format version " << version64
+              << " (expected " << checkpoint_format_version << ")." << std::endl;
+         return -1;
+      }
+
+      if(!chkfile || file_natoms64 != natoms64 || file_size != checkpoint_file_size(natoms64, num_rng_states)){
+         zlog << zTs() << "Warning: Ignoring incomplete or invalid checkpoint file " << filename << "." << std::endl;
+         return -1;
+      }
+
+      return int64_t(sequence64);
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to check for complete legacy checkpoint file
+   //--------------------------------------------------------------------------
+   bool legacy_checkpoint_valid(const uint64_t natoms64, const uint64_t num_rng_states){
+
+      std::ifstream chkfile(legacy_checkpoint_filename().c_str(), std::ios::binary | std::ios::ate);
+      if(!chkfile.is_open()) return false;
+
+      const uint64_t file_size = chkfile.tellg();
+      chkfile.seekg(0);
+
+      uint64_t file_natoms64 = 0;
+      chkfile.read((char*)&file_natoms64,sizeof(uint64_t));
+
+      if(!chkfile || file_natoms64 != natoms64 || file_size != legacy_checkpoint_file_size(natoms64, num_rng_states)){
+         zlog << zTs() << "Warning: Ignoring incomplete or invalid legacy checkpoint file " << legacy_checkpoint_filename() << "." << std::endl;
+         return false;
+      }
+
+      return true;
+
+   }
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to determine if checkpoint file exists for this process
+//-----------------------------------------------------------------------------
+bool checkpoint_exists(){
+
+   if(sim::checkpoint_shared_file){
+      std::ifstream chkfile("vampire.chk", std::ios::binary);
+      return chkfile.good();
+   }
+
+   for(int g = 0; g < num_checkpoint_generations; g++){
+      std::ifstream chkfile(checkpoint_filename(g).c_str(), std::ios::binary);
+      if(chkfile.good()) return true;
+   }
+
+   // check for legacy checkpoint file
+   std::ifstream chkfile(legacy_checkpoint_filename().c_str(), std::ios::binary);
+   return chkfile.good();
+
+}
+
 //-----------------------------------------------------------------------------
 // Function to save checkpoint file
 //-----------------------------------------------------------------------------
 void save_checkpoint(){
 
+   // optionally save single checkpoint file for all processes
+   if(sim::checkpoint_shared_file){
+      save_shared_checkpoint();
+      return;
+   }
+
    // convert number of atoms, rank and time to standard long int
+   uint64_t version64 = checkpoint_format_version;
    uint64_t natoms64 = uint64_t(atoms::num_atoms-vmpi::num_halo_atoms);
+   uint64_t sequence64 = next_checkpoint_sequence;
    int64_t time64 = int64_t(sim::time);
+   uint64_t total_steps64 = sim::total_steps;
    int64_t eqtime64 = int64_t(sim::equilibration_time);
    int64_t parity64 = int64_t(sim::parity);
    int64_t iH64 = int64_t(sim::iH);
@@ -41,10 +183,56 @@ void save_checkpoint(){
    bool flag_constraint_theta_changed = sim::constraint_theta_changed;
    bool flag_constraint_phi_changed   = sim::constraint_phi_changed;
 
-   // determine checkpoint file name
-   std::stringstream chkfilenamess;
-   chkfilenamess << "vampire" << vmpi::my_rank << ".chk";
-   std::string chkfilename = chkfilenamess.str();
+   // determine checkpoint file name, alternating between generations
+   std::string chkfilename = checkpoint_filename(sequence64 % num_checkpoint_generations);
+   next_checkpoint_sequence++;
+
+   // get state of random number generator
+   std::vector<uint32_t> mt_state(624); // 624 is hard coded in mt implementation. uint64 assumes same size as unsigned long
+   int32_t mt_p=0; // position in rng state
+   mt_p=mtrandom::grnd.get_state(mt_state);
+   //std::cout << "random generator state = " << mt_p << std::endl;
+
+   // pack checkpoint into buffer, using next free staging buffer for asynchronous output
+   std::vector<char> local_data;
+   std::vector<char>& data = sim::asynchronous_checkpoint ? next_checkpoint_buffer() : local_data;
+   data.clear();
+   data.reserve(200 + sizeof(uint32_t)*mt_state.size() + 3*sizeof(double)*natoms64);
+   auto pack = [&data](const void* value, const size_t size){
+      const char* bytes = reinterpret_cast<const char*>(value);
+      data.insert(data.end(), bytes, bytes + size);
+   };
+
+   // write checkpoint variables to buffer
+   pack(&version64,sizeof(uint64_t));
+   pack(&natoms64,sizeof(uint64_t));
+   pack(&sequence64,sizeof(uint64_t));
+   pack(&time64,sizeof(int64_t));
+   pack(&total_steps64,sizeof(uint64_t));
+   pack(&eqtime64,sizeof(int64_t));
+   pack(&parity64,sizeof(int64_t));
+   pack(&iH64,sizeof(int64_t));
+   pack(&temp,sizeof(double));
+   pack(&constr_theta,sizeof(double));
+   pack(&constr_phi,sizeof(double));
+   pack(&flag_constraint_theta_changed,sizeof(bool));
+   pack(&flag_constraint_phi_changed  ,sizeof(bool));
+   pack(&output_atoms_file_counter64,sizeof(int64_t));
+   pack(&output_cells_file_counter64,sizeof(int64_t));
+   pack(&output_rate_counter64,sizeof(int64_t));
+   pack(&mt_p,sizeof(int32_t));
+   pack(&mt_state[0],sizeof(uint32_t)*mt_state.size());
+
+   // write spin array to buffer
+   pack(&atoms::x_spin_array[0],sizeof(double)*natoms64);
+   pack(&atoms::y_spin_array[0],sizeof(double)*natoms64);
+   pack(&atoms::z_spin_array[0],sizeof(double)*natoms64);
+
+   // write buffer to disk in the background
+   if(sim::asynchronous_checkpoint){
+      queue_checkpoint_buffer(chkfilename);
+      return;
+   }
 
    // open checkpoint file
    std::ofstream chkfile;
@@ -59,33 +247,8 @@ void save_checkpoint(){
       err::vexit();
    }
 
-   // get state of random number generator
-   std::vector<uint32_t> mt_state(624); // 624 is hard coded in mt implementation. uint64 assumes same size as unsigned long
-   int32_t mt_p=0; // position in rng state
-   mt_p=mtrandom::grnd.get_state(mt_state);
-   //std::cout << "random generator state = " << mt_p << std::endl;
-
-   // write checkpoint variables to file
-   chkfile.write(reinterpret_cast<const char*>(&natoms64),sizeof(uint64_t));
-   chkfile.write(reinterpret_cast<const char*>(&time64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&eqtime64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&parity64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&iH64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&temp),sizeof(double));
-   chkfile.write(reinterpret_cast<const char*>(&constr_theta),sizeof(double));
-   chkfile.write(reinterpret_cast<const char*>(&constr_phi),sizeof(double));
-   chkfile.write(reinterpret_cast<const char*>(&flag_constraint_theta_changed),sizeof(bool));
-   chkfile.write(reinterpret_cast<const char*>(&flag_constraint_phi_changed  ),sizeof(bool));
-   chkfile.write(reinterpret_cast<const char*>(&output_atoms_file_counter64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&output_cells_file_counter64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&output_rate_counter64),sizeof(int64_t));
-   chkfile.write(reinterpret_cast<const char*>(&mt_p),sizeof(int32_t));
-   chkfile.write(reinterpret_cast<const char*>(&mt_state[0]),sizeof(uint32_t)*mt_state.size());
-
-   // write spin array to file
-   chkfile.write(reinterpret_cast<const char*>(&atoms::x_spin_array[0]),sizeof(double)*natoms64);
-   chkfile.write(reinterpret_cast<const char*>(&atoms::y_spin_array[0]),sizeof(double)*natoms64);
-   chkfile.write(reinterpret_cast<const char*>(&atoms::z_spin_array[0]),sizeof(double)*natoms64);
+   // write buffer to file
+   chkfile.write(&data[0], data.size());
 
    // close checkpoint file
    chkfile.close();
@@ -98,13 +261,22 @@ void save_checkpoint(){
 }
 
 //-----------------------------------------------------------------------------
-// Function to save checkpoint file
+// Function to load checkpoint file
 //-----------------------------------------------------------------------------
 void load_checkpoint(){
 
+   // optionally load single checkpoint file saved by all processes
+   if(sim::checkpoint_shared_file){
+      load_shared_checkpoint();
+      return;
+   }
+
    // convert number of atoms, rank and time to standard long int
+   uint64_t version64;
    uint64_t natoms64;
+   uint64_t sequence64;
    int64_t time64;
+   uint64_t total_steps64;
    int64_t eqtime64;
    int64_t parity64;
    int64_t iH64;
@@ -121,12 +293,54 @@ void load_checkpoint(){
    std::vector<uint32_t> mt_state(624); // 624 is hard coded in mt implementation. uint64 assumes same size as unsigned long
    int32_t mt_p=0; // position in rng state
 
-   // determine checkpoint file name
-   std::stringstream chkfilenamess;
-   chkfilenamess << "vampire" << vmpi::my_rank << ".chk";
-   std::string chkfilename = chkfilenamess.str();
+   // find sequence number of complete checkpoint in each generation
+   const uint64_t local_natoms64 = uint64_t(atoms::num_atoms-vmpi::num_halo_atoms);
+   int64_t min_sequence[num_checkpoint_generations];
+   int64_t max_sequence[num_checkpoint_generations];
+   for(int g = 0; g < num_checkpoint_generations; g++){
+      min_sequence[g] = read_checkpoint_sequence(checkpoint_filename(g), local_natoms64, mt_state.size());
+      max_sequence[g] = min_sequence[g];
+   }
+
+   // a generation is only valid if complete and saved at the same checkpoint on all processes
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE, min_sequence, num_checkpoint_generations, MPI_INT64_T, MPI_MIN, MPI_COMM_WORLD);
+      MPI_Allreduce(MPI_IN_PLACE, max_sequence, num_checkpoint_generations, MPI_INT64_T, MPI_MAX, MPI_COMM_WORLD);
+   #endif
+
+   // select newest valid generation
+   int generation = -1;
+   for(int g = 0; g < num_checkpoint_generations; g++){
+      if(min_sequence[g] >= 0 && min_sequence[g] == max_sequence[g]){
+         if(generation < 0 || min_sequence[g] > min_sequence[generation]) generation = g;
+      }
+   }
+
+   // otherwise fall back to legacy checkpoint file if complete on all processes
+   bool legacy = false;
+   if(generation < 0){
+      int legacy_valid = legacy_checkpoint_valid(local_natoms64, mt_state.size()) ? 1 : 0;
+      #ifdef MPICF
+         MPI_Allreduce(MPI_IN_PLACE, &legacy_valid, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+      #endif
+      legacy = (legacy_valid == 1);
+   }
+
+   // check for valid checkpoint
+   if(generation < 0 && !legacy){
+      terminaltextcolor(RED);
+      std::cerr << "Error: Unable to find complete checkpoint files vampire" << vmpi::my_rank << ".chk.[0-1] (format version " << checkpoint_format_version
+                << ") or legacy checkpoint file vampire" << vmpi::my_rank << ".chk saved at the same checkpoint on all processes. Exiting." << std::endl;
+      std::cerr << "Info: sim:continue may be specified in the input file which requires a valid checkpoint file." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error: Unable to find complete checkpoint files vampire" << vmpi::my_rank << ".chk.[0-1] (format version " << checkpoint_format_version
+           << ") or legacy checkpoint file vampire" << vmpi::my_rank << ".chk saved at the same checkpoint on all processes. Exiting." << std::endl;
+      zlog << zTs() << "Info: sim:continue may be specified in the input file which requires a valid checkpoint file." << std::endl;
+      err::vexit();
+   }
 
    // open checkpoint file
+   const std::string chkfilename = legacy ? legacy_checkpoint_filename() : checkpoint_filename(generation);
    std::ifstream chkfile;
    chkfile.open(chkfilename.c_str(),std::ios::binary);
 
@@ -134,20 +348,26 @@ void load_checkpoint(){
    if(!chkfile.is_open()){
       terminaltextcolor(RED);
       std::cerr << "Error: Unable to open checkpoint file " << chkfilename << " for reading. Exiting." << std::endl;
-      std::cerr << "Info: sim:continue may be specified in the input file which requires a valid checkpoint file." << std::endl;
       terminaltextcolor(WHITE);
       zlog << zTs() << "Error: Unable to open checkpoint file " << chkfilename << " for reading. Exiting." << std::endl;
-      zlog << zTs() << "Info: sim:continue may be specified in the input file which requires a valid checkpoint file." << std::endl;
       err::vexit();
    }
 
+   // save next checkpoint to other generation
+   next_checkpoint_sequence = legacy ? 0 : min_sequence[generation] + 1;
+   if(legacy) zlog << zTs() << "Info: Loading legacy (format version 1) checkpoint file " << chkfilename << "." << std::endl;
+
    // Set flag to true do determine that this is the beginning of the simulation
    sim::checkpoint_loaded_flag=true;
    zlog << zTs() << "Flag:checkpoint_loaded_flag = " << sim::checkpoint_loaded_flag <<std::endl;
 
-   // read checkpoint variables from file
+   // read checkpoint variables from file (legacy files have no version, sequence number or total step count)
+   if(!legacy) chkfile.read((char*)&version64,sizeof(uint64_t));
    chkfile.read((char*)&natoms64,sizeof(uint64_t));
+   if(!legacy) chkfile.read((char*)&sequence64,sizeof(uint64_t));
    chkfile.read((char*)&time64,sizeof(int64_t));
+   if(!legacy) chkfile.read((char*)&total_steps64,sizeof(uint64_t));
+   else total_steps64 = uint64_t(time64); // best estimate of steps taken for legacy files
    chkfile.read((char*)&eqtime64,sizeof(int64_t));
    chkfile.read((char*)&parity64,sizeof(int64_t));
    chkfile.read((char*)&iH64,sizeof(int64_t));
@@ -180,6 +400,7 @@ void load_checkpoint(){
       sim::parity = parity64;
       sim::iH = iH64;
       sim::time = time64;
+      sim::total_steps = total_steps64;
       sim::equilibration_time = eqtime64;
       sim::temperature = temp;
       sim::output_atoms_file_counter = output_atoms_file_counter64;
@@ -200,7 +421,7 @@ void load_checkpoint(){
    chkfile.close();
 
    // log reading checkpoint file
-   zlog << zTs() << "Checkpoint file loaded at sim::time " << sim::time << "." << std::endl;
+   zlog << zTs() << "Checkpoint file " << chkfilename << " loaded at sim::time " << sim::time << "." << std::endl;
 
    return;
 
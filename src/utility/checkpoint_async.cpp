@@ -0,0 +1,207 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// System headers
+#include <condition_variable>
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Program headers
+#include "errors.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+
+//-----------------------------------------------------------------------------
+//
+// Asynchronous checkpointing
+//
+// Checkpoint data are packed into one of two staging buffers and written to
+// disk by a background thread, so that the simulation only waits if both
+// buffers are still being written. Each checkpoint is written to a temporary
+// file which is flushed to disk with fsync and then renamed over the older of
+// two checkpoint generations, so that a crash during writing leaves the last
+// complete checkpoint intact.
+//
+//-----------------------------------------------------------------------------
+
+namespace{
+
+   const int num_staging_buffers = 2; // checkpoints being packed or written
+   std::vector<char> staging_buffers[num_staging_buffers]; // packed checkpoint data
+   std::string staging_filenames[num_staging_buffers]; // file name for each buffer
+   uint64_t num_queued_checkpoints = 0; // total number of buffers queued for writing
+   uint64_t num_completed_checkpoints = 0; // total number of buffers written to disk
+   bool writer_active = false; // flag set while writer thread is running
+   bool write_failed = false; // flag set if a checkpoint could not be written
+   std::string failed_filename; // name of checkpoint which could not be written
+   std::thread writer_thread; // thread writing buffers to disk
+   std::mutex writer_mutex; // mutex protecting counters and flags
+   std::condition_variable writer_condition; // signals changes in counters
+
+   //--------------------------------------------------------------------------
+   // Function to write data to temporary file, flush to disk and rename
+   //--------------------------------------------------------------------------
+   bool write_checkpoint_file(const std::string& filename, const std::vector<char>& data){
+
+      const std::string tmpfilename = filename + ".tmp";
+
+      int fd = open(tmpfilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if(fd < 0) return false;
+
+      // write all data, allowing for partial writes
+      size_t written = 0;
+      while(written < data.size()){
+         const ssize_t n = write(fd, &data[written], data.size() - written);
+         if(n <= 0){
+            close(fd);
+            return false;
+         }
+         written += n;
+      }
+
+      // ensure data are on disk before replacing previous checkpoint
+      if(fsync(fd) != 0){
+         close(fd);
+         return false;
+      }
+      if(close(fd) != 0) return false;
+
+      return std::rename(tmpfilename.c_str(), filename.c_str()) == 0;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function run by writer thread to write queued checkpoints in order
+   //--------------------------------------------------------------------------
+   void writer_function(){
+
+      std::unique_lock<std::mutex> lock(writer_mutex);
+
+      while(true){
+
+         // wait for queued data or end of simulation
+         while(num_completed_checkpoints == num_queued_checkpoints && writer_active) writer_condition.wait(lock);
+
+         // finish once all data are written
+         if(num_completed_checkpoints == num_queued_checkpoints) break;
+
+         const int b = num_completed_checkpoints % num_staging_buffers;
+
+         // write buffer without holding lock (buffer is not changed until write is completed)
+         lock.unlock();
+         const bool success = write_checkpoint_file(staging_filenames[b], staging_buffers[b]);
+         lock.lock();
+
+         if(!success && !write_failed){
+            write_failed = true;
+            failed_filename = staging_filenames[b];
+         }
+
+         num_completed_checkpoints++;
+         writer_condition.notify_all();
+
+      }
+
+      return;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to stop writer thread once all queued checkpoints are written
+   //--------------------------------------------------------------------------
+   void stop_writer_thread(){
+      {
+         std::unique_lock<std::mutex> lock(writer_mutex);
+         writer_active = false;
+         writer_condition.notify_all();
+      }
+      if(writer_thread.joinable()) writer_thread.join();
+      return;
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to report failed checkpoint write on main thread (writer thread
+   // must be joined before exiting)
+   //--------------------------------------------------------------------------
+   void report_write_failed(){
+      terminaltextcolor(RED);
+      std::cerr << "Error: Unable to write checkpoint file " << failed_filename << ". Exiting." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error: Unable to write checkpoint file " << failed_filename << ". Exiting." << std::endl;
+      err::vexit();
+   }
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to return next free staging buffer for packing checkpoint data,
+// waiting if all buffers are still being written
+//-----------------------------------------------------------------------------
+std::vector<char>& next_checkpoint_buffer(){
+
+   std::unique_lock<std::mutex> lock(writer_mutex);
+
+   // start writer thread on first call
+   if(!writer_active){
+      writer_active = true;
+      writer_thread = std::thread(writer_function);
+   }
+
+   // wait for free buffer
+   while(num_queued_checkpoints - num_completed_checkpoints >= uint64_t(num_staging_buffers)) writer_condition.wait(lock);
+
+   // stop writer thread before exiting if a previous checkpoint could not be written
+   if(write_failed){
+      lock.unlock();
+      stop_writer_thread();
+      report_write_failed();
+   }
+
+   return staging_buffers[num_queued_checkpoints % num_staging_buffers];
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to queue packed staging buffer for writing to disk
+//-----------------------------------------------------------------------------
+void queue_checkpoint_buffer(const std::string filename){
+
+   std::unique_lock<std::mutex> lock(writer_mutex);
+
+   staging_filenames[num_queued_checkpoints % num_staging_buffers] = filename;
+   num_queued_checkpoints++;
+   writer_condition.notify_all();
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to complete all outstanding checkpoints at end of simulation
+//-----------------------------------------------------------------------------
+void finalize_checkpoint(){
+
+   // stop writer thread once all queued checkpoints are written
+   stop_writer_thread();
+   if(write_failed) report_write_failed();
+
+   // complete outstanding shared checkpoint
+   complete_shared_checkpoint();
+
+   if(num_completed_checkpoints > 0) zlog << zTs() << num_completed_checkpoints << " checkpoint files written to disk in the background." << std::endl;
+
+   return;
+
+}
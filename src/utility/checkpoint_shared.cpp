@@ -0,0 +1,494 @@
+//-----------------------------------------------------------------------------
+//
+// This source file is part of the VAMPIRE open source package under the
+// GNU GPL (version 2) licence (see licence file for details).
+//
+// (c) VAMPIRE contributors 2026. All rights reserved.
+//
+//-----------------------------------------------------------------------------
+
+// System headers
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Program headers
+#include "atoms.hpp"
+#include "create.hpp"
+#include "errors.hpp"
+#include "random.hpp"
+#include "sim.hpp"
+#include "vio.hpp"
+#include "vmpi.hpp"
+
+//-----------------------------------------------------------------------------
+//
+// Shared checkpoint file written by all processes
+//
+// The checkpoint is a single file vampire.chk with spins stored by global
+// atom id, so that a simulation can be restarted with any number of processes.
+// The global atom id depends only on the unit cell position of each atom and
+// is independent of the decomposition. In parallel the file is written and
+// read collectively with MPI-IO.
+//
+// File layout:
+//
+//    | header | rng state for each process | x y z | x y z | ... | x y z |
+//                                              id 0                id n-1
+//
+// Spins are stored at a fixed offset for every possible id, and so ids which
+// do not correspond to an atom (eg outside the particle shape) leave unused
+// gaps in the file.
+//
+// The random number generator state is saved for each process and restored
+// only if the number of processes is unchanged.
+//
+//-----------------------------------------------------------------------------
+
+namespace{
+
+   // checkpoint header with simulation state
+   struct checkpoint_header_t{
+      char magic[8]; // file identifier
+      uint64_t num_ids; // range of global atom ids
+      uint64_t num_atoms; // total number of atoms
+      int64_t num_rng_states; // number of processes saving rng state
+      int64_t integrator;
+      int64_t program;
+      int64_t time;
+      uint64_t total_steps;
+      int64_t equilibration_time;
+      int64_t parity;
+      int64_t iH;
+      int64_t output_atoms_file_counter;
+      int64_t output_cells_file_counter;
+      int64_t output_rate_counter;
+      int64_t constraint_theta_changed;
+      int64_t constraint_phi_changed;
+      double temperature;
+      double constraint_theta;
+      double constraint_phi;
+   };
+
+   const char checkpoint_magic[8] = {'V','A','M','P','C','H','K','2'};
+
+   const uint64_t rng_state_size = 625; // 624 state integers and position in state
+
+   // number of atoms owned by this process (excluding halo)
+   inline uint64_t num_local_atoms(){
+      return uint64_t(atoms::num_atoms - vmpi::num_halo_atoms);
+   }
+
+   // range of global atom ids (see cs_set_atom_vars2.cpp)
+   inline uint64_t num_global_ids(){
+      return uint64_t(cs::total_num_unit_cells[0]) * uint64_t(cs::total_num_unit_cells[1]) *
+             uint64_t(cs::total_num_unit_cells[2]) * uint64_t(cs::unit_cell.atom.size());
+   }
+
+   // byte offsets of rng states and spin data
+   inline uint64_t rng_offset(){ return sizeof(checkpoint_header_t); }
+   inline uint64_t spin_offset(const int64_t num_rng_states){
+      return rng_offset() + uint64_t(num_rng_states) * rng_state_size * sizeof(uint32_t);
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to list local atoms in order of global id
+   //--------------------------------------------------------------------------
+   std::vector<uint64_t> sorted_local_atoms(){
+
+      std::vector<uint64_t> atom_list(num_local_atoms());
+      for(uint64_t atom = 0; atom < atom_list.size(); atom++) atom_list[atom] = atom;
+
+      std::sort(atom_list.begin(), atom_list.end(), [](const uint64_t a, const uint64_t b){
+         return atoms::global_id_array[a] < atoms::global_id_array[b];
+      });
+
+      return atom_list;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to get state of random number generator as a single array
+   //--------------------------------------------------------------------------
+   std::vector<uint32_t> get_rng_state(){
+
+      std::vector<uint32_t> mt_state(624);
+      const int32_t mt_p = mtrandom::grnd.get_state(mt_state);
+      mt_state.push_back(uint32_t(mt_p));
+
+      return mt_state;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to set state of random number generator from single array
+   //--------------------------------------------------------------------------
+   void set_rng_state(std::vector<uint32_t>& rng_state){
+
+      int32_t mt_p = int32_t(rng_state[624]);
+      rng_state.resize(624);
+      mtrandom::grnd.set_state(rng_state, mt_p);
+
+      return;
+
+   }
+
+   //--------------------------------------------------------------------------
+   // Function to exit with error message on all processes
+   //--------------------------------------------------------------------------
+   void checkpoint_error(const std::string message){
+      terminaltextcolor(RED);
+      std::cerr << "Error: " << message << " Exiting." << std::endl;
+      terminaltextcolor(WHITE);
+      zlog << zTs() << "Error: " << message << " Exiting." << std::endl;
+      err::vexit();
+   }
+
+   #ifdef MPICF
+   // variables for asynchronous output with non-blocking MPI-IO
+   bool write_pending = false; // flag set while checkpoint is being written
+   MPI_File pending_file; // file being written
+   MPI_Request pending_request; // request for non-blocking write of spins
+   MPI_Datatype pending_spin_type; // data types used for write
+   MPI_Datatype pending_file_type;
+   MPI_Offset pending_file_size; // total size of checkpoint file
+   std::vector<double> staging_buffer; // spin data being written
+   #endif
+
+   #ifdef MPICF
+   //--------------------------------------------------------------------------
+   // Function to create MPI file type selecting spins of local atoms in file,
+   // merging consecutive ids into single blocks
+   //--------------------------------------------------------------------------
+   MPI_Datatype create_spin_file_type(const std::vector<uint64_t>& atom_list, MPI_Datatype& spin_type){
+
+      MPI_Type_contiguous(3, MPI_DOUBLE, &spin_type);
+      MPI_Type_commit(&spin_type);
+
+      std::vector<int> block_lengths;
+      std::vector<MPI_Aint> displacements;
+
+      for(uint64_t index = 0; index < atom_list.size(); index++){
+         const uint64_t id = atoms::global_id_array[atom_list[index]];
+         if(index > 0 && id == atoms::global_id_array[atom_list[index-1]] + 1) block_lengths.back()++;
+         else{
+            block_lengths.push_back(1);
+            displacements.push_back(MPI_Aint(id * 3 * sizeof(double)));
+         }
+      }
+
+      MPI_Datatype file_type;
+      MPI_Type_create_hindexed(block_lengths.size(), block_lengths.data(), displacements.data(), spin_type, &file_type);
+      MPI_Type_commit(&file_type);
+
+      return file_type;
+
+   }
+   #endif
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to complete asynchronous shared checkpoint, flushing data to disk
+// and replacing previous checkpoint file
+//-----------------------------------------------------------------------------
+void complete_shared_checkpoint(){
+
+   #ifdef MPICF
+
+      if(!write_pending) return;
+
+      MPI_Wait(&pending_request, MPI_STATUS_IGNORE);
+
+      // set file size to include gaps after last atom and flush to disk
+      MPI_File_set_size(pending_file, pending_file_size);
+      MPI_File_sync(pending_file);
+      MPI_File_close(&pending_file);
+      MPI_Type_free(&pending_file_type);
+      MPI_Type_free(&pending_spin_type);
+
+      // replace previous checkpoint once data are on disk on all processes
+      MPI_Barrier(MPI_COMM_WORLD);
+      if(vmpi::my_rank == 0 && std::rename("vampire.chk.tmp", "vampire.chk") != 0){
+         checkpoint_error("Unable to rename checkpoint file vampire.chk.tmp to vampire.chk.");
+      }
+
+      write_pending = false;
+
+   #endif
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to save shared checkpoint file
+//-----------------------------------------------------------------------------
+void save_shared_checkpoint(){
+
+   const std::string chkfilename = "vampire.chk";
+
+   // calculate total number of atoms
+   uint64_t total_atoms = num_local_atoms();
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE, &total_atoms, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+   #endif
+
+   // set header
+   checkpoint_header_t header;
+   std::memset(&header, 0, sizeof(header));
+   std::memcpy(header.magic, checkpoint_magic, 8);
+   header.num_ids = num_global_ids();
+   header.num_atoms = total_atoms;
+   header.num_rng_states = vmpi::num_processors;
+   header.integrator = sim::integrator;
+   header.program = sim::program;
+   header.time = sim::time;
+   header.total_steps = sim::total_steps;
+   header.equilibration_time = sim::equilibration_time;
+   header.parity = sim::parity;
+   header.iH = sim::iH;
+   header.output_atoms_file_counter = sim::output_atoms_file_counter;
+   header.output_cells_file_counter = sim::output_cells_file_counter;
+   header.output_rate_counter = sim::output_rate_counter;
+   header.constraint_theta_changed = sim::constraint_theta_changed;
+   header.constraint_phi_changed = sim::constraint_phi_changed;
+   header.temperature = sim::temperature;
+   header.constraint_theta = sim::constraint_theta;
+   header.constraint_phi = sim::constraint_phi;
+
+   std::vector<uint32_t> rng_state = get_rng_state();
+
+   // pack local spins in order of global id
+   const std::vector<uint64_t> atom_list = sorted_local_atoms();
+   std::vector<double> buffer(3 * atom_list.size());
+   for(uint64_t index = 0; index < atom_list.size(); index++){
+      const uint64_t atom = atom_list[index];
+      buffer[3*index + 0] = atoms::x_spin_array[atom];
+      buffer[3*index + 1] = atoms::y_spin_array[atom];
+      buffer[3*index + 2] = atoms::z_spin_array[atom];
+   }
+
+   #ifdef MPICF
+
+      // complete previous checkpoint and write this one to temporary file for asynchronous output
+      complete_shared_checkpoint();
+      const std::string filename = sim::asynchronous_checkpoint ? chkfilename + ".tmp" : chkfilename;
+
+      MPI_File fh;
+      char *cfilename = (char*)filename.c_str();
+      if(MPI_File_open(MPI_COMM_WORLD, cfilename, MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL, &fh) != MPI_SUCCESS){
+         checkpoint_error("Unable to open checkpoint file " + filename + " for writing.");
+      }
+
+      // write header on root process and rng state for all processes
+      MPI_Status status;
+      if(vmpi::my_rank == 0) MPI_File_write_at(fh, 0, &header, sizeof(header), MPI_BYTE, &status);
+      const MPI_Offset rng_disp = rng_offset() + uint64_t(vmpi::my_rank) * rng_state_size * sizeof(uint32_t);
+      MPI_File_write_at_all(fh, rng_disp, &rng_state[0], rng_state_size, MPI_UINT32_T, &status);
+
+      // write spins collectively at positions given by global atom id
+      MPI_Datatype spin_type;
+      MPI_Datatype file_type = create_spin_file_type(atom_list, spin_type);
+      MPI_File_set_view(fh, spin_offset(header.num_rng_states), spin_type, file_type, (char*)"native", MPI_INFO_NULL);
+
+      // start non-blocking write, completed at next checkpoint or end of simulation
+      if(sim::asynchronous_checkpoint){
+         staging_buffer.swap(buffer);
+         MPI_File_iwrite_all(fh, staging_buffer.data(), atom_list.size(), spin_type, &pending_request);
+         pending_file = fh;
+         pending_spin_type = spin_type;
+         pending_file_type = file_type;
+         pending_file_size = spin_offset(header.num_rng_states) + header.num_ids * 3 * sizeof(double);
+         write_pending = true;
+         return;
+      }
+
+      MPI_File_write_all(fh, buffer.data(), atom_list.size(), spin_type, &status);
+
+      // set file size to include gaps after last atom
+      MPI_File_set_size(fh, spin_offset(header.num_rng_states) + header.num_ids * 3 * sizeof(double));
+
+      MPI_File_close(&fh);
+      MPI_Type_free(&file_type);
+      MPI_Type_free(&spin_type);
+
+   #else
+
+      // pack header, rng state and spins expanded to full range of global ids
+      std::vector<char> local_data;
+      std::vector<char>& data = sim::asynchronous_checkpoint ? next_checkpoint_buffer() : local_data;
+      data.assign(spin_offset(header.num_rng_states) + header.num_ids * 3 * sizeof(double), 0);
+      std::memcpy(&data[0], &header, sizeof(header));
+      std::memcpy(&data[rng_offset()], &rng_state[0], sizeof(uint32_t) * rng_state_size);
+      for(uint64_t index = 0; index < atom_list.size(); index++){
+         const uint64_t id = atoms::global_id_array[atom_list[index]];
+         std::memcpy(&data[spin_offset(header.num_rng_states) + id * 3 * sizeof(double)], &buffer[3*index], 3 * sizeof(double));
+      }
+
+      // write buffer to disk in the background
+      if(sim::asynchronous_checkpoint){
+         queue_checkpoint_buffer(chkfilename);
+         return;
+      }
+
+      // open checkpoint file
+      std::ofstream chkfile;
+      chkfile.open(chkfilename.c_str(), std::ios::binary);
+
+      // check for open file
+      if(!chkfile.is_open()) checkpoint_error("Unable to open checkpoint file " + chkfilename + " for writing.");
+
+      chkfile.write(&data[0], data.size());
+
+      chkfile.close();
+
+   #endif
+
+   // log writing checkpoint file (only for non-continuous checkpoint files)
+   if(!sim::save_checkpoint_continuous_flag) zlog << zTs() << "Shared checkpoint file written to disk." << std::endl;
+
+   return;
+
+}
+
+//-----------------------------------------------------------------------------
+// Function to load shared checkpoint file
+//-----------------------------------------------------------------------------
+void load_shared_checkpoint(){
+
+   const std::string chkfilename = "vampire.chk";
+
+   checkpoint_header_t header;
+   std::vector<uint32_t> rng_state(rng_state_size);
+
+   const std::vector<uint64_t> atom_list = sorted_local_atoms();
+   std::vector<double> buffer(3 * atom_list.size());
+
+   // calculate total number of atoms
+   uint64_t total_atoms = num_local_atoms();
+   #ifdef MPICF
+      MPI_Allreduce(MPI_IN_PLACE, &total_atoms, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+   #endif
+
+   #ifdef MPICF
+
+      MPI_File fh;
+      char *cfilename = (char*)chkfilename.c_str();
+      if(MPI_File_open(MPI_COMM_WORLD, cfilename, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS){
+         checkpoint_error("Unable to open checkpoint file " + chkfilename + " for reading.");
+      }
+
+      // read header on root process and share with all processes
+      MPI_Status status;
+      if(vmpi::my_rank == 0) MPI_File_read_at(fh, 0, &header, sizeof(header), MPI_BYTE, &status);
+      MPI_Bcast(&header, sizeof(header), MPI_BYTE, 0, MPI_COMM_WORLD);
+
+   #else
+
+      // open checkpoint file
+      std::ifstream chkfile;
+      chkfile.open(chkfilename.c_str(), std::ios::binary);
+
+      // check for open file
+      if(!chkfile.is_open()) checkpoint_error("Unable to open checkpoint file " + chkfilename + " for reading.");
+
+      chkfile.read((char*)&header, sizeof(header));
+      if(!chkfile) std::memset(&header, 0, sizeof(header));
+
+   #endif
+
+   // check file is consistent with generated system
+   if(std::memcmp(header.magic, checkpoint_magic, 8) != 0){
+      checkpoint_error("File " + chkfilename + " is not a valid shared checkpoint file.");
+   }
+   if(header.num_ids != num_global_ids() || header.num_atoms != total_atoms){
+      std::stringstream message;
+      message << "Mismatch between number of atoms in checkpoint file (" << header.num_atoms << ") and number of generated atoms (" << total_atoms << ").";
+      checkpoint_error(message.str());
+   }
+   if(header.integrator != sim::integrator){
+      zlog << zTs() << "Warning: Checkpoint file was saved with a different integrator (" << header.integrator << ") to the current simulation (" << sim::integrator << ")." << std::endl;
+   }
+
+   // rng state can only be restored for the same number of processes
+   const bool restore_rng = (header.num_rng_states == vmpi::num_processors);
+
+   #ifdef MPICF
+
+      if(restore_rng){
+         const MPI_Offset rng_disp = rng_offset() + uint64_t(vmpi::my_rank) * rng_state_size * sizeof(uint32_t);
+         MPI_File_read_at_all(fh, rng_disp, &rng_state[0], rng_state_size, MPI_UINT32_T, &status);
+      }
+
+      // read spins collectively from positions given by global atom id
+      MPI_Datatype spin_type;
+      MPI_Datatype file_type = create_spin_file_type(atom_list, spin_type);
+      MPI_File_set_view(fh, spin_offset(header.num_rng_states), spin_type, file_type, (char*)"native", MPI_INFO_NULL);
+      MPI_File_read_all(fh, buffer.data(), atom_list.size(), spin_type, &status);
+
+      MPI_File_close(&fh);
+      MPI_Type_free(&file_type);
+      MPI_Type_free(&spin_type);
+
+   #else
+
+      if(restore_rng) chkfile.read((char*)&rng_state[0], sizeof(uint32_t) * rng_state_size);
+
+      // read spins for full range of global ids
+      std::vector<double> spins(3 * header.num_ids);
+      chkfile.seekg(spin_offset(header.num_rng_states));
+      chkfile.read((char*)&spins[0], sizeof(double) * spins.size());
+
+      if(!chkfile) checkpoint_error("Unable to read spin data from checkpoint file " + chkfilename + ".");
+
+      for(uint64_t index = 0; index < atom_list.size(); index++){
+         const uint64_t id = atoms::global_id_array[atom_list[index]];
+         for(int c = 0; c < 3; c++) buffer[3*index + c] = spins[3*id + c];
+      }
+
+      chkfile.close();
+
+   #endif
+
+   // Set flag to true do determine that this is the beginning of the simulation
+   sim::checkpoint_loaded_flag=true;
+
+   // if continuing set state of rng and saved parameters
+   if(sim::load_checkpoint_continue_flag){
+      if(restore_rng) set_rng_state(rng_state);
+      else zlog << zTs() << "Warning: Checkpoint file was saved with " << header.num_rng_states << " processes and so random number generator state is not restored." << std::endl;
+      sim::parity = header.parity;
+      sim::iH = header.iH;
+      sim::time = header.time;
+      sim::total_steps = header.total_steps;
+      sim::equilibration_time = header.equilibration_time;
+      sim::temperature = header.temperature;
+      sim::output_atoms_file_counter = header.output_atoms_file_counter;
+      sim::output_cells_file_counter = header.output_cells_file_counter;
+      sim::output_rate_counter = header.output_rate_counter;
+      sim::constraint_theta = header.constraint_theta;
+      sim::constraint_phi = header.constraint_phi;
+      sim::constraint_theta_changed = header.constraint_theta_changed;
+      sim::constraint_phi_changed = header.constraint_phi_changed;
+   }
+
+   // unpack spins
+   for(uint64_t index = 0; index < atom_list.size(); index++){
+      const uint64_t atom = atom_list[index];
+      atoms::x_spin_array[atom] = buffer[3*index + 0];
+      atoms::y_spin_array[atom] = buffer[3*index + 1];
+      atoms::z_spin_array[atom] = buffer[3*index + 2];
+   }
+
+   // log reading checkpoint file
+   zlog << zTs() << "Shared checkpoint file saved with " << header.num_rng_states << " processes loaded at sim::time " << sim::time << "." << std::endl;
+
+   return;
+
+}
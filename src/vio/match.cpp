@@ -341,6 +341,11 @@ namespace vin{
                 sim::integrator=4;
                 return EXIT_SUCCESS;
             }
+            test="coloured-monte-carlo";
+            if(value==test){
+                sim::integrator=5;
+                return EXIT_SUCCESS;
+            }
             else{
             terminaltextcolor(RED);
                 std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
@@ -348,6 +353,8 @@ namespace vin{
                 std::cerr << "\t\"llg-midpoint\"" << std::endl;
                 std::cerr << "\t\"monte-carlo\"" << std::endl;
                 std::cerr << "\t\"constrained-monte-carlo\"" << std::endl;
+                std::cerr << "\t\"hybrid-constrained-monte-carlo\"" << std::endl;
+                std::cerr << "\t\"coloured-monte-carlo\"" << std::endl;
             terminaltextcolor(WHITE);
                 err::vexit();
             }
@@ -450,6 +457,11 @@ namespace vin{
                 sim::program=51;
                 return EXIT_SUCCESS;
             }
+            test="diagnostic-gaussian-benchmark";
+            if(value==test){
+                sim::program=52;
+                return EXIT_SUCCESS;
+            }
             else{
             terminaltextcolor(RED);
                 std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
@@ -803,6 +815,56 @@ namespace vin{
             }
         }
         //--------------------------------------------------------------------
+        test="mpi-decomposition";
+        if(word==test){
+            test="geometric";
+            if(value==test){
+                vmpi::weighted_decomposition=false;
+                return EXIT_SUCCESS;
+            }
+            test="atom-weighted";
+            if(value==test){
+                vmpi::weighted_decomposition=true;
+                return EXIT_SUCCESS;
+            }
+            else{
+            terminaltextcolor(RED);
+                std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
+                std::cerr << "\t\"geometric\"" << std::endl;
+                std::cerr << "\t\"atom-weighted\"" << std::endl;
+            terminaltextcolor(WHITE);
+                err::vexit();
+            }
+        }
+        //--------------------------------------------------------------------
+        test="mpi-halo-precision";
+        if(word==test){
+            test="double";
+            if(value==test){
+                vmpi::single_precision_halo=false;
+                return EXIT_SUCCESS;
+            }
+            test="single";
+            if(value==test){
+                vmpi::single_precision_halo=true;
+                return EXIT_SUCCESS;
+            }
+            else{
+            terminaltextcolor(RED);
+                std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
+                std::cerr << "\t\"double\"" << std::endl;
+                std::cerr << "\t\"single\"" << std::endl;
+            terminaltextcolor(WHITE);
+                err::vexit();
+            }
+        }
+        //--------------------------------------------------------------------
+        test="mpi-shared-memory-halo";
+        if(word==test){
+            vmpi::shared_memory_halo=check_for_valid_bool(value, word, line, prefix,"input");
+            return EXIT_SUCCESS;
+        }
+        //--------------------------------------------------------------------
         test="mpi-ppn";
         if(word==test){
             int ppn=atoi(value.c_str());
@@ -945,18 +1007,38 @@ namespace vin{
             }
         }
         //-------------------------------------------------------------------
+        test="checkpoint-mode";
+        if(word==test){
+            test="file-per-process";
+            if(value==test){
+                sim::checkpoint_shared_file=false; // separate checkpoint file for each process
+                return EXIT_SUCCESS;
+            }
+            test="shared";
+            if(value==test){
+                sim::checkpoint_shared_file=true; // single checkpoint file for all processes
+                return EXIT_SUCCESS;
+            }
+            else{
+                terminaltextcolor(RED);
+                std::cerr << "Error - value for \'sim:" << word << "\' must be one of:" << std::endl;
+                std::cerr << "\t\"file-per-process\"" << std::endl;
+                std::cerr << "\t\"shared\"" << std::endl;
+                terminaltextcolor(WHITE);
+                err::vexit();
+            }
+        }
+        //-------------------------------------------------------------------
+        test="asynchronous-checkpoint";
+        if(word==test){
+            sim::asynchronous_checkpoint = check_for_valid_bool(value, word, line, prefix,"input");
+            return EXIT_SUCCESS;
+        }
+        //-------------------------------------------------------------------
         test="load-checkpoint-if-exists";
         if(word==test){
-          // determine checkpoint file name
-          std::stringstream chkfilenamess;
-          chkfilenamess << "vampire" << vmpi::my_rank << ".chk";
-          std::string chkfilename = chkfilenamess.str();
-
-          // open checkpoint file
-          std::ofstream chkfile(chkfilename.c_str(),std::ios::in);
-          bool exists=chkfile.good();
-          chkfile.close();
-          if(exists){
+          // check for checkpoint file (for either checkpoint mode)
+          if(checkpoint_exists()){
             test="restart";
             if(value==test){
                 sim::load_checkpoint_flag=true; // Load spin configurations
@@ -1528,6 +1610,9 @@ namespace vin{
         // Open file read only
         std::stringstream inputfile;
         inputfile.str( vin::get_string(matfile.c_str(), "material", line_number) );
+
+        // add material file to structure cache hash
+        create::add_structure_input("material", matfile, inputfile.str(), "");
         //-------------------------------------------------------
         // Material 0
         //-------------------------------------------------------
@@ -17,6 +17,7 @@
 #include <string>
 #include <iostream>
 // Vampire headers
+#include "create.hpp"
 #include "vio.hpp"
 #include "errors.hpp"
 
@@ -141,6 +142,8 @@ namespace vin{
 			//std::cout << "\t" << "word: " << word << std::endl;
 			//std::cout << "\t" << "value:" << value << std::endl;
 			//std::cout << "\t" << "unit: " << unit << std::endl;
+			// add structure defining parameters to structure cache hash
+			create::add_structure_input(key, word, value, unit);
 			int matchcheck = match(key, word, value, unit, line_counter);
 			if(matchcheck==EXIT_FAILURE){
 				err::vexit();
@@ -17,6 +17,8 @@ function help_message {
     echo "              Valid numbers are 1 - Tests applied field and integrator."
     echo "                                2 - Tests anisotropy and thermal field."
     echo "                                3 - Tests exchange."
+    echo "                                4 - Tests SIMD exchange kernels against scalar kernel."
+    echo "                                5 - Tests fft dipole solver against tensor solver."
 }
 
 function cleanup {
@@ -81,6 +83,87 @@ function mag_vs_t {
     is_within_tolerance $max_error 0.01
 }
 
+function simd_exchange {
+    echo -n "Testing SIMD exchange kernel............."
+
+    dir=tests/physical/ExchangeSIMD
+
+    cp $dir/Co.mat Co.mat
+
+    # SIMD kernels are only tested on processors which support them
+    kernels=""
+    if grep -q avx2 /proc/cpuinfo; then
+        kernels="avx2"
+    fi
+    if grep -q avx512f /proc/cpuinfo; then
+        kernels="$kernels avx512"
+    fi
+    if [ -z "$kernels" ]; then
+        echo "skipped (processor does not support AVX2)"
+        return
+    fi
+
+    # run identical simulations with scalar and SIMD exchange kernels
+    result=""
+    for kernel in scalar $kernels; do
+        cp $dir/input input
+        echo "exchange:simd=$kernel" >> input
+        ./vampire &>/dev/null
+        grep -v "^#" output > simd_exchange_$kernel.dat
+
+        if [ $kernel == "scalar" ]; then
+            continue
+        fi
+
+        # kernels must be selected, pass verification and give bit identical trajectories
+        if grep -q "does not reproduce scalar exchange fields" log; then
+            result="$result $kernel:verification"
+        elif ! grep -q "Using AVX.* kernel" log; then
+            result="$result $kernel:unavailable"
+        elif ! cmp -s simd_exchange_scalar.dat simd_exchange_$kernel.dat; then
+            result="$result $kernel:output"
+        fi
+    done
+
+    rm -f simd_exchange_*.dat
+
+    if [ -z "$result" ]; then
+        echo -e "${green}passed${nc} (identical output for $kernels)"
+    else
+        echo -e "${red}failed${nc} (kernel:failure$result)"
+    fi
+}
+
+function dipole_fft {
+    echo -n "Testing fft dipole solver................"
+
+    dir=tests/physical/DipoleFFT
+
+    cp $dir/Co.mat Co.mat
+
+    # run identical simulations with tensor and fft dipole solvers
+    for solver in tensor fft; do
+        cp $dir/input input
+        echo "dipole:solver=$solver" >> input
+        ./vampire &>/dev/null
+        grep -v "^#" output > dipole_$solver.dat
+    done
+
+    # both solvers must produce the same number of output lines
+    if [ ! -s dipole_tensor.dat ] || [ $(wc -l < dipole_tensor.dat) -ne $(wc -l < dipole_fft.dat) ]; then
+        rm -f dipole_tensor.dat dipole_fft.dat
+        echo -e "${red}failed${nc} (missing output)"
+        return
+    fi
+
+    # maximum difference in magnetisation between solvers
+    max_error=$(paste dipole_tensor.dat dipole_fft.dat | awk '{ n=NF/2; for(i=2;i<=n;i++){ d=$i-$(i+n); if(d<0) d=-d; if(d>m) m=d } } END { printf "%e", m }')
+
+    rm -f dipole_tensor.dat dipole_fft.dat
+
+    is_within_tolerance $max_error 1e-4
+}
+
 function perform_test {
 
     case $1 in
@@ -93,6 +176,12 @@ function perform_test {
         3)
             mag_vs_t
             ;;
+        4)
+            simd_exchange
+            ;;
+        5)
+            dipole_fft
+            ;;
         *)
             echo -e "${red}Error: unknown test number $1. See --help for details."
             ;;
@@ -84,6 +84,11 @@ void read_nm_metadata(){
      vdc::format = vdc::binary;
      if(vdc::verbose) std::cout << "   Setting data format to binary mode" << std::endl;
    }
+   test = "compressed";
+   if(data_format_str == test){
+     vdc::format = vdc::compressed;
+     if(vdc::verbose) std::cout << "   Setting data format to compressed mode" << std::endl;
+   }
    /*else{
       std::cerr << "Unknown data format \"" << data_format_str << "\". Exiting" << std::endl;
       exit(1);
@@ -147,7 +152,9 @@ void read_nm_data(){
 
       switch (vdc::format){
 
-         case vdc::binary:{
+         // coordinates are stored in binary format for compressed output
+         case vdc::binary:
+         case vdc::compressed:{
             uint64_t num_atoms_in_file = 0;
             // open file in binary mode
             std::ifstream ifile;
@@ -12,6 +12,9 @@
 
 // C++ standard library headers
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -27,6 +30,7 @@ namespace vdc{
 // forward function declarations
 bool read_spin_metadata(unsigned int file_id);
 void read_spin_data(unsigned int file_id);
+uint64_t read_compressed_spin_file(const std::string filename, uint64_t atom_id);
 
 //------------------------------------------------------------------------------
 // Wrapper function to read coordinate metafile to initialise data structures
@@ -231,6 +235,11 @@ void read_spin_data(unsigned int file_id){
             break;
          }
 
+         case vdc::compressed:{
+            atom_id += read_compressed_spin_file(spin_filenames[f], atom_id);
+            break;
+         }
+
       }
 
    }
@@ -242,4 +251,128 @@ void read_spin_data(unsigned int file_id){
 
 }
 
+//------------------------------------------------------------------------------
+// Function to read compressed spin data file (see src/config/compress.cpp),
+// decoding one block at a time into the spin array from atom_id. Returns the
+// number of atoms read.
+//------------------------------------------------------------------------------
+uint64_t read_compressed_spin_file(const std::string filename, uint64_t atom_id){
+
+   // open file in binary mode
+   std::ifstream ifile;
+   ifile.open(filename.c_str(), std::ios::binary);
+   // check for open file
+   if(!ifile.is_open()){
+      std::cerr << std::endl << "   Error! Spin data file \"" << filename << "\" cannot be opened. Exiting" << std::endl;
+      exit(1);
+   }
+
+   // read and check header
+   char magic[8];
+   uint32_t encoding = 0;
+   uint32_t codec = 0;
+   uint64_t num_atoms_in_file = 0;
+   uint64_t num_blocks = 0;
+   ifile.read(magic, 8);
+   ifile.read((char*)&encoding, sizeof(uint32_t));
+   ifile.read((char*)&codec, sizeof(uint32_t));
+   ifile.read((char*)&num_atoms_in_file, sizeof(uint64_t));
+   ifile.read((char*)&num_blocks, sizeof(uint64_t));
+   if(!ifile || std::strncmp(magic, "VCSPINS1", 8) != 0 || encoding != 1 || codec != 1){
+      std::cerr << std::endl << "   Error! Spin data file \"" << filename << "\" is not a supported compressed data file. Exiting" << std::endl;
+      exit(1);
+   }
+   if(atom_id + num_atoms_in_file > vdc::num_atoms){
+      std::cerr << std::endl << "   Error! Spin data file \"" << filename << "\" contains more atoms than the coordinate data. Exiting" << std::endl;
+      exit(1);
+   }
+
+   std::vector<unsigned char> data;
+   uint64_t atoms_read = 0;
+
+   // loop over blocks
+   for(uint64_t block = 0; block < num_blocks; block++){
+
+      uint64_t num_atoms_in_block = 0;
+      uint64_t num_bytes = 0;
+      ifile.read((char*)&num_atoms_in_block, sizeof(uint64_t));
+      ifile.read((char*)&num_bytes, sizeof(uint64_t));
+      data.resize(num_bytes);
+      if(num_bytes > 0) ifile.read((char*)&data[0], num_bytes);
+      if(!ifile || atoms_read + num_atoms_in_block > num_atoms_in_file){
+         std::cerr << std::endl << "   Error! Spin data file \"" << filename << "\" is truncated or corrupt. Exiting" << std::endl;
+         exit(1);
+      }
+
+      uint16_t last[2] = {32768, 32768}; // previous code
+      uint64_t zero_run = 0; // remaining zero differences
+      uint64_t pos = 0; // position in data
+
+      for(uint64_t atom = 0; atom < num_atoms_in_block; atom++){
+
+         uint16_t code[2];
+
+         for(int c = 0; c < 2; c++){
+
+            uint64_t zz = 0;
+
+            if(zero_run > 0) zero_run--;
+            else{
+               // read variable length integer
+               int shift = 0;
+               while(pos < num_bytes){
+                  const unsigned char byte = data[pos++];
+                  zz |= uint64_t(byte & 0x7F) << shift;
+                  shift += 7;
+                  if((byte & 0x80) == 0) break;
+               }
+               // zero byte starts run of zeros with run length - 1 following
+               if(zz == 0){
+                  shift = 0;
+                  while(pos < num_bytes){
+                     const unsigned char byte = data[pos++];
+                     zero_run |= uint64_t(byte & 0x7F) << shift;
+                     shift += 7;
+                     if((byte & 0x80) == 0) break;
+                  }
+               }
+            }
+
+            // undo zigzag mapping and difference to previous atom
+            const uint16_t diff = uint16_t((zz >> 1) ^ (~(zz & 1) + 1));
+            code[c] = uint16_t(last[c] + diff);
+            last[c] = code[c];
+
+         }
+
+         // unfold octahedral encoding
+         double px = double(code[0]) / 65535.0 * 2.0 - 1.0;
+         double py = double(code[1]) / 65535.0 * 2.0 - 1.0;
+         const double pz = 1.0 - std::fabs(px) - std::fabs(py);
+         if(pz < 0.0){
+            const double fx = (1.0 - std::fabs(py)) * (px >= 0.0 ? 1.0 : -1.0);
+            const double fy = (1.0 - std::fabs(px)) * (py >= 0.0 ? 1.0 : -1.0);
+            px = fx;
+            py = fy;
+         }
+
+         const double inorm = 1.0 / std::sqrt(px*px + py*py + pz*pz);
+
+         const uint64_t id = atom_id + atoms_read + atom;
+         vdc::spins[3*id + 0] = px * inorm;
+         vdc::spins[3*id + 1] = py * inorm;
+         vdc::spins[3*id + 2] = pz * inorm;
+
+      }
+
+      atoms_read += num_atoms_in_block;
+
+   }
+
+   ifile.close();
+
+   return atoms_read;
+
+}
+
 }
@@ -37,7 +37,7 @@ namespace vdc{
    extern std::string slice_type;
 
    // enumerated integers for option selection
-   enum format_t{ binary = 0, text = 1};
+   enum format_t{ binary = 0, text = 1, compressed = 2};
    extern format_t format;
 
    // simple struct to store material parameters